@@ -9,6 +9,7 @@
 
 #!/usr/bin/env python3
 import argparse
+import os
 import subprocess
 import sys
 import time
@@ -32,12 +33,32 @@ ARRAY_SIZES = [
     "Array4m",
 ]
 
+# Messages that are not self-contained, thus serialized when published
+SERIALIZED_SIZES = [
+    "PointCloud512k",
+    "PointCloud1m",
+    "PointCloud2m",
+    "PointCloud4m",
+    "PointCloud8m",
+]
+
 def format_time(seconds: float) -> str:
     """Format seconds into a human-readable string."""
     return str(timedelta(seconds=int(seconds)))
 
-def run_performance_tests(rmw_name: str, install_dir: Path, use_zero_copy: bool, runtime: int):
-    """Run performance tests for all array sizes sequentially."""
+def write_topic_config(path: Path, suppress_idle_notifications: bool):
+    """Write the topic configuration applied to all topics of the benchmark."""
+    path.write_text(
+        "[defaults]\n"
+        f"suppress_idle_notifications = {'true' if suppress_idle_notifications else 'false'}\n"
+    )
+
+DEFAULT_COMMUNICATOR = "rclcpp-single-threaded-executor"
+
+def run_performance_tests(rmw_name: str, install_dir: Path, use_zero_copy: bool, runtime: int, spin_budget_us: int,
+                          message_sizes: list, two_pass_serialization: bool, suppress_idle_notifications: bool,
+                          communicator: str):
+    """Run performance tests for all message sizes sequentially."""
     perf_test_path = install_dir / "performance_test/lib/performance_test/perf_test"
     
     # Locate performance_test binary
@@ -47,7 +68,7 @@ def run_performance_tests(rmw_name: str, install_dir: Path, use_zero_copy: bool,
     # Prepare command
     base_cmd = [
         str(perf_test_path),
-        "-c", "rclcpp-single-threaded-executor",
+        "-c", communicator,
         "--max-runtime", str(runtime),              
         "--ignore", "5",                            # warmup time
         "--rate", "0"                               # as fast as possible
@@ -55,22 +76,41 @@ def run_performance_tests(rmw_name: str, install_dir: Path, use_zero_copy: bool,
     if use_zero_copy:
         base_cmd.append("--zero-copy")
 
+    # Configure the waitset wait mode: blocking if zero, otherwise spin for the budget before blocking
+    env = os.environ.copy()
+    env["RMW_IOX2_WAITSET_SPIN_BUDGET_US"] = str(spin_budget_us)
+
+    # Configure whether serialized messages are sized before being serialized, for comparison with a single pass
+    env["RMW_IOX2_SPECULATIVE_SERIALIZATION"] = "0" if two_pass_serialization else "1"
+
     # Create output directory if it doesn't exist
     Path("results").mkdir(exist_ok=True)
 
+    # Configure whether publishers skip notifications while no executor is blocked waiting
+    topic_config = Path("results/topic_config.toml").resolve()
+    write_topic_config(topic_config, suppress_idle_notifications)
+    env["RMW_IOX2_TOPIC_CONFIG"] = str(topic_config)
+
     # Track test runs
     total_start_time = time.time()
-    total_tests = len(ARRAY_SIZES)
+    total_tests = len(message_sizes)
     tests_completed = 0
 
     # Run tests for each array size
-    for array_size in ARRAY_SIZES:
+    for array_size in message_sizes:
         size_suffix = array_size.lower()
         test_start_time = time.time()
         
         # Construct output filename
         prefix = "zero-copy" if use_zero_copy else "regular"
-        output_file = f"results/{rmw_name}-performance-{prefix}-{size_suffix}.json"
+        mode = f"spin{spin_budget_us}us" if spin_budget_us > 0 else "blocking"
+        if two_pass_serialization:
+            mode += "-two-pass"
+        if suppress_idle_notifications:
+            mode += "-suppress-idle"
+        if communicator != DEFAULT_COMMUNICATOR:
+            mode += f"-{communicator}"
+        output_file = f"results/{rmw_name}-{mode}-performance-{prefix}-{size_suffix}.json"
         
         # Build complete command with provided arguments
         cmd = base_cmd + ["--msg", array_size, "--logfile", output_file]
@@ -89,7 +129,8 @@ def run_performance_tests(rmw_name: str, install_dir: Path, use_zero_copy: bool,
                 stderr=subprocess.PIPE,
                 text=True,
                 bufsize=1,
-                universal_newlines=True
+                universal_newlines=True,
+                env=env
             )
             while True:
                 output = process.stdout.readline()
@@ -140,22 +181,48 @@ def main():
     parser.add_argument('install_dir', type=Path, help='Path to the ROS 2 installation directory')
     parser.add_argument('--zero-copy', action='store_true', help='Enable zero-copy transfer')
     parser.add_argument('--runtime', type=int, default=35, help='Test runtime in seconds (default: 35)')
+    parser.add_argument('--spin-budget-us', type=int, default=0,
+                        help='Time in microseconds for which waitsets poll before blocking (default: 0, i.e. blocking)')
+    parser.add_argument('--serialized', action='store_true',
+                        help='Use messages that are not self-contained, thus serialized when published')
+    parser.add_argument('--two-pass-serialization', action='store_true',
+                        help='Determine the size of messages before serializing them instead of a single pass')
+    parser.add_argument('--suppress-idle-notifications', action='store_true',
+                        help='Skip notifying subscribers while no executor is blocked waiting for messages')
+    parser.add_argument('--communicator', default=DEFAULT_COMMUNICATOR,
+                        help='Executor or communicator of performance_test receiving the messages, e.g. an events '
+                             f'executor for comparison against the default (default: {DEFAULT_COMMUNICATOR})')
+    parser.add_argument('--msg', action='append', metavar='MESSAGE',
+                        help='Only run the given message type, may be repeated (default: all message types)')
     args = parser.parse_args()
+    message_sizes = SERIALIZED_SIZES if args.serialized else ARRAY_SIZES
+    if args.msg:
+        unknown = [msg for msg in args.msg if msg not in ARRAY_SIZES + SERIALIZED_SIZES]
+        if unknown:
+            parser.error(f"unknown message types: {', '.join(unknown)}")
+        message_sizes = args.msg
     
     # Estimate total expected duration
-    total_runtime = (args.runtime + 5) * len(ARRAY_SIZES)  # runtime + ignore time per test
+    total_runtime = (args.runtime + 5) * len(message_sizes)  # runtime + ignore time per test
     
     # Provide test overview
     print(f"Starting performance tests for RMW: {args.rmw_name}")
     print(f"Using installation directory: {args.install_dir}")
     print(f"Zero-copy enabled: {args.zero_copy}")
+    print(f"Waitset spin budget: {args.spin_budget_us} microseconds")
+    print(f"Serialized messages: {args.serialized} (two-pass serialization: {args.two_pass_serialization})")
+    print(f"Suppress idle notifications: {args.suppress_idle_notifications}")
+    print(f"Communicator: {args.communicator}")
+    print(f"Message types: {', '.join(message_sizes)}")
     print(f"Runtime per test: {args.runtime} seconds (plus 5 seconds ignore time)")
-    print(f"Total number of tests to run: {len(ARRAY_SIZES)}")
+    print(f"Total number of tests to run: {len(message_sizes)}")
     print(f"Estimated total duration: {format_time(total_runtime)}")
     print(f"Started at: {datetime.now().strftime('%H:%M:%S')}")
     
     try:
-        run_performance_tests(args.rmw_name, args.install_dir, args.zero_copy, args.runtime)
+        run_performance_tests(args.rmw_name, args.install_dir, args.zero_copy, args.runtime, args.spin_budget_us,
+                              message_sizes, args.two_pass_serialization, args.suppress_idle_notifications,
+                              args.communicator)
     except FileNotFoundError as e:
         print(f"\nError: {e}", file=sys.stderr)
         print("Ensure that the installation path is correct.", file=sys.stderr)
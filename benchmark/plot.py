@@ -20,7 +20,7 @@ from bokeh.palettes import Category10
 
 def extract_msg_size(data):
     """Extract message size from msg_name field."""
-    pattern = r'Array(\d+(?:[km])?)'
+    pattern = r'(?:Array|PointCloud)(\d+(?:[km])?)'
     match = re.search(pattern, data.get('msg_name', ''))
     if match:
         size_str = match.group(1)
@@ -41,8 +41,11 @@ def parse_performance_file(filepath):
         results_df = pd.DataFrame(data['analysis_results'])
         avg_latency = results_df['latency_mean'].mean()
         
+        # Label results by the prefix of the file name, distinguishing runs of the same RMW in different modes
+        label = os.path.basename(filepath).split('-performance-')[0]
+
         return {
-            'rmw_implementation': data.get('rmw_implementation', ''),
+            'rmw_implementation': label or data.get('rmw_implementation', ''),
             'avg_latency': avg_latency,
             'msg_size': extract_msg_size(data)
         }
@@ -0,0 +1,65 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+
+#ifndef RMW_IOX2_COMMON_ENVIRONMENT_HPP_
+#define RMW_IOX2_COMMON_ENVIRONMENT_HPP_
+
+#include "iox/optional.hpp"
+#include "rcutils/env.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+namespace rmw::iox2::env
+{
+
+/// Time in microseconds for which waitsets poll for data before blocking. Disabled if unset or zero.
+constexpr const char* WAITSET_SPIN_BUDGET_US{"RMW_IOX2_WAITSET_SPIN_BUDGET_US"};
+
+/// Whether waitsets defer triggered subscriptions in favor of those with higher priority. Disabled if unset or zero.
+constexpr const char* WAITSET_PRIORITIZATION{"RMW_IOX2_WAITSET_PRIORITIZATION"};
+
+/// Path of a file configuring the settings of individual topics. Built-in defaults are used for all topics if unset.
+constexpr const char* TOPIC_CONFIG{"RMW_IOX2_TOPIC_CONFIG"};
+
+/// Whether messages that are not self-contained are serialized speculatively in a single pass. Enabled unless zero.
+constexpr const char* SPECULATIVE_SERIALIZATION{"RMW_IOX2_SPECULATIVE_SERIALIZATION"};
+
+/// @brief Get the value of an environment variable
+/// @param[in] name The name of the environment variable
+/// @return The value if the variable is set and not empty, otherwise nullopt
+inline auto get(const char* name) -> iox::optional<std::string> {
+    const char* value{nullptr};
+    if (rcutils_get_env(name, &value) != nullptr || value == nullptr || value[0] == '\0') {
+        return iox::nullopt;
+    }
+    return std::string{value};
+}
+
+/// @brief Get the value of an environment variable as an unsigned integer
+/// @param[in] name The name of the environment variable
+/// @return The value if the variable is set to a valid unsigned integer, otherwise nullopt
+inline auto get_uint(const char* name) -> iox::optional<uint64_t> {
+    auto value = get(name);
+    if (!value.has_value()) {
+        return iox::nullopt;
+    }
+    char* end{nullptr};
+    auto number = std::strtoull(value->c_str(), &end, 10);
+    if (end == value->c_str() || *end != '\0' || value->front() == '-') {
+        return iox::nullopt;
+    }
+    return static_cast<uint64_t>(number);
+}
+
+} // namespace rmw::iox2::env
+
+#endif
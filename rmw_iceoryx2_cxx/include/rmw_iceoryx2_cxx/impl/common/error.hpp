@@ -20,6 +20,7 @@ enum class HandleError : uint8_t { INVALID_INSTANCE_NAME, ICEORYX_HANDLE_CREATIO
 enum class ContextError : uint8_t {
     INVARIANT_VIOLATION,
     HANDLE_CREATION_FAILURE,
+    EVENT_DISPATCHER_CREATION_FAILURE,
 };
 enum class NodeError : uint8_t { INVARIANT_VIOLATION, HANDLE_CREATION_FAILURE, GRAPH_GUARD_CONDITION_CREATION_FAILURE };
 enum class GuardConditionError : uint8_t {
@@ -29,7 +30,20 @@ enum class GuardConditionError : uint8_t {
     NOTIFIER_CREATION_FAILURE,
     NOTIFICATION_FAILURE
 };
-enum class SampleRegistryError : uint8_t { INVALID_PAYLOAD };
+enum class TopicConfigError : uint8_t {
+    FILE_ACCESS_FAILURE,
+    INVALID_SYNTAX,
+    UNKNOWN_TABLE,
+    UNKNOWN_KEY,
+    INVALID_VALUE,
+};
+enum class SerializationError : uint8_t {
+    TYPESUPPORT_UNAVAILABLE,
+    INSUFFICIENT_CAPACITY,
+    SERIALIZATION_FAILURE,
+    DESERIALIZATION_FAILURE,
+};
+enum class SampleRegistryError : uint8_t { INVALID_PAYLOAD, CAPACITY_EXCEEDED };
 enum class PublisherError : uint8_t {
     INVARIANT_VIOLATION,
     SERVICE_NAME_CREATION_FAILURE,
@@ -40,6 +54,7 @@ enum class PublisherError : uint8_t {
     SEND_FAILURE,
     NOTIFICATION_FAILURE,
     INVALID_PAYLOAD,
+    WAITER_COUNT_CREATION_FAILURE,
 };
 enum class SubscriberError : uint8_t {
     INVARIANT_VIOLATION,
@@ -48,6 +63,24 @@ enum class SubscriberError : uint8_t {
     SUBSCRIBER_CREATION_FAILURE,
     RECV_FAILURE,
     INVALID_PAYLOAD,
+    WAITER_COUNT_CREATION_FAILURE,
+    EVENT_CALLBACK_FAILURE,
+};
+enum class ListenerRegistryError : uint8_t {
+    INVARIANT_VIOLATION,
+    SERVICE_CREATION_FAILURE,
+    LISTENER_CREATION_FAILURE,
+    NOTIFIER_CREATION_FAILURE,
+    NOTIFICATION_FAILURE,
+    LISTENER_FAILURE,
+    WAITSET_CREATION_FAILURE,
+    ATTACHMENT_FAILURE
+};
+enum class WaiterCountError : uint8_t { SHARED_MEMORY_FAILURE };
+enum class EventDispatcherError : uint8_t {
+    WAITSET_CREATION_FAILURE,
+    LISTENER_CREATION_FAILURE,
+    ATTACHMENT_FAILURE,
 };
 enum class WaitSetError : uint8_t {
     INVARIANT_VIOLATION,
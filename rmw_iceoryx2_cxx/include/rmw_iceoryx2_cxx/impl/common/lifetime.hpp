@@ -0,0 +1,77 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+
+#ifndef RMW_IOX2_COMMON_LIFETIME_HPP_
+#define RMW_IOX2_COMMON_LIFETIME_HPP_
+
+#include <memory>
+
+namespace rmw::iox2
+{
+
+class LifetimeObserver;
+
+/// @brief Marks the lifetime of the object owning it.
+/// @details Allows other components holding on to resources on behalf of an object (e.g. the listeners of a waitset)
+///          to detect its destruction without the object having to know about them.
+class Lifetime
+{
+public:
+    Lifetime()
+        : m_token{std::make_shared<char>()} {
+    }
+
+    Lifetime(const Lifetime&) = delete;
+    Lifetime(Lifetime&&) = default;
+    Lifetime& operator=(const Lifetime&) = delete;
+    Lifetime& operator=(Lifetime&&) = default;
+    ~Lifetime() = default;
+
+    /// @brief Create an observer of this lifetime
+    auto observe() const -> LifetimeObserver;
+
+private:
+    friend class LifetimeObserver;
+    std::shared_ptr<char> m_token;
+};
+
+/// @brief Observes a lifetime without extending it.
+class LifetimeObserver
+{
+public:
+    /// @brief Determine if the observed lifetime has ended
+    /// @return True if the owner of the observed lifetime was destroyed
+    auto expired() const -> bool {
+        return m_token.expired();
+    }
+
+    /// @brief Determine if this observes the given lifetime
+    /// @param[in] lifetime The lifetime to compare against
+    /// @return True if the given lifetime is the one observed
+    auto observes(const Lifetime& lifetime) const -> bool {
+        return !m_token.owner_before(lifetime.m_token) && !lifetime.m_token.owner_before(m_token);
+    }
+
+private:
+    friend class Lifetime;
+    explicit LifetimeObserver(const std::shared_ptr<char>& token)
+        : m_token{token} {
+    }
+
+    std::weak_ptr<char> m_token;
+};
+
+inline auto Lifetime::observe() const -> LifetimeObserver {
+    return LifetimeObserver{m_token};
+}
+
+} // namespace rmw::iox2
+
+#endif
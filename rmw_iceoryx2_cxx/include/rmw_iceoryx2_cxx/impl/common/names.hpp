@@ -27,6 +27,9 @@ std::string node(const uint32_t context_id, const char* name, const char* ns);
 RMW_PUBLIC
 std::string guard_condition(const uint32_t context_id, const uint32_t guard_condition_id);
 
+RMW_PUBLIC
+std::string waitset(const uint32_t context_id, const uint32_t waitset_id);
+
 RMW_PUBLIC
 std::string topic(const char* topic);
 
@@ -0,0 +1,91 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#ifndef RMW_IOX2_COMMON_QOS_HPP_
+#define RMW_IOX2_COMMON_QOS_HPP_
+
+#include "rmw/qos_profiles.h"
+#include "rmw/types.h"
+#include "rmw_iceoryx2_cxx/impl/common/log.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+namespace rmw::iox2::qos
+{
+
+/// @brief Check if the requested QoS asks for reliable delivery
+/// @details Only an explicit request for best effort delivery is considered unreliable
+/// @param[in] requested The requested QoS
+/// @return True if reliable delivery is requested
+inline auto requests_reliable(const rmw_qos_profile_t& requested) -> bool {
+    return requested.reliability != RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT;
+}
+
+/// @brief Check if the requested QoS asks to keep all samples
+/// @param[in] requested The requested QoS
+/// @return True if the history is KEEP_ALL
+inline auto requests_keep_all(const rmw_qos_profile_t& requested) -> bool {
+    return requested.history == RMW_QOS_POLICY_HISTORY_KEEP_ALL;
+}
+
+/// @brief Get the KEEP_LAST depth of the requested QoS
+/// @param[in] requested The requested QoS
+/// @return The requested depth, the default depth if left to the system
+inline auto requested_depth(const rmw_qos_profile_t& requested) -> size_t {
+    if (requested.history == RMW_QOS_POLICY_HISTORY_SYSTEM_DEFAULT
+        || requested.depth == RMW_QOS_POLICY_DEPTH_SYSTEM_DEFAULT) {
+        return rmw_qos_profile_default.depth;
+    }
+    return requested.depth;
+}
+
+/// @brief Log that RELIABLE delivery was requested on a topic that overwrites samples of full queues
+/// @details As the default QoS requests RELIABLE delivery, a warning is only logged for the first entity in the
+///          process to not flood the log, later ones are logged at debug level.
+/// @param[in] topic The name of the topic
+/// @param[in] entity The kind of entity, e.g. "publisher"
+inline auto log_reliability_downgrade(const char* topic, const char* entity) -> void {
+    static std::atomic<bool> warned{false};
+    if (!warned.exchange(true)) {
+        RMW_IOX2_LOG_WARN("RELIABLE %s on %s is BEST_EFFORT, as the topic overwrites the oldest samples of full "
+                          "queues. Disable safe_overflow for the topic to block publishers instead. Further "
+                          "occurrences are logged at debug level.",
+                          entity,
+                          topic);
+    } else {
+        RMW_IOX2_LOG_DEBUG("RELIABLE %s on %s is BEST_EFFORT, as the topic overwrites the oldest samples of full "
+                           "queues",
+                           entity,
+                           topic);
+    }
+}
+
+/// @brief Determine the QoS effectively provided to an entity
+/// @details Policies not realized by the implementation are reported with their default values.
+/// @param[in] requested The requested QoS
+/// @param[in] depth The number of samples effectively queued
+/// @param[in] reliable Whether samples are never discarded when queues are full
+/// @param[in] transient_local Whether samples are delivered to late-joining subscribers
+/// @return The effective QoS
+inline auto effective(const rmw_qos_profile_t& requested, size_t depth, bool reliable, bool transient_local)
+    -> rmw_qos_profile_t {
+    auto actual = rmw_qos_profile_default;
+    actual.history = requests_keep_all(requested) ? RMW_QOS_POLICY_HISTORY_KEEP_ALL : RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+    actual.depth = depth;
+    actual.reliability = reliable ? RMW_QOS_POLICY_RELIABILITY_RELIABLE : RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT;
+    actual.durability =
+        transient_local ? RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL : RMW_QOS_POLICY_DURABILITY_VOLATILE;
+    actual.avoid_ros_namespace_conventions = requested.avoid_ros_namespace_conventions;
+    return actual;
+}
+
+} // namespace rmw::iox2::qos
+
+#endif
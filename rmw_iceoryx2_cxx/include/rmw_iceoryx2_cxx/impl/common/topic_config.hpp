@@ -0,0 +1,129 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#ifndef RMW_IOX2_COMMON_TOPIC_CONFIG_HPP_
+#define RMW_IOX2_COMMON_TOPIC_CONFIG_HPP_
+
+#include "iox/expected.hpp"
+#include "rmw/visibility_control.h"
+#include "rmw_iceoryx2_cxx/impl/common/error.hpp"
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <unordered_map>
+
+namespace rmw::iox2
+{
+
+class TopicConfig;
+
+template <>
+struct Error<TopicConfig>
+{
+    using Type = TopicConfigError;
+};
+
+/// @brief Settings applied to the iceoryx2 service and ports of a topic when they are created
+/// @details Processes communicating on a topic must use compatible settings, as the service is created with the
+///          settings of the first process and opened with those of the others.
+struct TopicSettings
+{
+    /// Upper bound of max_publishers and max_subscribers, as iceoryx2 sizes the service for the maximum up front
+    static constexpr uint64_t MAX_PORTS{1024};
+    /// Upper bound of the queue and history sizes, as iceoryx2 sizes the data segments for them up front
+    static constexpr uint64_t MAX_QUEUED_SAMPLES{65536};
+    /// Upper bound of max_loaned_samples, as the registry of loans of a publisher is sized for it up front
+    static constexpr uint64_t MAX_LOANED_SAMPLES{1024};
+
+    /// The maximum number of publishers on the topic
+    uint64_t max_publishers{64};
+    /// The maximum number of subscribers on the topic
+    uint64_t max_subscribers{64};
+    /// The number of samples delivered to subscribers joining late
+    uint64_t history_size{10};
+    /// The maximum number of samples queued per subscriber
+    uint64_t subscriber_max_buffer_size{10};
+    /// The maximum number of samples borrowed from a subscriber at once, bounding the loans taken by subscriptions.
+    /// Zero uses the buffer size of subscribers, so that a full buffer can be taken at once.
+    uint64_t subscriber_max_borrowed_samples{0};
+    /// The maximum number of samples loaned from a publisher at once
+    uint64_t max_loaned_samples{8};
+    /// Whether publishers overwrite the oldest queued sample of subscribers with full buffers. Must be disabled for
+    /// publishers with reliable QoS to block until subscribers have space instead.
+    bool safe_overflow{true};
+    /// Whether publishers defer notifying subscribers until the next wait in their context, so that all samples
+    /// published in one executor cycle cause a single wakeup. Only applies to threads waiting in the context, and
+    /// bounded by the buffer size of subscribers.
+    bool coalesce_notifications{false};
+    /// Whether publishers skip notifying subscribers when no waitset is blocked waiting for samples of the topic.
+    /// Only to be enabled if all subscribers are created by rmw_iceoryx2, as other listeners are never notified, and
+    /// in all processes on the topic, as subscribers only register as waiting if enabled.
+    bool suppress_idle_notifications{false};
+    /// Whether subscriptions only take the newest queued sample, releasing older ones without reading them. Only
+    /// affects the local subscriptions, and only subscriptions buffering more than one sample.
+    bool keep_latest{false};
+    /// The priority of subscriptions in wait results, see rmw_iox2_subscription_options_t
+    uint8_t priority{0};
+
+    /// @brief Get the maximum number of samples borrowed from a subscriber at once to create the service with
+    /// @return The configured number, or the buffer size of subscribers if not configured
+    auto borrowed_samples() const -> uint64_t {
+        return subscriber_max_borrowed_samples == 0 ? subscriber_max_buffer_size : subscriber_max_borrowed_samples;
+    }
+};
+
+/// @brief Per-topic settings, loaded from a configuration file
+/// @details The file uses a subset of TOML. Settings in the [defaults] table apply to all topics, settings in a
+///          [topics."<name>"] table override them for the topic with the given (fully qualified) name. Values are
+///          unsigned integers or booleans, comments start with '#':
+///
+/// @code{.toml}
+/// [defaults]
+/// subscriber_max_buffer_size = 4
+///
+/// [topics."/points"]
+/// max_loaned_samples = 2
+/// history_size = 0
+/// safe_overflow = false
+/// @endcode
+///
+/// Topics without a table of their own, and settings not set for a topic, use the defaults.
+class RMW_PUBLIC TopicConfig
+{
+public:
+    using ErrorType = Error<TopicConfig>::Type;
+
+public:
+    /// @brief Creates a configuration using the built-in defaults for all topics
+    TopicConfig() = default;
+
+    /// @brief Load the configuration from a file
+    /// @param[in] path The path of the file
+    /// @return The configuration, error if the file cannot be read or is invalid
+    static auto from_file(const std::string& path) -> iox::expected<TopicConfig, ErrorType>;
+
+    /// @brief Parse the configuration from a stream
+    /// @param[in] input The stream to parse
+    /// @return The configuration, error if the contents are invalid
+    static auto parse(std::istream& input) -> iox::expected<TopicConfig, ErrorType>;
+
+    /// @brief Get the settings for a topic
+    /// @param[in] topic The fully qualified name of the topic
+    /// @return The settings of the topic if configured, otherwise the defaults
+    auto settings(const std::string& topic) const -> const TopicSettings&;
+
+private:
+    TopicSettings m_defaults;
+    std::unordered_map<std::string, TopicSettings> m_topics;
+};
+
+} // namespace rmw::iox2
+
+#endif
@@ -13,6 +13,7 @@
 #include "rmw/dynamic_message_type_support.h"
 #include "rmw/visibility_control.h"
 #include "rosidl_typesupport_cpp/message_type_support.hpp"
+#include "rosidl_typesupport_fastrtps_cpp/message_type_support.h"
 #include "rosidl_typesupport_introspection_c/message_introspection.h"
 #include "rosidl_typesupport_introspection_cpp/field_types.hpp"
 #include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
@@ -35,6 +36,7 @@ bool is_pod(const rosidl_typesupport_introspection_cpp::MessageMembers* members)
 bool is_pod(const rosidl_message_type_support_t* type_support);
 RMW_PUBLIC size_t message_size(const rosidl_message_type_support_t* type_support);
 RMW_PUBLIC size_t serialized_message_size(const void* ros_message, const rosidl_message_type_support_t* type_support);
+RMW_PUBLIC size_t serialized_message_size(const void* ros_message, const message_type_support_callbacks_t* callbacks);
 
 } // namespace rmw::iox2
 
@@ -0,0 +1,41 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#ifndef RMW_IOX2_MESSAGE_HEADER_HPP_
+#define RMW_IOX2_MESSAGE_HEADER_HPP_
+
+#include "rmw/types.h"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace rmw::iox2
+{
+
+/// @brief User header sent alongside the payload of every message, carrying the publisher side of the message info
+/// @details Written by the publisher directly into the sample before sending it, read by subscribers in place. The
+///          header is part of the service type, thus all ports of a topic must use it.
+struct MessageHeader
+{
+    /// Time the message was sent at in nanoseconds since the epoch of the system clock
+    int64_t source_timestamp{0};
+    /// Number of the message in the messages sent by its publisher, starting at one
+    uint64_t sequence_number{0};
+    /// Gid of the publisher, as reported by rmw_get_gid_for_publisher()
+    uint8_t publisher_gid[RMW_GID_STORAGE_SIZE]{};
+    /// Number of bytes of the payload holding the message. Smaller than the payload for messages serialized into a
+    /// loan sized for the largest message published so far, the remaining bytes are not part of the message.
+    uint64_t payload_size{0};
+};
+
+static_assert(std::is_trivially_copyable_v<MessageHeader>, "the header is shared between processes");
+
+} // namespace rmw::iox2
+
+#endif
@@ -0,0 +1,71 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#ifndef RMW_IOX2_MESSAGE_SERIALIZATION_HPP_
+#define RMW_IOX2_MESSAGE_SERIALIZATION_HPP_
+
+#include "iox/expected.hpp"
+#include "rmw/visibility_control.h"
+#include "rmw_iceoryx2_cxx/impl/common/error.hpp"
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+#include "rosidl_typesupport_fastrtps_cpp/message_type_support.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rmw::iox2
+{
+
+/// @brief Serialize a message into a buffer in a single pass, without determining its serialized size beforehand
+/// @param[in] ros_message The message to serialize
+/// @param[in] type_support The typesupport of the message
+/// @param[in] buffer The buffer to serialize into
+/// @param[in] capacity The size of the buffer in bytes
+/// @return The number of bytes written, INSUFFICIENT_CAPACITY if the message does not fit the buffer
+RMW_PUBLIC auto serialize(const void* ros_message,
+                          const rosidl_message_type_support_t* type_support,
+                          uint8_t* buffer,
+                          size_t capacity) -> iox::expected<size_t, SerializationError>;
+
+/// @brief Serialize a message into a buffer in a single pass, using previously resolved callbacks
+/// @param[in] ros_message The message to serialize
+/// @param[in] callbacks The fastrtps callbacks of the message type
+/// @param[in] buffer The buffer to serialize into
+/// @param[in] capacity The size of the buffer in bytes
+/// @return The number of bytes written, INSUFFICIENT_CAPACITY if the message does not fit the buffer
+RMW_PUBLIC auto serialize(const void* ros_message,
+                          const message_type_support_callbacks_t* callbacks,
+                          uint8_t* buffer,
+                          size_t capacity) -> iox::expected<size_t, SerializationError>;
+
+/// @brief Deserialize a message from a buffer
+/// @param[in] buffer The buffer containing the serialized message, may be larger than the serialized message
+/// @param[in] size The size of the buffer in bytes
+/// @param[in] type_support The typesupport of the message
+/// @param[out] ros_message The message to deserialize into
+/// @return Error if the buffer does not contain a valid message of the type
+RMW_PUBLIC auto deserialize(const uint8_t* buffer,
+                            size_t size,
+                            const rosidl_message_type_support_t* type_support,
+                            void* ros_message) -> iox::expected<void, SerializationError>;
+
+/// @brief Deserialize a message from a buffer, using previously resolved callbacks
+/// @param[in] buffer The buffer containing the serialized message, may be larger than the serialized message
+/// @param[in] size The size of the buffer in bytes
+/// @param[in] callbacks The fastrtps callbacks of the message type
+/// @param[out] ros_message The message to deserialize into
+/// @return Error if the buffer does not contain a valid message of the type
+RMW_PUBLIC auto deserialize(const uint8_t* buffer,
+                            size_t size,
+                            const message_type_support_callbacks_t* callbacks,
+                            void* ros_message) -> iox::expected<void, SerializationError>;
+
+} // namespace rmw::iox2
+
+#endif
@@ -0,0 +1,47 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#ifndef RMW_IOX2_MESSAGE_TYPE_SUPPORT_HPP_
+#define RMW_IOX2_MESSAGE_TYPE_SUPPORT_HPP_
+
+#include "rmw/visibility_control.h"
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+#include "rosidl_typesupport_fastrtps_cpp/message_type_support.h"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+
+#include <cstddef>
+
+namespace rmw::iox2
+{
+
+/// @brief The handles and properties of a message type, resolved once from its typesupport
+/// @details Resolving a handle compares the identifiers of all typesupports available for the type. Entities
+///          resolve the handles on creation, so that publishing and taking messages does not need to.
+struct MessageTypeSupport
+{
+    /// The typesupport the handles were resolved from
+    const rosidl_message_type_support_t* type_support{nullptr};
+    /// The callbacks to (de)serialize the message, nullptr if the type provides no fastrtps typesupport
+    const message_type_support_callbacks_t* callbacks{nullptr};
+    /// The members of the message, nullptr if the type provides no C++ introspection typesupport
+    const rosidl_typesupport_introspection_cpp::MessageMembers* members{nullptr};
+    /// The size of the (unserialized) message struct
+    size_t size{0};
+    /// Whether the message is self-contained, thus can be transferred without serialization
+    bool is_pod{false};
+};
+
+/// @brief Resolve the handles and properties of a message type
+/// @param[in] type_support The typesupport of the message
+/// @return The resolved handles and properties
+RMW_PUBLIC auto resolve(const rosidl_message_type_support_t* type_support) -> MessageTypeSupport;
+
+} // namespace rmw::iox2
+
+#endif
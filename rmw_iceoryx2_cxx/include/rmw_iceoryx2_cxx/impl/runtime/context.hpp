@@ -10,19 +10,29 @@
 #ifndef RMW_IOX2_RUNTIME_CONTEXT_HPP_
 #define RMW_IOX2_RUNTIME_CONTEXT_HPP_
 
+#include "iox/duration.hpp"
 #include "iox/optional.hpp"
 #include "rmw/visibility_control.h"
 #include "rmw_iceoryx2_cxx/impl/common/creation_lock.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/error.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/topic_config.hpp"
 #include "rmw_iceoryx2_cxx/impl/middleware/iceoryx2.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/event_dispatcher.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/listener_registry.hpp"
 
 #include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 class rmw_context_impl_s;
 
 namespace rmw::iox2
 {
 
+class Publisher;
+
 template <>
 struct Error<rmw_context_impl_s>
 {
@@ -42,11 +52,17 @@ class RMW_PUBLIC rmw_init_options_impl_s
 constexpr rmw_init_options_impl_s INITIALIZED_OPTIONS{};
 
 /// @brief Implementation of the RMW context for iceoryx2
-/// @details The context manages the lifetime of entities used to implement guard conditions
+/// @details The context manages the lifetime of entities used to implement guard conditions, the listeners
+///          shared by all waitsets created in it and the thread dispatching new-message callbacks
 class RMW_PUBLIC rmw_context_impl_s
 {
     using CreationLock = ::rmw::iox2::CreationLock;
     using Iceoryx2 = ::rmw::iox2::Iceoryx2;
+    using ListenerRegistry = ::rmw::iox2::ListenerRegistry;
+    using EventDispatcher = ::rmw::iox2::EventDispatcher;
+    using TopicConfig = ::rmw::iox2::TopicConfig;
+    using Publisher = ::rmw::iox2::Publisher;
+    using Duration = ::iox::units::Duration;
 
 public:
     using ErrorType = ::rmw::iox2::Error<rmw_context_impl_s>::Type;
@@ -70,10 +86,95 @@ public:
     /// @return The generated guard condition ID
     auto generate_guard_condition_id() -> uint32_t;
 
+    /// @brief Generate a new unique identifier for a waitset
+    /// @return The generated waitset ID
+    auto generate_waitset_id() -> uint32_t;
+
+    /// @brief Get the registry of listeners shared by all waitsets created in this context
+    /// @return Reference to the listener registry
+    auto listener_registry() -> ListenerRegistry&;
+
+    /// @brief Get the dispatcher invoking the new-message callbacks of subscribers created in this context
+    /// @details The dispatcher and its thread are created on first use, thus contexts of applications not using
+    ///          event-driven executors do not run an additional thread.
+    /// @return Pointer to the dispatcher, error if it could not be created
+    auto event_dispatcher() -> iox::expected<EventDispatcher*, ErrorType>;
+
+    /// @brief Get the time for which waitsets created in this context poll for data before blocking
+    /// @details Configured via the RMW_IOX2_WAITSET_SPIN_BUDGET_US environment variable
+    /// @return The spin budget, zero if waitsets should block immediately
+    auto waitset_spin_budget() const -> Duration;
+
+    /// @brief Check if waitsets created in this context defer subscribers in favor of those with higher priority
+    /// @details Configured via the RMW_IOX2_WAITSET_PRIORITIZATION environment variable
+    /// @return True if enabled, in which case lower priorities may be reported in later wait calls
+    auto waitset_prioritization() const -> bool;
+
+    /// @brief Get the settings of the topics used by entities created in this context
+    /// @details Configured via the file at the path given by the RMW_IOX2_TOPIC_CONFIG environment variable
+    /// @return The topic configuration, using the built-in defaults for all topics if not configured
+    auto topic_config() const -> const TopicConfig&;
+
+    /// @brief Check if messages that are not self-contained are serialized speculatively in a single pass
+    /// @details Configured via the RMW_IOX2_SPECULATIVE_SERIALIZATION environment variable
+    /// @return True unless disabled, in which case the serialized size is determined before every serialization
+    auto speculative_serialization() const -> bool;
+
+    /// @brief Get the largest payload loaned by publishers on a topic in this context
+    /// @details Used to size the payload segments of publishers created later on the topic, so that they do not need
+    ///          to grow to the same size again
+    /// @param[in] topic The fully qualified name of the topic
+    /// @return The largest payload size in bytes, zero if no payload was recorded for the topic
+    auto payload_size_hint(const std::string& topic) -> uint64_t;
+
+    /// @brief Record the size of a payload loaned by a publisher on a topic
+    /// @param[in] topic The fully qualified name of the topic
+    /// @param[in] number_of_bytes The size of the payload
+    auto record_payload_size(const std::string& topic, uint64_t number_of_bytes) -> void;
+
+    /// @brief Mark the calling thread as waiting in this context, i.e. as the thread of an executor
+    /// @details Called by waitsets before waiting. A thread remains marked until it waits in another context, as
+    ///          publishing from callbacks between waits is to be deferred. Contexts created later are never
+    ///          considered marked, even if created at the address of the context marked last.
+    auto mark_waiting_thread() -> void;
+
+    /// @brief Check if the calling thread waits in this context
+    /// @details Notifications are only deferred on such threads, as only they flush them by waiting again
+    /// @return True if the last wait of the calling thread was in this context
+    auto is_waiting_thread() const -> bool;
+
+    /// @brief Defer the notification of the subscribers of a publisher until the next wait in this context
+    /// @param[in] publisher The publisher, must call cancel_deferred_notification before it is destroyed
+    auto defer_notification(Publisher& publisher) -> void;
+
+    /// @brief Cancel a deferred notification of a publisher
+    /// @param[in] publisher The publisher
+    auto cancel_deferred_notification(Publisher& publisher) -> void;
+
+    /// @brief Notify the subscribers of all publishers that deferred their notifications
+    /// @details Called by waitsets before waiting, i.e. at the end of the executor cycle in which was published
+    auto flush_deferred_notifications() -> void;
+
 private:
     const uint32_t m_id;
+    // Unique within the process, unlike the address of the context, which may be reused by a later context
+    const uint64_t m_generation;
     iox::optional<Iceoryx2> m_iox2;
+    iox::optional<ListenerRegistry> m_listener_registry;
+    // Declared after the registry, so that the listeners acquired by the dispatcher are released first
+    std::mutex m_event_dispatcher_mutex;
+    iox::optional<EventDispatcher> m_event_dispatcher;
     std::atomic<uint32_t> m_guard_condition_counter{0};
+    std::atomic<uint32_t> m_waitset_counter{0};
+    Duration m_waitset_spin_budget{Duration::zero()};
+    bool m_waitset_prioritization{false};
+    TopicConfig m_topic_config;
+    bool m_speculative_serialization{true};
+    std::mutex m_payload_size_mutex;
+    std::unordered_map<std::string, uint64_t> m_payload_size_hints;
+    // Held while flushing, so that publishers cannot be destroyed while their notification is flushed
+    std::mutex m_deferred_notifications_mutex;
+    std::vector<Publisher*> m_deferred_notifications;
 };
 }
 
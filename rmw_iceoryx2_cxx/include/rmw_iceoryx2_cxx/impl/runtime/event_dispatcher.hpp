@@ -0,0 +1,213 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#ifndef RMW_IOX2_RUNTIME_EVENT_DISPATCHER_HPP_
+#define RMW_IOX2_RUNTIME_EVENT_DISPATCHER_HPP_
+
+#include "iox/expected.hpp"
+#include "iox/optional.hpp"
+#include "rmw/event_callback_type.h"
+#include "rmw/visibility_control.h"
+#include "rmw_iceoryx2_cxx/impl/common/creation_lock.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/error.hpp"
+#include "rmw_iceoryx2_cxx/impl/middleware/iceoryx2.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/listener_registry.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace rmw::iox2
+{
+
+class Subscriber;
+class EventDispatcher;
+
+template <>
+struct Error<EventDispatcher>
+{
+    using Type = EventDispatcherError;
+};
+
+/// @brief Invokes the new-message callbacks of subscribers from a dedicated thread
+/// @details Used by event-driven executors (e.g. the EventsExecutor), which register callbacks instead of waiting on
+///          waitsets. The listeners of all topics with registered callbacks are acquired from the listener registry of
+///          the context to be relayed by it, thus shared with the waitsets of the context, and armed for as long as
+///          callbacks are registered. The registry wakes up the dispatcher thread on their events, which then checks
+///          the subscribers for samples. If waiting fails or the process is requested to terminate, the dispatcher
+///          keeps dispatching periodically until destroyed.
+///
+///          While a callback is registered, the waiter count of the subscriber is armed, so that publishers
+///          suppressing idle notifications notify the listener.
+///
+///          Callbacks are invoked without holding the lock guarding the registrations, thus callbacks may register
+///          or remove callbacks themselves. Invocations are serialized with registering and removing callbacks from
+///          other threads, thus no callback is invoked once the registration is removed.
+class RMW_PUBLIC EventDispatcher
+{
+    using Guard = Iceoryx2::WaitSet::Guard;
+    using AttachmentId = Iceoryx2::WaitSet::AttachmentId;
+    using IceoryxWaitSet = Iceoryx2::WaitSet::Handle;
+
+    /// @brief An attachment to the waitset of the dispatcher along with its ID
+    /// @details The attachment is detached from the waitset when this object is destroyed.
+    class Attachment
+    {
+    public:
+        explicit Attachment(Guard&& guard)
+            : m_guard{std::move(guard)}
+            , m_id{AttachmentId::from_guard(m_guard)} {
+        }
+
+        auto id() const -> const AttachmentId& {
+            return m_id;
+        }
+
+    private:
+        Guard m_guard;
+        AttachmentId m_id;
+    };
+
+    /// @brief The listener of a topic with registered callbacks, shared by all subscribers to the topic
+    /// @details The listener is armed for as long as the source exists, counting the notifications of the topic.
+    struct Source
+    {
+        Source(ListenerRegistry::Handle&& listener)
+            : listener{std::move(listener)} {
+            this->listener.arm(&events);
+        }
+        Source(const Source&) = delete;
+        Source(Source&&) = delete;
+        Source& operator=(const Source&) = delete;
+        Source& operator=(Source&&) = delete;
+        ~Source() = default;
+
+        // Declared before the listener, so that the counter outlives the armed handle
+        std::atomic<uint64_t> events{0};
+        ListenerRegistry::Handle listener;
+        size_t registrations{0};
+        // The notifications to report on the current dispatch
+        uint64_t pending{0};
+    };
+
+    /// @brief A callback registered for a subscriber
+    struct Registration
+    {
+        Subscriber* subscriber;
+        rmw_event_callback_t callback;
+        const void* user_data;
+        Source* source;
+    };
+
+    /// @brief A callback to invoke after releasing the lock guarding the registrations
+    struct Invocation
+    {
+        Subscriber* subscriber;
+        size_t number_of_events;
+    };
+
+public:
+    using ErrorType = Error<EventDispatcher>::Type;
+
+public:
+    /// @brief Creates the dispatcher and starts its thread
+    /// @param[in] lock Creation lock to restrict construction to creation functions
+    /// @param[out] error Optional error that is set if construction fails
+    /// @param[in] iox2 The iceoryx2 handle to create the waker with. Must outlive the dispatcher.
+    /// @param[in] listener_registry The registry to acquire the listeners of topics from. Must outlive the dispatcher.
+    /// @param[in] waker_service_name The name of the event service used to wake up the dispatcher thread, must be
+    ///                               unique within the process. Woken up by the registry on events of the listeners.
+    EventDispatcher(CreationLock,
+                    iox::optional<ErrorType>& error,
+                    Iceoryx2& iox2,
+                    ListenerRegistry& listener_registry,
+                    const std::string& waker_service_name);
+    EventDispatcher(const EventDispatcher&) = delete;
+    EventDispatcher(EventDispatcher&&) = delete;
+    EventDispatcher& operator=(const EventDispatcher&) = delete;
+    EventDispatcher& operator=(EventDispatcher&&) = delete;
+
+    /// @brief Stops the dispatcher thread and releases all listeners
+    ~EventDispatcher();
+
+    /// @brief Register the callback to invoke when new messages are received by a subscriber
+    /// @details Replaces the callback registered for the subscriber, if any, without reporting the samples again.
+    ///          Otherwise, if the subscriber already holds samples, the callback is invoked immediately by the
+    ///          calling thread.
+    ///
+    ///          iceoryx2 does not expose the number of samples queued for a subscriber. On new messages, the callback
+    ///          is passed the number of notifications received for the topic since the previous invocation, which is
+    ///          the number of new samples unless notifications are coalesced, thus samples are reported once. Only the
+    ///          samples received before the callback is set are reported with the depth of the subscriber, an upper
+    ///          bound of the number of samples that can be taken. Taking beyond the queued samples takes nothing.
+    /// @param[in] subscriber The subscriber, must remove its callback before it is destroyed
+    /// @param[in] callback The callback to invoke, nullptr to remove the registration
+    /// @param[in] user_data The data to pass to the callback
+    /// @return Error if the listener of the topic could not be acquired
+    auto set_callback(Subscriber& subscriber, rmw_event_callback_t callback, const void* user_data)
+        -> iox::expected<void, ErrorType>;
+
+    /// @brief Remove the callback registered for a subscriber
+    /// @details Once returned, the callback is no longer invoked. Does nothing if no callback is registered.
+    /// @param[in] subscriber The subscriber
+    auto remove_callback(Subscriber& subscriber) -> void;
+
+    /// @brief Get the number of callbacks currently registered
+    /// @return The number of registrations
+    auto registration_count() const -> size_t;
+
+private:
+    /// @brief The loop run by the dispatcher thread until stopped
+    auto run() -> void;
+
+    /// @brief Interval of dispatching while waiting fails or once the process is requested to terminate
+    static constexpr std::chrono::milliseconds DEGRADED_DISPATCH_INTERVAL{10};
+
+    /// @brief Invoke the callbacks of the subscribers holding samples of topics notified since the previous call
+    /// @note Only to be called while holding the dispatch lock
+    auto dispatch() -> void;
+
+    /// @brief Check if the subscriber of a registration holds samples
+    /// @param[in] registration The registration to check the subscriber of
+    /// @return True if samples can be taken
+    static auto has_samples(const Registration& registration) -> bool;
+
+    /// @brief Invoke the callback currently registered for a subscriber, if any
+    /// @param[in] invocation The subscriber and the number of events to pass to its callback
+    /// @note Only to be called while holding the dispatch lock, and not the lock guarding the registrations
+    auto invoke(const Invocation& invocation) -> void;
+
+    auto wake() -> void;
+
+    ListenerRegistry& m_listener_registry;
+    iox::optional<IceoryxWaitSet> m_waitset;
+    iox::optional<Waker> m_waker;
+    iox::optional<Attachment> m_waker_attachment;
+
+    // Held while invoking callbacks, recursive so that callbacks can register and remove callbacks
+    std::recursive_mutex m_dispatch_mutex;
+    // Only accessed by the dispatcher thread
+    std::vector<Invocation> m_invocations;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, std::unique_ptr<Source>> m_sources;
+    std::vector<Registration> m_registrations;
+
+    std::atomic<bool> m_stop{false};
+    std::thread m_thread;
+};
+
+} // namespace rmw::iox2
+
+#endif
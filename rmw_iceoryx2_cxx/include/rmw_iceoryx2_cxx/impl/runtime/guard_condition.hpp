@@ -14,10 +14,13 @@
 #include "iox2/unique_port_id.hpp"
 #include "rmw/visibility_control.h"
 #include "rmw_iceoryx2_cxx/impl/common/creation_lock.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/lifetime.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/error.hpp"
 #include "rmw_iceoryx2_cxx/impl/middleware/iceoryx2.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/context.hpp"
 
+#include <atomic>
+
 namespace rmw::iox2
 {
 
@@ -63,16 +66,36 @@ public:
     /// @return The service name
     auto service_name() const -> const std::string&;
 
+    /// @brief Get the hash of the service name, computed once on creation
+    /// @details Allows the listener of the guard condition to be looked up without hashing the service name on every
+    ///          wait
+    /// @return The hash of the service name
+    auto service_name_hash() const -> size_t;
+
+    /// @brief Get the lifetime of the guard condition
+    /// @details Allows resources held on behalf of the guard condition to be released after it is destroyed
+    /// @return Reference to the lifetime
+    auto lifetime() const -> const Lifetime&;
+
     /// @brief Triggers the guard condition
     /// @return Error if trigger via iceoryx2 failed
     auto trigger() -> iox::expected<void, ErrorType>;
 
+    /// @brief Consume a pending trigger of the guard condition
+    /// @details Allows in-process waiters to detect triggers without going through the iceoryx2 event. Does not
+    ///          consume the iceoryx2 event.
+    /// @return True if the guard condition was triggered since the trigger was last consumed
+    auto consume_trigger() -> bool;
+
 private:
     const uint32_t m_trigger_id;
     const std::string m_service_name;
+    const size_t m_service_name_hash;
 
     iox::optional<IdType> m_iox2_unique_id;
     iox::optional<IceoryxNotifier> m_iox2_notifier;
+    Lifetime m_lifetime;
+    std::atomic<bool> m_triggered{false};
 };
 
 } // namespace rmw::iox2
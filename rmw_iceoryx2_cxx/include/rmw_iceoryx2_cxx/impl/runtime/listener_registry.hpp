@@ -0,0 +1,321 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#ifndef RMW_IOX2_RUNTIME_LISTENER_REGISTRY_HPP_
+#define RMW_IOX2_RUNTIME_LISTENER_REGISTRY_HPP_
+
+#include "iox/expected.hpp"
+#include "iox/optional.hpp"
+#include "rmw/visibility_control.h"
+#include "rmw_iceoryx2_cxx/impl/common/creation_lock.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/error.hpp"
+#include "rmw_iceoryx2_cxx/impl/middleware/iceoryx2.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace rmw::iox2
+{
+
+class Waker;
+class ListenerRegistry;
+
+template <>
+struct Error<Waker>
+{
+    using Type = ListenerRegistryError;
+};
+
+template <>
+struct Error<ListenerRegistry>
+{
+    using Type = ListenerRegistryError;
+};
+
+/// @brief Wakes up a thread blocked on a waitset from any other thread in the process
+/// @details Backed by a process-local iceoryx2 event. The listener is attached to the waitset to be woken up.
+class RMW_PUBLIC Waker
+{
+    using Listener = Iceoryx2::Local::Listener;
+    using Notifier = Iceoryx2::Local::Notifier;
+
+public:
+    using ErrorType = Error<Waker>::Type;
+
+public:
+    /// @brief Creates a new waker
+    /// @param[in] lock Creation lock to restrict construction to creation functions
+    /// @param[out] error Optional error that is set if construction fails
+    /// @param[in] iox2 The iceoryx2 handle to create the event with
+    /// @param[in] service_name The name of the event service, must be unique within the process
+    Waker(CreationLock, iox::optional<ErrorType>& error, Iceoryx2& iox2, const std::string& service_name);
+
+    /// @brief Get the listener to attach to the waitset to be woken up
+    /// @return Reference to the listener
+    auto listener() -> Listener&;
+
+    /// @brief Wake up the waitset the listener is attached to
+    /// @note Thread-safe
+    /// @return Error if the notification failed
+    auto wake() -> iox::expected<void, ErrorType>;
+
+    /// @brief Consume all pending wakeups
+    /// @note Only to be called by the thread owning the waitset
+    /// @return True if a wakeup was pending, error if the events could not be retrieved
+    auto drain() -> iox::expected<bool, ErrorType>;
+
+private:
+    iox::optional<Listener> m_listener;
+    iox::optional<Notifier> m_notifier;
+    std::mutex m_notifier_mutex;
+};
+
+/// @brief Registry of the iceoryx2 listeners shared by all waitsets of a context
+/// @details Waitsets waiting on the same inter-process event service share a single listener, so that publishers
+///          only notify one listener per process regardless of how many waitsets (e.g. executors or callback groups)
+///          are waiting on the topic. Listeners are reference counted and released once no waitset holds them.
+///
+///          A listener held by a single waitset is exclusive and attached to the waitset of its holder directly, so
+///          that events wake up the holder without involving another thread. A listener held by several waitsets, or
+///          acquired for relaying, is relayed instead: it is only attached to the waitset of a thread owned by the
+///          registry, which drains it. Waitsets only attach their waker for relayed listeners. While blocked, a
+///          waitset arms the handles of its listeners, and the listener is drained on behalf of the armed waitsets,
+///          waking up the others. Each event thus wakes up the registry thread and the waitsets currently blocked on
+///          the topic, rather than every waitset holding the listener twice over. Woken waitsets check their mapped
+///          entities for data. Once a relayed listener is exclusive again, its armed holder is woken up to attach it.
+///
+///          The thread is started when the first listener is relayed, thus contexts that only wait on subscribers
+///          from a single waitset do not run it. It runs until the registry is destroyed. Once the process is
+///          requested to terminate, waiting returns immediately, thus the listeners are drained periodically from
+///          then on. Failing to wait is reported to the armed waitsets, which check healthy() when woken up.
+class RMW_PUBLIC ListenerRegistry
+{
+    using Listener = Iceoryx2::InterProcess::Listener;
+    using Guard = Iceoryx2::WaitSet::Guard;
+    using AttachmentId = Iceoryx2::WaitSet::AttachmentId;
+    using IceoryxWaitSet = Iceoryx2::WaitSet::Handle;
+
+    /// @brief An attachment to the waitset of the registry along with its ID
+    /// @details The attachment is detached from the waitset when this object is destroyed.
+    class Attachment
+    {
+    public:
+        explicit Attachment(Guard&& guard)
+            : m_guard{std::move(guard)}
+            , m_id{AttachmentId::from_guard(m_guard)} {
+        }
+
+        auto id() const -> const AttachmentId& {
+            return m_id;
+        }
+
+    private:
+        Guard m_guard;
+        AttachmentId m_id;
+    };
+
+    /// @brief A waker armed on a listener, along with the counter of the events of the listener, if any
+    struct Armed
+    {
+        Waker* waker;
+        std::atomic<uint64_t>* events;
+    };
+
+    /// @brief Interval in which the registry thread drains the relayed listeners when it cannot block on them
+    static constexpr std::chrono::milliseconds DEGRADED_POLL_INTERVAL{10};
+
+    /// @brief A listener shared between waitsets along with the wakers of the waitsets blocked on it
+    struct Entry
+    {
+        Entry(const std::string& service_name, Listener&& listener);
+        Entry(const Entry&) = delete;
+        Entry(Entry&&) = delete;
+        Entry& operator=(const Entry&) = delete;
+        Entry& operator=(Entry&&) = delete;
+        ~Entry() = default;
+
+        const std::string service_name;
+        Listener listener;
+
+        // Only accessed by the registry thread
+        iox::optional<Attachment> attachment{};
+
+        // Guarded by the lock of the registry. The entry is released by the registry thread once zero.
+        size_t handles{0};
+        // Guarded by the lock of the registry. The number of handles acquired for relaying.
+        size_t relaying_handles{0};
+
+        // Whether the listener is attached to the waitset of the registry thread instead of the one of its holder.
+        // Written while holding the lock of the registry.
+        std::atomic<bool> relayed{false};
+
+        // Guards the armed wakers and draining the listener, which may happen from the registry thread and the
+        // holder of an exclusive listener while it changes to being relayed
+        std::mutex mutex;
+        std::vector<Armed> armed;
+    };
+
+    /// @brief Entry of the index from attachment IDs to the entries, sorted by attachment ID
+    struct IndexEntry
+    {
+        const AttachmentId* id;
+        Entry* entry;
+    };
+
+public:
+    using ErrorType = Error<ListenerRegistry>::Type;
+
+    /// @brief A reference to a shared listener held by a single waitset
+    /// @details The waker of the waitset is woken up on events of the listener while the handle is armed.
+    class RMW_PUBLIC Handle
+    {
+    public:
+        Handle(const Handle&) = delete;
+        Handle(Handle&& other) noexcept;
+        Handle& operator=(const Handle&) = delete;
+        Handle& operator=(Handle&& other) noexcept;
+        ~Handle();
+
+        /// @brief Wake up the waker of the handle on subsequent events of the listener
+        /// @details To be called before checking for data a last time before blocking, so that no event is missed.
+        ///          Does nothing if already armed.
+        /// @param[in] events Optional counter the number of events is added to before each wakeup, must remain valid
+        ///                   while armed
+        auto arm(std::atomic<uint64_t>* events = nullptr) -> void;
+
+        /// @brief Stop waking up the waker of the handle on events of the listener
+        /// @details Does nothing if not armed.
+        auto disarm() -> void;
+
+        /// @brief Check if the listener is held exclusively by this handle
+        /// @details Exclusive listeners are to be attached to the waitset of the holder and drained via drain(),
+        ///          relayed listeners are drained by the registry thread.
+        /// @return True if the holder is to attach the listener itself
+        auto exclusive() const -> bool;
+
+        /// @brief Get the listener to attach to the waitset of the holder while exclusive
+        /// @return Reference to the listener, its events must only be consumed via drain()
+        auto listener() -> Listener&;
+
+        /// @brief Consume all pending events of the listener and wake up the other armed holders
+        /// @return True if events were pending
+        auto drain() -> bool;
+
+    private:
+        friend class ListenerRegistry;
+        Handle(ListenerRegistry& registry, Entry& entry, Waker& waker, bool relaying);
+
+        auto release() -> void;
+
+        ListenerRegistry* m_registry;
+        Entry* m_entry;
+        Waker* m_waker;
+        bool m_relaying{false};
+        bool m_armed{false};
+    };
+
+public:
+    /// @brief Creates an empty registry
+    /// @param[in] iox2 The iceoryx2 handle to create listeners with. Must outlive the registry.
+    /// @param[in] waker_service_name The name of the event service used to wake up the registry thread, must be
+    ///                               unique within the process
+    ListenerRegistry(Iceoryx2& iox2, const std::string& waker_service_name);
+    ListenerRegistry(const ListenerRegistry&) = delete;
+    ListenerRegistry(ListenerRegistry&&) = delete;
+    ListenerRegistry& operator=(const ListenerRegistry&) = delete;
+    ListenerRegistry& operator=(ListenerRegistry&&) = delete;
+
+    /// @brief Stops the registry thread and releases all listeners
+    ~ListenerRegistry();
+
+    /// @brief Acquire the listener for the provided inter-process event service
+    /// @details Creates the listener if no waitset currently holds one for the service. Starts the registry thread
+    ///          if the listener is relayed and the thread is not yet running.
+    /// @param[in] service_name The name of the event service
+    /// @param[in] waker The waker of the acquiring waitset. Must outlive the handle.
+    /// @param[in] relaying Whether the listener is always to be relayed by the registry thread, e.g. for holders
+    ///                     that count the events, instead of being attached by the holder while exclusive
+    /// @return Handle to the shared listener, error if it could not be created
+    auto acquire(const std::string& service_name, Waker& waker, bool relaying = false)
+        -> iox::expected<Handle, ErrorType>;
+
+    /// @brief Get the number of listeners currently held by waitsets
+    /// @return The number of listeners
+    auto listener_count() const -> size_t;
+
+    /// @brief Check if the registry thread is able to wait for events of the relayed listeners
+    /// @details Waitsets woken up by the registry are to report an error if not.
+    /// @return False if the last attempt of the registry thread to wait failed
+    auto healthy() const -> bool;
+
+private:
+    /// @brief Start the registry thread, if not yet running
+    /// @note Only to be called while holding the lock
+    auto start() -> iox::expected<void, ErrorType>;
+
+    /// @brief The loop run by the registry thread until stopped
+    auto run() -> void;
+
+    /// @brief Attach the listeners acquired since the previous call and release those no longer held
+    /// @note Only to be called by the registry thread while holding the lock
+    auto update_attachments() -> void;
+
+    /// @brief Drain the events of a listener and wake up the wakers armed on it
+    /// @param[in] entry The entry of the listener
+    /// @param[in] except The waker not to wake up, i.e. the one of the draining holder
+    /// @return The number of events drained
+    auto drain(Entry& entry, const Waker* except = nullptr) -> uint64_t;
+
+    /// @brief Drain all relayed listeners and wake up all armed wakers
+    /// @details Used when the registry thread cannot block, so that blocked waitsets check for data and observe the
+    ///          state of the registry.
+    /// @note Only to be called by the registry thread
+    auto wake_all_armed() -> void;
+
+    /// @brief Wake up the wakers armed on a listener
+    /// @note Only to be called while holding the lock of the entry
+    auto wake_armed(Entry& entry, const Waker* except) -> void;
+
+    /// @brief Determine whether the listener of an entry is to be relayed, starting the thread if required
+    /// @details Wakes up the registry thread if changed, which attaches or detaches the listener.
+    /// @note Only to be called while holding the lock
+    /// @return Error if the listener is to be relayed but the registry thread could not be started
+    auto update_relayed(Entry& entry) -> iox::expected<void, ErrorType>;
+
+    auto release(Entry& entry, bool relaying) -> void;
+
+    auto wake() -> void;
+
+    Iceoryx2& m_iox2;
+    const std::string m_waker_service_name;
+
+    mutable std::mutex m_mutex;
+    iox::optional<IceoryxWaitSet> m_waitset;
+    iox::optional<Waker> m_waker;
+    iox::optional<Attachment> m_waker_attachment;
+    // Declared after the waitset, so that all attachments are detached before the waitset is destroyed
+    std::unordered_map<std::string, std::unique_ptr<Entry>> m_entries;
+
+    // Only accessed by the registry thread, rebuilt whenever the attachments change
+    std::vector<IndexEntry> m_index;
+
+    std::atomic<bool> m_stop{false};
+    std::atomic<bool> m_healthy{true};
+    std::thread m_thread;
+};
+
+} // namespace rmw::iox2
+
+#endif
@@ -54,6 +54,10 @@ public:
     /// @return The name of the node
     auto name() const -> const std::string&;
 
+    /// @brief Get the context the node belongs to
+    /// @return Reference to the context
+    auto context() -> Context&;
+
     /// @brief Get the handle to the underlying iceoryx runtime
     /// @return Reference to the iceoryx handle
     auto iox2() -> Iceoryx2&;
@@ -63,6 +67,7 @@ public:
     auto graph_guard_condition() -> GuardCondition&;
 
 private:
+    Context& m_context;
     const std::string m_name;
     iox::optional<Iceoryx2> m_iox2;
     iox::optional<GuardCondition> m_graph_guard_condition;
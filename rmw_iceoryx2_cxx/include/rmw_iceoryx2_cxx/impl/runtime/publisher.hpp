@@ -12,14 +12,21 @@
 
 #include "iox/optional.hpp"
 #include "iox/slice.hpp"
+#include "rmw/types.h"
 #include "rmw/visibility_control.h"
 #include "rmw_iceoryx2_cxx/impl/common/creation_lock.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/error.hpp"
+#include "rmw_iceoryx2_cxx/impl/message/message_header.hpp"
+#include "rmw_iceoryx2_cxx/impl/message/type_support.hpp"
 #include "rmw_iceoryx2_cxx/impl/middleware/iceoryx2.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/node.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/sample_registry.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/waiter_count.hpp"
 #include "rosidl_typesupport_cpp/message_type_support.hpp"
 
+#include <atomic>
+#include <mutex>
+
 namespace rmw::iox2
 {
 
@@ -31,6 +38,17 @@ struct Error<Publisher>
     using Type = PublisherError;
 };
 
+/// @brief Statistics of the payload segment serialized messages are loaned from
+struct SegmentStatistics
+{
+    /// The largest payload in bytes the segment can currently provide without growing
+    uint64_t max_slice_len{0};
+    /// The largest payload in bytes loaned since creation
+    uint64_t payload_high_water_mark{0};
+    /// The number of times the segment grew to provide a larger payload
+    uint64_t resizes{0};
+};
+
 /// @brief Implementation of the RMW publisher for iceoryx2
 ///
 /// @details The implementation supports both copy and loan-based publishing mechanisms,
@@ -38,10 +56,27 @@ struct Error<Publisher>
 ///
 /// It manages the lifecycle of loaned memory and handles the interaction with the
 /// iceoryx2 middleware layer.
+///
+/// Loaning, returning and publishing are thread-safe. Loaned samples are tracked without locking, only the calls
+/// into the iceoryx2 ports, which are not thread-safe themselves, are serialized per publisher.
+///
+/// Payloads larger than the initial payload segment, e.g. of serialized messages with unbounded sequences, grow the
+/// segment to the next power of two. The largest payload is shared with publishers created later on the same topic,
+/// which start out with a segment of that size.
+///
+/// Subscribers are notified once per publish call. Publishers of topics configured to coalesce notifications instead
+/// defer the notification to the next wait in their context, so that samples published in one executor cycle wake
+/// up subscribers once. Notifications are only deferred when publishing from a thread that waits in the context, and
+/// for at most as many publish calls as subscribers buffer samples, so that they are neither withheld indefinitely nor
+/// sent after samples were already overwritten.
+///
+/// Every sample is stamped with a MessageHeader while holding the port lock, so that sequence numbers follow the
+/// order in which samples are sent.
 class RMW_PUBLIC Publisher
 {
 public:
     using Payload = ::iox::Slice<uint8_t>;
+    using UserHeader = MessageHeader;
     using ErrorType = Error<Publisher>::Type;
 
 private:
@@ -49,8 +84,8 @@ private:
     using IdType = ::iox2::UniquePublisherId;
 
     using IceoryxNotifier = Iceoryx2::InterProcess::Notifier;
-    using IceoryxPublisher = Iceoryx2::InterProcess::Publisher<Payload>;
-    using IceoryxSample = Iceoryx2::InterProcess::SampleMutUninit<Payload>;
+    using IceoryxPublisher = Iceoryx2::InterProcess::Publisher<Payload, UserHeader>;
+    using IceoryxSample = Iceoryx2::InterProcess::SampleMutUninit<Payload, UserHeader>;
     using SampleRegistry = SampleRegistry<IceoryxSample>;
 
 public:
@@ -60,11 +95,21 @@ public:
     /// @param[in] node The node that owns this publisher
     /// @param[in] topic The topic name to publish to
     /// @param[in] typesupport The message typesupport
+    /// @param[in] requested_qos The requested QoS, realized as far as supported by the service of the topic
     Publisher(CreationLock,
               iox::optional<ErrorType>& error,
               Node& node,
               const char* topic,
-              const rosidl_message_type_support_t* type_support);
+              const rosidl_message_type_support_t* type_support,
+              const rmw_qos_profile_t& requested_qos);
+
+    Publisher(const Publisher&) = delete;
+    Publisher(Publisher&&) = delete;
+    Publisher& operator=(const Publisher&) = delete;
+    Publisher& operator=(Publisher&&) = delete;
+
+    /// @brief Destructor, notifying subscribers of samples whose notification is still deferred
+    ~Publisher();
 
     /// @brief Get the unique identifier of this publisher
     /// @return The unique id or empty optional if failing to retrieve it from iceoryx2
@@ -78,6 +123,10 @@ public:
     /// @return Pointer to the typesupport stored in the loaded typesupport library
     auto typesupport() const -> const rosidl_message_type_support_t*;
 
+    /// @brief Get the handles and properties of the message type, resolved on creation
+    /// @return Reference to the resolved message type
+    auto message_type() const -> const MessageTypeSupport&;
+
     /// @brief Get the (unserialized) size of the message struct.
     /// @return Size of the message
     auto unserialized_size() const -> uint64_t;
@@ -86,6 +135,17 @@ public:
     /// @return The service name as string
     auto service_name() const -> const std::string&;
 
+    /// @brief Get the QoS effectively provided by the publisher
+    /// @details RELIABLE requests are BEST_EFFORT unless safe overflow is disabled for the service of the topic
+    /// @return The effective QoS
+    auto qos() const -> const rmw_qos_profile_t&;
+
+    /// @brief Get the number of bytes to loan for serializing a message without determining its size first
+    /// @details The largest payload loaned so far, which most serialized messages of a topic fit into. Messages that do
+    ///          not fit need to be sized and loaned again.
+    /// @return The number of bytes, zero if the serialized size must be determined first
+    auto speculative_payload_size() const -> uint64_t;
+
     /// @brief Loan memory for zero-copy publishing
     /// @return Expected containing pointer to loaned memory or error
     auto loan(uint64_t number_of_bytes) -> iox::expected<void*, ErrorType>;
@@ -107,16 +167,86 @@ public:
     /// @return Expected containing void or error if publish failed
     auto publish_copy(const void* data, uint64_t number_of_bytes) -> iox::expected<void, ErrorType>;
 
+    /// @brief Publish multiple messages by copying, notifying subscribers once
+    /// @details Samples sent before a failure remain published and subscribers are notified of them
+    /// @param[in] data Pointers to the message data to copy
+    /// @param[in] count Number of messages
+    /// @param[in] number_of_bytes Size of each message in bytes
+    /// @return Expected containing void or error if publishing any of the messages failed
+    auto publish_batch(const void* const* data, size_t count, uint64_t number_of_bytes)
+        -> iox::expected<void, ErrorType>;
+
+    /// @brief Send previously loaned memory without notifying subscribers
+    /// @details Allows sending multiple samples before notifying subscribers once via notify()
+    /// @param[in] loaned_memory Pointer to the loaned memory to send
+    /// @param[in] number_of_bytes The number of bytes at the start of the loan holding the message, if not all of
+    ///                            them. Recorded in the header of the sample, so that subscribers ignore the rest.
+    /// @return Expected containing void or error if sending failed or the loan is smaller than number_of_bytes
+    auto send_loan(void* loaned_memory, const iox::optional<uint64_t>& number_of_bytes = iox::nullopt)
+        -> iox::expected<void, ErrorType>;
+
+    /// @brief Notify subscribers of the samples sent since the last notification
+    /// @details Deferred to the next wait in the context if the topic coalesces notifications and the calling thread
+    ///          waits in the context, unless the subscriber buffers would be filled by the deferred samples
+    /// @return Expected containing void or error if the notification failed
+    auto notify() -> iox::expected<void, ErrorType>;
+
+    /// @brief Notify subscribers if a notification was deferred
+    /// @return Expected containing void or error if the notification failed
+    auto flush_notification() -> iox::expected<void, ErrorType>;
+
+    /// @brief Get the number of notifications skipped as no waitset was blocked waiting for samples of the topic
+    /// @details Only notifications of topics suppressing idle notifications are skipped
+    /// @return The number of skipped notifications since creation
+    auto suppressed_notifications() const -> uint64_t;
+
+    /// @brief Get the statistics of the samples currently loaned from the publisher
+    /// @return Snapshot of the loan statistics
+    auto loan_statistics() const -> LoanStatistics;
+
+    /// @brief Get the statistics of the payload segment of the publisher
+    /// @return Snapshot of the segment statistics
+    auto segment_statistics() const -> SegmentStatistics;
+
+private:
+    auto track_payload_size(uint64_t number_of_bytes) -> void;
+    auto stamp(UserHeader& header, uint64_t payload_size) -> void;
+    auto notify_now() -> iox::expected<void, ErrorType>;
+
 private:
+    Context& m_context;
     const std::string m_topic;
-    const rosidl_message_type_support_t* m_typesupport;
+    const MessageTypeSupport m_message_type;
     const uint64_t m_unserialized_size;
     const std::string m_service_name;
+    rmw_qos_profile_t m_qos;
+    const bool m_speculative_serialization;
+    bool m_coalesce_notifications{false};
 
     iox::optional<IdType> m_iox_unique_id;
     iox::optional<IceoryxNotifier> m_iox2_notifier;
     iox::optional<IceoryxPublisher> m_iox2_publisher;
-    SampleRegistry m_registry;
+    iox::optional<SampleRegistry> m_registry;
+    iox::optional<WaiterCount> m_waiters;
+
+    // Serializes access to the iceoryx2 publisher and notifier, including dropping loaned samples
+    std::mutex m_port_mutex;
+
+    // Copied into the header of every sample, the sequence number is written while holding the port mutex
+    uint8_t m_gid[RMW_GID_STORAGE_SIZE]{};
+    uint64_t m_sequence_number{0};
+
+    // Written while holding the port mutex, atomic to allow reading statistics concurrently
+    std::atomic<uint64_t> m_max_slice_len{0};
+    std::atomic<uint64_t> m_payload_high_water_mark{0};
+    std::atomic<uint64_t> m_segment_resizes{0};
+
+    // Set while the publisher is registered for a deferred notification with the context
+    std::atomic<bool> m_notification_pending{false};
+    // The number of notifications deferred since subscribers were last notified, bounded by their buffer size
+    std::atomic<uint64_t> m_deferred_notifications{0};
+    uint64_t m_max_deferred_notifications{1};
+    std::atomic<uint64_t> m_suppressed_notifications{0};
 };
 
 } // namespace rmw::iox2
@@ -14,7 +14,11 @@
 #include "iox/optional.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/error.hpp"
 
-#include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
 
 namespace rmw::iox2
 {
@@ -28,6 +32,19 @@ struct Error<SampleRegistry<T>>
     using Type = SampleRegistryError;
 };
 
+/// @brief Snapshot of the loans held in a SampleRegistry, for diagnosing loans that are never returned
+struct LoanStatistics
+{
+    /// The maximum number of loans that can be held at once
+    size_t capacity{0};
+    /// The number of loans currently held
+    size_t outstanding{0};
+    /// The largest number of loans held at once since creation
+    size_t high_water_mark{0};
+    /// How long the oldest loan currently held has been held for, zero if no loans are held
+    std::chrono::nanoseconds oldest_loan_age{0};
+};
+
 /// @brief Stores samples loaned from iceoryx2 before they are ready for publishing.
 /// @details Samples loaned from iceoryx2 must be retained until being published or manually released (e.g. by
 ///          subscriptions).
@@ -36,56 +53,222 @@ struct Error<SampleRegistry<T>>
 /// This is because this is the addresses that will be provided to the upper ROS layers to write the payload,
 /// and then provided back to the RMW to execute the publish or release the sample.
 ///
+/// The capacity is fixed at construction to the number of samples iceoryx2 allows to be loaned at once, thus storing
+/// and releasing samples never allocates. As this number is small, samples are kept in a flat array of slots that is
+/// searched linearly, which outperforms hashing at these sizes.
+///
+/// Samples can be stored and released concurrently from any thread without locking. Each slot is claimed via its
+/// atomic state before its sample is accessed, thus only one thread accesses the sample of a slot at a time.
+///
 template <typename SampleType>
 class SampleRegistry
 {
 public:
     using ErrorType = typename Error<SampleRegistry<SampleType>>::Type;
 
+private:
+    enum class SlotState : uint8_t {
+        /// The slot holds no sample and can be claimed for storing
+        FREE,
+        /// The slot is claimed by a thread storing or releasing a sample
+        CLAIMED,
+        /// The slot holds a sample
+        OCCUPIED
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Slot
+    {
+        std::atomic<SlotState> state{SlotState::FREE};
+        std::atomic<const uint8_t*> payload{nullptr};
+        // Atomic as it is read by statistics() without claiming the slot
+        std::atomic<Clock::rep> stored_at{0};
+        iox::optional<SampleType> sample{};
+    };
+
 public:
+    /// @brief Create a registry able to hold the given number of samples at once
+    /// @param[in] capacity The maximum number of samples stored at once
+    explicit SampleRegistry(size_t capacity)
+        : m_slots{std::make_unique<Slot[]>(capacity)}
+        , m_capacity{capacity} {
+    }
+
     /// @brief Store a sample in the registry and return a pointer to its payload
+    /// @note Thread-safe
     /// @param[in] sample The sample to store
-    /// @return Pointer to the payload data that can also be used to retrieve/release the sample later
-    auto store(SampleType&& sample) -> uint8_t* {
-        // const_cast required to work with Sample and SamplMut
-        // Should be adapted to handle both cases without casting (when functional)
-        auto payload_ptr = const_cast<uint8_t*>(sample.payload().data());
-        m_samples.emplace(payload_ptr, std::move(sample));
-        return payload_ptr;
+    /// @return Pointer to the payload data that can also be used to retrieve/release the sample later, error if the
+    ///         registry is full in which case the sample is not moved from
+    auto store(SampleType&& sample) -> iox::expected<uint8_t*, ErrorType> {
+        using iox::err;
+        using iox::ok;
+
+        for (size_t index = 0; index < m_capacity; index++) {
+            auto& slot = m_slots[index];
+            if (try_claim(slot, SlotState::FREE)) {
+                // const_cast required to work with Sample and SamplMut
+                // Should be adapted to handle both cases without casting (when functional)
+                auto payload_ptr = const_cast<uint8_t*>(sample.payload().data());
+                slot.sample.emplace(std::move(sample));
+                slot.payload.store(payload_ptr, std::memory_order_relaxed);
+                slot.stored_at.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+                slot.state.store(SlotState::OCCUPIED, std::memory_order_release);
+                update_high_water_mark(m_size.fetch_add(1, std::memory_order_relaxed) + 1);
+                return ok(payload_ptr);
+            }
+        }
+        return err(ErrorType::CAPACITY_EXCEEDED);
     }
 
     /// @brief Retrieve a stored sample by its payload pointer without removing it
+    /// @note The sample must not be released concurrently while it is accessed via the returned pointer
     /// @param[in] loaned_memory Pointer to the payload data
     /// @return Pointer to the stored sample if found, nullopt otherwise
     auto retrieve(uint8_t* loaned_memory) -> iox::optional<SampleType*> {
         using iox::nullopt;
 
-        auto it = m_samples.find(loaned_memory);
-        if (it != m_samples.end()) {
-            return &(it->second);
+        if (loaned_memory != nullptr) {
+            for (size_t index = 0; index < m_capacity; index++) {
+                auto& slot = m_slots[index];
+                if (slot.state.load(std::memory_order_acquire) == SlotState::OCCUPIED
+                    && slot.payload.load(std::memory_order_relaxed) == loaned_memory) {
+                    return &slot.sample.value();
+                }
+            }
         }
         return nullopt;
     }
 
     /// @brief Remove and return a stored sample
+    /// @note Thread-safe
     /// @param[in] loaned_memory Pointer to the payload data
     /// @return Expected containing the removed sample if found, error otherwise
     auto release(const uint8_t* loaned_memory) -> iox::expected<SampleType, ErrorType> {
         using iox::err;
         using iox::ok;
-        using iox::optional;
 
-        auto it = m_samples.find(loaned_memory);
-        if (it == m_samples.end()) {
-            return err(ErrorType::INVALID_PAYLOAD);
+        if (loaned_memory != nullptr) {
+            for (size_t index = 0; index < m_capacity; index++) {
+                auto& slot = m_slots[index];
+                if (slot.payload.load(std::memory_order_relaxed) != loaned_memory
+                    || !try_claim(slot, SlotState::OCCUPIED)) {
+                    continue;
+                }
+                // The slot may have been re-used for another sample between checking the payload and claiming it
+                if (slot.payload.load(std::memory_order_relaxed) != loaned_memory) {
+                    slot.state.store(SlotState::OCCUPIED, std::memory_order_release);
+                    continue;
+                }
+
+                auto sample = std::move(slot.sample.value());
+                slot.sample.reset();
+                slot.payload.store(nullptr, std::memory_order_relaxed);
+                slot.state.store(SlotState::FREE, std::memory_order_release);
+                m_size.fetch_sub(1, std::memory_order_relaxed);
+                return ok(std::move(sample));
+            }
         }
-        auto sample = std::move(it->second);
-        m_samples.erase(it);
-        return ok(std::move(sample));
+        return err(ErrorType::INVALID_PAYLOAD);
+    }
+
+    /// @brief Remove multiple stored samples in a single pass over the slots
+    /// @details Each removed sample is passed to the consumer. Payload pointers that are not found are ignored.
+    /// @note Thread-safe
+    /// @tparam Consumer Callable as consumer(SampleType&&)
+    /// @param[in] loaned_memory Pointers to the payload data
+    /// @param[in] count The number of pointers
+    /// @param[in] consumer The consumer taking ownership of the removed samples
+    /// @return The number of samples removed
+    template <typename Consumer>
+    auto release_all(const void* const* loaned_memory, size_t count, Consumer&& consumer) -> size_t {
+        const auto* end = loaned_memory + count;
+        auto is_requested = [loaned_memory, end](const uint8_t* payload) {
+            return payload != nullptr && std::find(loaned_memory, end, static_cast<const void*>(payload)) != end;
+        };
+
+        size_t released{0};
+        for (size_t index = 0; index < m_capacity && released < count; index++) {
+            auto& slot = m_slots[index];
+            auto payload = slot.payload.load(std::memory_order_relaxed);
+            if (!is_requested(payload) || !try_claim(slot, SlotState::OCCUPIED)) {
+                continue;
+            }
+            // The slot may have been re-used for another sample between checking the payload and claiming it
+            if (slot.payload.load(std::memory_order_relaxed) != payload) {
+                slot.state.store(SlotState::OCCUPIED, std::memory_order_release);
+                continue;
+            }
+
+            auto sample = std::move(slot.sample.value());
+            slot.sample.reset();
+            slot.payload.store(nullptr, std::memory_order_relaxed);
+            slot.state.store(SlotState::FREE, std::memory_order_release);
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+            consumer(std::move(sample));
+            released++;
+        }
+        return released;
+    }
+
+    /// @brief Get the maximum number of samples that can be stored at once
+    /// @return The capacity
+    auto capacity() const -> size_t {
+        return m_capacity;
+    }
+
+    /// @brief Get the number of samples currently stored
+    /// @note The value may be outdated immediately if samples are stored or released concurrently
+    /// @return The number of stored samples
+    auto size() const -> size_t {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Get the statistics of the loans held in the registry
+    /// @note The values may be outdated immediately if samples are stored or released concurrently
+    /// @return Snapshot of the loan statistics
+    auto statistics() const -> LoanStatistics {
+        auto now = Clock::now().time_since_epoch().count();
+        auto oldest = now;
+        for (size_t index = 0; index < m_capacity; index++) {
+            const auto& slot = m_slots[index];
+            if (slot.state.load(std::memory_order_acquire) == SlotState::OCCUPIED) {
+                oldest = std::min(oldest, slot.stored_at.load(std::memory_order_relaxed));
+            }
+        }
+
+        LoanStatistics statistics;
+        statistics.capacity = m_capacity;
+        statistics.outstanding = m_size.load(std::memory_order_relaxed);
+        statistics.high_water_mark = m_high_water_mark.load(std::memory_order_relaxed);
+        statistics.oldest_loan_age =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::duration{now - oldest});
+        return statistics;
     }
 
 private:
-    std::unordered_map<const uint8_t*, SampleType> m_samples;
+    auto update_high_water_mark(size_t size) -> void {
+        auto current = m_high_water_mark.load(std::memory_order_relaxed);
+        while (size > current
+               && !m_high_water_mark.compare_exchange_weak(current, size, std::memory_order_relaxed)) {
+        }
+    }
+
+    /// @brief Claim the slot for exclusive access if it is in the expected state
+    /// @return True if the slot was claimed
+    static auto try_claim(Slot& slot, SlotState expected) -> bool {
+        // Check before exchanging to avoid contending on slots in other states
+        if (slot.state.load(std::memory_order_relaxed) != expected) {
+            return false;
+        }
+        return slot.state.compare_exchange_strong(
+            expected, SlotState::CLAIMED, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    std::unique_ptr<Slot[]> m_slots;
+    const size_t m_capacity;
+    std::atomic<size_t> m_size{0};
+    std::atomic<size_t> m_high_water_mark{0};
 };
 
 } // namespace rmw::iox2
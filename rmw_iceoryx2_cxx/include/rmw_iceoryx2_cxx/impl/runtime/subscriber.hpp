@@ -13,12 +13,22 @@
 #include "iox/optional.hpp"
 #include "iox/slice.hpp"
 #include "iox2/unique_port_id.hpp"
+#include "rmw/event_callback_type.h"
+#include "rmw/types.h"
 #include "rmw/visibility_control.h"
 #include "rmw_iceoryx2_cxx/impl/common/creation_lock.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/error_message.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/lifetime.hpp"
+#include "rmw_iceoryx2_cxx/impl/message/message_header.hpp"
+#include "rmw_iceoryx2_cxx/impl/middleware/iceoryx2.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/node.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/sample_registry.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/waiter_count.hpp"
 #include "rosidl_typesupport_cpp/message_type_support.hpp"
 
+#include <mutex>
+#include <utility>
+
 namespace rmw::iox2
 {
 
@@ -34,6 +44,7 @@ struct SubscriberLoan
 {
     uint8_t* bytes;
     size_t number_of_bytes;
+    MessageHeader header;
 };
 
 /// @brief Implementation of the RMW subscriber for iceoryx2
@@ -42,18 +53,24 @@ struct SubscriberLoan
 ///
 /// It manages the lifecycle of loaned memory and handles the interaction with the
 /// iceoryx2 middleware layer.
+///
+/// Taking and returning loans is thread-safe. Borrowed samples are tracked without locking, only the calls into the
+/// iceoryx2 subscriber, which is not thread-safe itself, are serialized per subscriber.
 class RMW_PUBLIC Subscriber
 {
 public:
     using ErrorType = Error<Subscriber>::Type;
     using Payload = ::iox::Slice<uint8_t>;
+    using UserHeader = MessageHeader;
+    using Priority = uint8_t;
 
 private:
     using RawIdType = ::iox2::RawIdType;
     using IdType = ::iox2::UniqueSubscriberId;
-    using IceoryxSubscriber = Iceoryx2::InterProcess::Subscriber<Payload>;
-    using IceoryxSample = Iceoryx2::InterProcess::Sample<Payload>;
+    using IceoryxSubscriber = Iceoryx2::InterProcess::Subscriber<Payload, UserHeader>;
+    using IceoryxSample = Iceoryx2::InterProcess::Sample<Payload, UserHeader>;
     using SampleRegistry = SampleRegistry<IceoryxSample>;
+    using ReceiveResult = decltype(std::declval<IceoryxSubscriber&>().receive());
 
 public:
     /// @brief Constructor for SubscriberImpl
@@ -62,11 +79,21 @@ public:
     /// @param[in] node The node that owns this subscriber
     /// @param[in] topic The topic name to subscribe to
     /// @param[in] typesupport The message typesupport
+    /// @param[in] requested_qos The requested QoS, realized as far as supported by the service of the topic
     Subscriber(CreationLock,
                iox::optional<ErrorType>& error,
                Node& node,
                const char* topic,
-               const rosidl_message_type_support_t* type_support);
+               const rosidl_message_type_support_t* type_support,
+               const rmw_qos_profile_t& requested_qos);
+
+    Subscriber(const Subscriber&) = delete;
+    Subscriber(Subscriber&&) = delete;
+    Subscriber& operator=(const Subscriber&) = delete;
+    Subscriber& operator=(Subscriber&&) = delete;
+
+    /// @brief Destructor, removing the new-message callback if set
+    ~Subscriber();
 
     /// @brief Get the unique identifier of the subscriber
     /// @return Optional containing the raw ID of the subscriber
@@ -80,34 +107,191 @@ public:
     /// @return Pointer to the typesupport stored in the loaded typesupport library
     auto typesupport() const -> const rosidl_message_type_support_t*;
 
+    /// @brief Get the handles and properties of the message type, resolved on creation
+    /// @return Reference to the resolved message type
+    auto message_type() const -> const MessageTypeSupport&;
+
     /// @brief Get the service name used internally, required for matching via iceoryx2
     /// @return The service name as string
     auto service_name() const -> const std::string&;
 
+    /// @brief Get the hash of the service name, computed once on creation
+    /// @details Allows the listener of the subscriber to be looked up without hashing the service name on every wait
+    /// @return The hash of the service name
+    auto service_name_hash() const -> size_t;
+
+    /// @brief Get the count of waitsets blocked waiting for samples of the topic
+    /// @details Waitsets arm the count while blocked, so that publishers suppressing idle notifications wake them up.
+    ///          Only opened if idle notifications are suppressed on the topic.
+    /// @return Pointer to the waiter count, nullptr if publishers of the topic always notify
+    auto waiters() -> WaiterCount*;
+
+    /// @brief Get the QoS effectively provided by the subscriber
+    /// @details RELIABLE requests are BEST_EFFORT unless safe overflow is disabled for the service of the topic
+    /// @return The effective QoS
+    auto qos() const -> const rmw_qos_profile_t&;
+
+    /// @brief Get the lifetime of the subscriber
+    /// @details Allows resources held on behalf of the subscriber to be released after it is destroyed
+    /// @return Reference to the lifetime
+    auto lifetime() const -> const Lifetime&;
+
+    /// @brief Check if the subscriber only takes the newest queued sample
+    /// @details Enabled via the topic configuration
+    /// @return True if older samples are released without being read when taking
+    auto keep_latest() const -> bool;
+
+    /// @brief Get the priority of the subscriber in wait results
+    /// @return The priority, higher values take precedence
+    auto priority() const -> Priority;
+
+    /// @brief Set the priority of the subscriber in wait results
+    /// @details When subscribers of different priorities are triggered in the same wait, only those with the highest
+    ///          priority are reported.
+    /// @param[in] priority The priority, higher values take precedence
+    auto set_priority(Priority priority) -> void;
+
+    /// @brief Set the callback to invoke when new messages are received
+    /// @details The callback is invoked by the event dispatcher of the context, see EventDispatcher::set_callback.
+    /// @param[in] callback The callback to invoke, nullptr to remove the callback
+    /// @param[in] user_data The data to pass to the callback
+    /// @return Error if the callback could not be registered
+    auto set_event_callback(rmw_event_callback_t callback, const void* user_data) -> iox::expected<void, ErrorType>;
+
+    /// @brief Check if samples are available to be taken
+    /// @details Reads the state of the underlying iceoryx2 queue without blocking or consuming any events
+    /// @return Expected containing true if at least one sample is available
+    auto has_samples() -> iox::expected<bool, ErrorType>;
+
     /// @brief Take a message by copying it to the destination buffer
     /// @param[out] dest Pointer to the destination buffer
+    /// @param[out] header Optional destination for the header of the message, may be nullptr
     /// @return Expected containing true if a message was taken, false if no message available
-    auto take_copy(void* dest) -> iox::expected<bool, ErrorType>;
+    auto take_copy(void* dest, UserHeader* header = nullptr) -> iox::expected<bool, ErrorType>;
+
+    /// @brief Take multiple messages at once, receiving all of them while holding the port lock once
+    /// @details Each sample is passed to the handler while held and released once handled. Stops early when no
+    ///          further samples are available. Messages handled before a failure to receive or handle a sample are
+    ///          returned to the caller, the failure is reported by the next call. A sample that could not be handled
+    ///          is released and not handled again.
+    /// @tparam Handler Callable as handler(index, header, bytes, number_of_bytes), returning false if the sample
+    ///                 could not be handled
+    /// @param[in] count The maximum number of messages to take
+    /// @param[in] handler The handler to process each received sample with
+    /// @return Expected containing the number of messages taken, error if no message could be taken
+    template <typename Handler>
+    auto take_batch(size_t count, Handler&& handler) -> iox::expected<size_t, ErrorType>;
 
     /// @brief Take a loaned message without copying
     /// @return Expected containing optional pointer to the loaned message memory
     auto take_loan() -> iox::expected<iox::optional<SubscriberLoan>, ErrorType>;
 
+    /// @brief Take multiple loaned messages without copying, receiving all of them while holding the port lock once
+    /// @details Takes at most as many messages as can still be loaned. Messages taken before a failure to receive are
+    ///          returned to the caller, the failure is reported by the next call. Intended for self-contained
+    ///          messages, whose size is known from the message type.
+    /// @param[out] loaned_memory Storage for the pointers to the loaned memory, filled from the start
+    /// @param[in] count The maximum number of messages to take, must not exceed the size of the storage
+    /// @return Expected containing the number of loaned messages stored, error if no message could be received
+    auto take_loans(void** loaned_memory, size_t count) -> iox::expected<size_t, ErrorType>;
+
+    /// @brief Return multiple previously loaned messages at once
+    /// @details The loans are released from the registry in a single pass and dropped while holding the port lock
+    ///          once. Valid loans are returned even if others are invalid.
+    /// @param[in] loaned_memory Pointers to the loaned memory to return
+    /// @param[in] count The number of pointers
+    /// @return Expected containing void if all loans were returned, error if any pointer is not a loan
+    auto return_loans(void* const* loaned_memory, size_t count) -> iox::expected<void, ErrorType>;
+
     /// @brief Return previously loaned message memory
     /// @param[in] loaned_memory Pointer to the loaned memory to return
     /// @return Expected containing void if successful
     auto return_loan(void* loan) -> iox::expected<void, ErrorType>;
 
+    /// @brief Get the statistics of the samples currently loaned from the subscriber
+    /// @return Snapshot of the loan statistics
+    auto loan_statistics() const -> LoanStatistics;
+
 private:
+    /// @brief Receive the next sample to be taken
+    /// @details In keep-latest mode, the queue is drained and only the newest sample is returned. The older samples
+    ///          are released without being read, one at a time, so that they do not count towards the samples that
+    ///          can be borrowed at once.
+    /// @note Only to be called while holding the port lock
+    /// @return The result of receiving from the iceoryx2 subscriber
+    auto receive() -> ReceiveResult;
+
+    /// @brief Get the number of bytes of the payload of a sample holding the message
+    /// @details Messages serialized into loans sized for larger messages do not fill the payload, the number of bytes
+    ///          of the message is recorded in the header by the publisher.
+    /// @param[in] sample The received sample
+    /// @return The number of bytes of the message, at most the size of the payload
+    static auto message_size(const IceoryxSample& sample) -> size_t;
+
+    Context& m_context;
     const std::string m_topic;
-    const rosidl_message_type_support_t* m_typesupport;
+    const MessageTypeSupport m_message_type;
     const std::string m_service_name;
+    const size_t m_service_name_hash;
+    rmw_qos_profile_t m_qos;
 
     iox::optional<IdType> m_iox2_unique_id;
     iox::optional<IceoryxSubscriber> m_iox2_subscriber;
-    SampleRegistry m_registry;
+    iox::optional<SampleRegistry> m_registry;
+    iox::optional<WaiterCount> m_waiters;
+    Lifetime m_lifetime;
+
+    // Serializes access to the iceoryx2 subscriber, including dropping borrowed samples
+    std::mutex m_port_mutex;
+    // Failure of a batch that returned the messages taken before it, reported by the next batch
+    iox::optional<ErrorType> m_deferred_batch_error;
+    Priority m_priority{0};
+    bool m_keep_latest{false};
+    bool m_event_callback_set{false};
 };
 
+template <typename Handler>
+auto Subscriber::take_batch(size_t count, Handler&& handler) -> iox::expected<size_t, ErrorType> {
+    using ::iox::err;
+    using ::iox::ok;
+
+    std::lock_guard<std::mutex> lock{m_port_mutex};
+    if (m_deferred_batch_error.has_value()) {
+        auto error = m_deferred_batch_error.value();
+        m_deferred_batch_error.reset();
+        return err(error);
+    }
+
+    size_t taken{0};
+    while (taken < count) {
+        auto result = receive();
+        if (result.has_error()) {
+            RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(result.error()));
+            if (taken == 0) {
+                return err(ErrorType::RECV_FAILURE);
+            }
+            m_deferred_batch_error.emplace(ErrorType::RECV_FAILURE);
+            break;
+        }
+        auto& sample = result.value();
+        if (!sample.has_value()) {
+            break;
+        }
+
+        // The sample is released at the end of the iteration, before receiving the next one
+        if (!handler(taken, sample->user_header(), sample->payload().data(), message_size(sample.value()))) {
+            RMW_IOX2_CHAIN_ERROR_MSG("failed to handle received sample");
+            if (taken == 0) {
+                return err(ErrorType::INVALID_PAYLOAD);
+            }
+            m_deferred_batch_error.emplace(ErrorType::INVALID_PAYLOAD);
+            break;
+        }
+        taken++;
+    }
+    return ok(taken);
+}
+
 } // namespace rmw::iox2
 
 #endif
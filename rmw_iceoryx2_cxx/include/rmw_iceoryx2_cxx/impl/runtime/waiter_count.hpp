@@ -0,0 +1,126 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#ifndef RMW_IOX2_RUNTIME_WAITER_COUNT_HPP_
+#define RMW_IOX2_RUNTIME_WAITER_COUNT_HPP_
+
+#include "iox/optional.hpp"
+#include "rmw/visibility_control.h"
+#include "rmw_iceoryx2_cxx/impl/common/creation_lock.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/error.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace rmw::iox2
+{
+
+class WaiterCount;
+
+template <>
+struct Error<WaiterCount>
+{
+    using Type = WaiterCountError;
+};
+
+/// @brief The number of waitsets blocked waiting for samples on a topic, shared by all processes on the host
+/// @details Allows publishers to skip notifying subscribers when none of them would be woken up by it. Waitsets arm
+///          the count of their mapped subscribers before blocking and check for samples once more afterwards, while
+///          publishers check the count after sending. Either the publisher observes the armed count, or the waitset
+///          observes the sample, so that no wakeup is lost.
+///
+///          The count is stored in a small shared memory object named after the service of the topic, using the
+///          prefix of iceoryx2 and only accessible by the owning user. Each instance claims a slot recording the
+///          number of times it is armed, and holds an open file description lock on the byte of the object at the
+///          index of the slot for as long as it exists. The kernel releases the lock once the instance is destroyed
+///          or its process terminates, regardless of process ids or PID namespaces. Slots claimed without their lock
+///          held are reclaimed whenever an instance is created or destroyed, so that waitsets of crashed processes do
+///          not keep the count raised. The object is removed with the last instance. Instances exceeding the slots
+///          only cause notifications to be sent unnecessarily after crashing.
+class RMW_PUBLIC WaiterCount
+{
+    /// The number of instances on the host whose armed count can be reclaimed when their process terminates
+    static constexpr size_t SLOT_COUNT{256};
+
+    struct Slot
+    {
+        std::atomic<uint32_t> claimed;
+        std::atomic<uint32_t> waiting;
+    };
+
+    struct Segment
+    {
+        std::atomic<uint32_t> waiting;
+        Slot slots[SLOT_COUNT];
+    };
+
+public:
+    using ErrorType = Error<WaiterCount>::Type;
+
+public:
+    /// @brief Opens the count of a topic, creating it if it does not exist yet
+    /// @param[in] lock Creation lock to restrict construction to creation functions
+    /// @param[out] error Optional error that is set if construction fails
+    /// @param[in] service_name The name of the iceoryx2 service of the topic
+    WaiterCount(CreationLock, iox::optional<ErrorType>& error, const std::string& service_name);
+    WaiterCount(const WaiterCount&) = delete;
+    WaiterCount(WaiterCount&&) = delete;
+    WaiterCount& operator=(const WaiterCount&) = delete;
+    WaiterCount& operator=(WaiterCount&&) = delete;
+    ~WaiterCount();
+
+    /// @brief Register a waitset as about to block on the topic
+    /// @details The caller must check for samples after arming and before blocking.
+    /// @note Thread-safe
+    auto arm() -> void;
+
+    /// @brief Deregister a waitset that is no longer blocking on the topic
+    /// @details Does nothing if not armed, the count never drops below zero.
+    /// @note Thread-safe
+    auto disarm() -> void;
+
+    /// @brief Check if any waitset is blocked on the topic
+    /// @details The caller must have sent its samples before checking.
+    /// @note Thread-safe
+    /// @return True if a notification is required to wake up a waitset
+    auto any_waiting() const -> bool;
+
+    /// @brief Get the name of the shared memory object holding the count of a topic
+    /// @param[in] service_name The name of the iceoryx2 service of the topic
+    /// @return The name of the shared memory object
+    static auto shared_memory_name(const std::string& service_name) -> std::string;
+
+private:
+    /// @brief Claim a slot whose lock is not held, reclaiming its count if claimed by a terminated instance
+    /// @note Only to be called while holding the lock of the shared memory object
+    auto claim_slot() -> void;
+
+    /// @brief Check if the lock of a slot is held by another instance
+    /// @param[in] index The index of the slot
+    /// @return True if held, i.e. the instance claiming the slot still exists
+    auto is_held(size_t index) const -> bool;
+
+    /// @brief Remove the armed count of a slot from the total and release the slot
+    /// @note Only to be called while holding the lock of the shared memory object
+    auto release(Slot& slot) -> void;
+
+    /// @brief Release the slots claimed by instances that no longer exist
+    /// @note Only to be called while holding the lock of the shared memory object
+    auto reclaim_stale_slots() -> void;
+
+    std::string m_name;
+    int m_fd{-1};
+    Segment* m_segment{nullptr};
+    Slot* m_slot{nullptr};
+};
+
+} // namespace rmw::iox2
+
+#endif
@@ -16,11 +16,19 @@
 #include "rmw_iceoryx2_cxx/impl/common/creation_lock.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/error.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/error_message.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/lifetime.hpp"
 #include "rmw_iceoryx2_cxx/impl/middleware/iceoryx2.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/context.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/guard_condition.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/listener_registry.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/subscriber.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace rmw::iox2
@@ -34,6 +42,9 @@ static constexpr bool always_false = false;
 using RmwIndex = size_t;
 
 /// Types of entities that the waitset is capable of waiting on.
+/// @note Services, clients and events are not implemented yet. Once they are, they are to be added here and mapped
+///       to the listener of their iceoryx2 event service in the same way as subscribers, so that a single wait
+///       multiplexes all entities.
 enum class WaitableEntity { SUBSCRIBER, GUARD_CONDITION };
 
 class WaitSet;
@@ -48,6 +59,12 @@ struct Error<WaitSet>
 /// @details Waitable entities are tracked in upper layers (i.e. RCL) using indices.
 ///          This implementation maps these indices to iceoryx2 listeners for events signifying
 ///          work is available related to the associated the entities.
+///
+///          Listeners of subscribers are shared with all other waitsets of the context via its listener registry. A
+///          listener held by this waitset only is attached to it directly. A listener also held by other waitsets or
+///          the event dispatcher is attached to the registry instead, which wakes up the waitset on its events while
+///          it is blocked. Listeners of guard conditions are held and attached by each waitset, as a trigger must
+///          wake up every waitset.
 class RMW_PUBLIC WaitSet
 {
     using Duration = ::iox::units::Duration;
@@ -56,7 +73,7 @@ class RMW_PUBLIC WaitSet
     using AttachmentId = Iceoryx2::WaitSet::AttachmentId;
     using IceoryxWaitSet = Iceoryx2::WaitSet::Handle;
     using GuardConditionListener = Iceoryx2::Local::Listener;
-    using SubscriberListener = Iceoryx2::InterProcess::Listener;
+    using SubscriberListener = ListenerRegistry::Handle;
 
     /// @brief Helper to map listener types to their corresponding iceoryx2 service type
     /// @tparam ListenerType The type of listener to get the service type for
@@ -72,38 +89,59 @@ class RMW_PUBLIC WaitSet
         }
     }();
 
-    /// @brief Details about a listener including its service name and the listener itself
-    /// @tparam ListenerType The type of listener (GuardConditionListener or SubscriberListener)
-    template <typename ListenerType>
-    struct ListenerDetails
+    using StorageIndex = size_t;
+
+    /// A counter incremented whenever a storage slot is reclaimed.
+    using Generation = uint32_t;
+
+    /// A counter identifying the set of mappings between two calls to unmap_all().
+    using MappingRound = uint64_t;
+
+    /// Hasher for keys that already are hashes, i.e. the service name hashes cached by the mapped entities.
+    struct PrecomputedHash
     {
-        std::string service_name;
-        ListenerType listener;
+        auto operator()(size_t hash) const -> size_t {
+            return hash;
+        }
+    };
+
+    /// Lookup of the storage index of listeners by the hash of their service name.
+    /// Service names with colliding hashes are told apart by the service name stored with the listener.
+    using StorageLookup = std::unordered_multimap<size_t, StorageIndex, PrecomputedHash>;
+
+    /// @brief Handle to a listener in its storage.
+    /// @details The generation ensures that a handle to a reclaimed storage slot does not resolve to a listener
+    ///          stored in the slot afterwards.
+    struct StorageHandle
+    {
+        StorageIndex index;
+        Generation generation;
     };
-    using StorageIndex = size_t;
 
     /// @brief Mapping from RMW index to a stored listener.
     /// @details Allows for triggered listeners to be mapped back to the index that RMW uses for tracking
     struct RmwMapping
     {
         WaitableEntity waitable_type;
-        StorageIndex storage_index;
+        StorageHandle storage_handle;
         RmwIndex rmw_index;
+        /// The mapped GuardCondition or Subscriber, depending on the waitable type. Valid while mapped.
+        void* entity;
     };
 
-    /// @brief Description of a waitable that has been triggered
-    struct TriggeredWaitable
+    /// @brief Number of consecutive wait calls in which a triggered subscriber was deferred in favor of subscribers
+    ///        with higher priority.
+    /// @details Tracked per RMW index along with the subscriber, so that the count restarts if another subscriber is
+    ///          mapped to the index.
+    struct DeferralCount
     {
-        TriggeredWaitable(const RmwMapping& mapping)
-            : waitable_type{mapping.waitable_type}
-            , rmw_index{mapping.rmw_index} {
-        }
-        WaitableEntity waitable_type;
-        RmwIndex rmw_index;
+        const void* entity;
+        uint32_t count;
     };
 
     /// @brief Storage for waitset attachments containing the guard and attachment ID
-    /// @details Manages the lifetime of a waitset attachment and provides access to its ID and associated waitable
+    /// @details Manages the lifetime of a waitset attachment and provides access to its ID. The attachment is
+    ///          detached from the waitset when this object is destroyed.
     class AttachmentDetails
     {
     public:
@@ -112,38 +150,103 @@ class RMW_PUBLIC WaitSet
             , m_id{AttachmentId::from_guard(m_guard)} {
         }
 
-        AttachmentDetails(Guard&& guard, const RmwMapping& staged_waitable)
-            : m_guard{std::move(guard)}
-            , m_id{AttachmentId::from_guard(m_guard)}
-            , m_rmw_mapping{staged_waitable} {
-        }
-
         auto id() const -> const AttachmentId& {
             return m_id;
         }
 
-        auto mapping() const -> const RmwMapping& {
-            return m_rmw_mapping;
-        }
-
     private:
         Guard m_guard;
         AttachmentId m_id;
-        RmwMapping m_rmw_mapping;
     };
 
-    /// @brief Context for individual wait calls
-    /// @details An instance of this is created for each wait call to track all attachments.
+    /// @brief Details about a listener including its service name, the listener itself and its waitset attachment
+    /// @details The attachment is kept across wait calls for as long as the listener remains mapped, so that
+    ///          entities waited on repeatedly are only attached to the waitset once. The mapping round in which the
+    ///          listener was last mapped allows checking if it is already mapped without searching the mapping.
+    ///
+    ///          The lifetimes of all entities mapped to the listener are observed, each at most once. Observers of
+    ///          ended lifetimes are pruned when mapping and when unmapped. Once all have ended, the listener is
+    ///          reclaimed.
+    /// @tparam ListenerType The type of listener (GuardConditionListener or SubscriberListener)
+    template <typename ListenerType>
+    struct ListenerDetails
+    {
+        std::string service_name;
+        size_t service_name_hash;
+        ListenerType listener;
+        iox::optional<AttachmentDetails> attachment{};
+        MappingRound mapped_in_round{0};
+        std::vector<LifetimeObserver> owners{};
+    };
+
+    /// @brief A slot in the listener storage that can be reclaimed and re-used.
+    /// @tparam ListenerType The type of listener (GuardConditionListener or SubscriberListener)
+    template <typename ListenerType>
+    struct StorageSlot
+    {
+        Generation generation{0};
+        iox::optional<ListenerDetails<ListenerType>> details{};
+    };
+
+    /// @brief Storage for listeners of a specific type.
+    /// @details Reclaimed slots are re-used for new listeners, thus the storage only grows to the peak number of
+    ///          listeners held at once.
+    /// @tparam ListenerType The type of listener (GuardConditionListener or SubscriberListener)
+    template <typename ListenerType>
+    struct ListenerStorage
+    {
+        std::vector<StorageSlot<ListenerType>> slots;
+        std::vector<StorageIndex> free_slots;
+        StorageLookup lookup;
+    };
+
+    /// @brief Entry of the index from waitset attachments to the mappings of the attached listeners
+    /// @details The index is sorted by attachment ID, so that the mappings of a triggered attachment are found by
+    ///          binary search instead of searching the whole mapping for every event.
+    struct TriggerIndexEntry
+    {
+        const AttachmentId* id;
+        size_t mapping_index;
+    };
+
+    using TriggerIndex = std::vector<TriggerIndexEntry>;
+
+    /// Point in time at which a wait call times out.
+    using Deadline = std::chrono::steady_clock::time_point;
+
+    /// @brief Context for individual blocking waits
+    /// @details An instance of this is created for each blocking wait to track the number of triggered waitables and
+    ///          whether the waitset was woken up by another waitset.
     struct WaitContext
     {
-        iox::optional<AttachmentDetails> attached_timeout;
-        std::vector<AttachmentDetails> attached_listeners;
-        std::vector<TriggeredWaitable> result;
+        size_t triggered_count{0};
+        bool woken{false};
+    };
+
+    /// @brief Arms the waiter counts and shared listeners of the mapped subscribers for as long as it exists
+    /// @details Created before blocking, so that publishers suppressing idle notifications notify the listeners and
+    ///          the listener registry wakes up the waitset on their events.
+    class ArmedSubscribers
+    {
+    public:
+        explicit ArmedSubscribers(WaitSet& waitset);
+        ArmedSubscribers(const ArmedSubscribers&) = delete;
+        ArmedSubscribers(ArmedSubscribers&&) = delete;
+        ArmedSubscribers& operator=(const ArmedSubscribers&) = delete;
+        ArmedSubscribers& operator=(ArmedSubscribers&&) = delete;
+        ~ArmedSubscribers();
+
+    private:
+        WaitSet& m_waitset;
     };
 
 public:
     using ErrorType = Error<WaitSet>::Type;
 
+    /// The number of consecutive wait calls a triggered subscriber is deferred for at most in favor of subscribers
+    /// with higher priority.
+    static constexpr uint32_t MAX_DEFERRALS{4};
+
 public:
     /// @brief Constructor for the WaitSetImpl
     /// @param[in] lock Creation lock to restrict construction to creation functions
@@ -153,72 +256,172 @@ public:
 
     /// @brief Maps a guard condition to an RMW index
     /// @details A listener is created for the mapped guard condition which will be waited on in subsequent wait calls
-    ///          unless unmapped
+    ///          unless unmapped. The listener is released in the first wait call after the guard condition is
+    ///          destroyed.
     /// @param[in] rmw_index The index used to track the guard condition in the RMW
     /// @param[in] guard_condition The guard condition to be mapped
     auto map(RmwIndex rmw_index, GuardCondition& guard_condition) -> iox::expected<void, ErrorType>;
 
     /// @brief Maps a subscriber to an RMW index
     /// @details A listener is created for the mapped subscriber which will be waited on in subsequent wait calls
-    ///          unless unmapped
+    ///          unless unmapped. The listener is released in the first wait call after all subscribers sharing it are
+    ///          destroyed.
     /// @param[in] rmw_index The index used to track the subscriber in the RMW
     /// @param[in] subscribe The subscriber to be mapped
     auto map(RmwIndex rmw_index, Subscriber& subscriber) -> iox::expected<void, ErrorType>;
 
     /// @brief Unmap all currently mapped waitable entities
     /// @note Unmapped entities will not be waited on in subsequent wait calls
+    /// @note Waitset attachments are retained until the next wait call, where only the entities that were not mapped
+    ///       again are detached
     auto unmap_all() -> void;
 
-    // NOTE: Each wait is creating a new WaitContext and (re)-attaching waitable entities.
-    //       This is inefficient, but to improve it a more efficient way to compare waitable entities (other than
-    //       service name string comparison) is required.
-    //       With this, a WaitContext could be used and thus instead of detaching all attachments and reattching them in
-    //       subsequent waits, a diff of currently mapped entities and entities already in the context can be done and
-    //       processed accordingly.
-    //       ... Maybe XOR of the unique IDs? Something to try when time permits.
-    //
     /// @brief Block the thread until at least one attached entity is triggered or the timeout is reached.
+    /// @details Before waiting, the waitset attachments are brought in line with the current mapping. Listeners mapped
+    ///          since the previous wait are attached and listeners no longer mapped are detached, all others keep
+    ///          their existing attachment.
+    ///
+    ///          The mapped entities are polled once before blocking. If any subscriber still holds samples or any
+    ///          guard condition was triggered, the call returns immediately without involving the kernel.
+    ///
+    ///          While blocked, the waiter counts of the mapped subscribers are armed, so that publishers suppressing
+    ///          idle notifications notify the waitset. The subscribers are polled once more after arming.
+    ///
+    ///          Subscriber listeners held by this waitset only are attached directly. Those shared with other waitsets
+    ///          are drained by the listener registry, which wakes up the waitset on their events while blocked.
+    ///          Subscribers are reported if they hold samples once triggered or woken up, waiting continues otherwise.
+    ///          Once woken up, the attachments are updated to listeners changed between exclusive and shared. If the
+    ///          listener registry is failing to wait for events, an error is returned once woken up by it.
+    ///
+    ///          All triggered entities are reported, unless prioritization is enabled. If so and subscribers of
+    ///          different priorities are triggered, only those with the highest priority are reported. The others
+    ///          still hold their samples and are thus reported by subsequent wait calls. To not starve them under
+    ///          sustained load of higher priorities, a subscriber deferred in MAX_DEFERRALS consecutive wait calls is
+    ///          reported regardless of its priority. Guard conditions are always reported.
+    ///
+    ///          The timeout is passed to the blocking call directly, thus no timer is attached to the waitset.
+    ///
+    ///          Triggered waitables are recorded in storage sized when mapping, thus waiting on an unchanged set of
+    ///          entities does not allocate. The results remain valid until the next wait call, even if unmapped.
+    ///
+    ///          Notifications deferred by publishers in the context are flushed before waiting.
     /// @param timeout Optional timeout after which waiting is stopped. If null waits indefinitely. If 0 does not wait
     ///                at all.
-    /// @returns All triggered waitables.
-    // TODO: Change return type. Copying the result vector is likely waste of runtime.
-    auto wait(const iox::optional<Duration>& timeout = iox::nullopt)
-        -> iox::expected<std::vector<TriggeredWaitable>, ErrorType>;
+    /// @returns The number of triggered waitables.
+    auto wait(const iox::optional<Duration>& timeout = iox::nullopt) -> iox::expected<size_t, ErrorType>;
+
+    /// @brief Determine if the waitable mapped to the RMW index was triggered in the last wait call.
+    /// @param[in] waitable_type The type of waitable entity
+    /// @param[in] rmw_index The index used to track the entity in the RMW
+    /// @return True if the waitable was triggered, false otherwise
+    auto is_triggered(WaitableEntity waitable_type, RmwIndex rmw_index) const -> bool;
+
+    /// @brief Set the time for which the waitset polls the mapped entities for data before blocking.
+    /// @details While polling, the subscriber queues and guard condition flags are checked directly without involving
+    ///          the kernel, trading CPU time for wakeup latency. If nothing is detected within the budget, the waitset
+    ///          blocks for the remainder of the timeout. Defaults to the spin budget of the context.
+    /// @param[in] spin_budget The time to poll for, zero to block immediately
+    auto set_spin_budget(const Duration& spin_budget) -> void;
+
+    /// @brief Get the time for which the waitset polls the mapped entities for data before blocking.
+    /// @return The spin budget, zero if the waitset blocks immediately
+    auto spin_budget() const -> Duration;
+
+    /// @brief Set whether triggered subscribers are deferred in favor of those with higher priority.
+    /// @details Defaults to the prioritization of the context. Deferred subscribers keep their samples.
+    /// @param[in] prioritization True to only report the highest priorities, false to report all triggered entities
+    auto set_prioritization(bool prioritization) -> void;
+
+    /// @brief Check whether triggered subscribers are deferred in favor of those with higher priority.
+    /// @return True if only the highest priorities are reported
+    auto prioritization() const -> bool;
+
+    /// @brief Get the number of listeners currently held by the waitset.
+    /// @return The number of listeners, including those not currently mapped but not yet reclaimed
+    auto listener_count() const -> size_t;
 
 private:
-    /// @brief Gets the storage index of the listener for the provided service.
-    /// @details Creates a listener for the service if one does not exist in the storage.
+    /// @brief Block the thread until at least one attached entity is triggered or the timeout is reached.
+    /// @param timeout Optional timeout after which waiting is stopped
+    /// @returns The number of triggered waitables, regardless of their priority
+    auto wait_for_triggers(const iox::optional<Duration>& timeout) -> iox::expected<size_t, ErrorType>;
+
+    /// @brief Defer the triggered subscribers that do not have the highest priority among the triggered subscribers.
+    /// @details Subscribers already deferred in MAX_DEFERRALS consecutive calls are reported instead.
+    /// @param[in] triggered_count The number of triggered waitables
+    /// @return The number of triggered waitables that remain reported
+    auto defer_lower_priorities(size_t triggered_count) -> size_t;
+
+    /// @brief Gets the storage handle of the listener for the provided service.
+    /// @details Creates a listener for the service if one does not exist in the storage. Subscriber listeners are
+    ///          acquired from the listener registry of the context instead, sharing them with other waitsets.
+    /// @tparam ListenerType The type of listener (GuardConditionListener or SubscriberListener)
+    /// @param[in] service_name The service name to use for the iceoryx2 listener
+    /// @param[in] service_name_hash The hash of the service name, cached by the mapped entity
+    /// @return The handle to the listener in its specific storage
+    template <typename ListenerType>
+    auto get_storage_handle(const std::string& service_name, size_t service_name_hash)
+        -> iox::expected<StorageHandle, ErrorType>;
+
+    /// @brief Find the listener stored for the provided service.
+    /// @tparam ListenerType The type of listener (GuardConditionListener or SubscriberListener)
+    /// @param[in] service_name The service name of the listener
+    /// @param[in] service_name_hash The hash of the service name
+    /// @return The lookup entry of the listener, the end of the lookup if none is stored
+    template <typename ListenerType>
+    auto find_stored_listener(const std::string& service_name, size_t service_name_hash) -> StorageLookup::iterator;
+
+    /// @brief Creates or acquires the listener for the provided service.
     /// @tparam ListenerType The type of listener (GuardConditionListener or SubscriberListener)
     /// @param[in] The service name to use for the iceoryx2 listener
-    /// @return The index where the listener is stored in its specific storage
+    /// @return The listener
     template <typename ListenerType>
-    auto get_storage_index(const std::string& service_name) -> iox::expected<StorageIndex, ErrorType>;
+    auto create_listener(const std::string& service_name) -> iox::expected<ListenerType, ErrorType>;
 
-    /// @brief Get the listener at the given storage index.
+    /// @brief Get the listener referenced by the given storage handle.
     /// @tparam ListenerType The type of listener (GuardConditionListener or SubscriberListener)
-    /// @param[in] storage_index The index to retrieve the listener from
+    /// @param[in] storage_handle The handle to retrieve the listener for
     /// @details Listeners of different types are stored in different storages.
     ///
     /// This method retrieves the listener from the appropriate storage identified by the template argument.
     ///
-    /// @note The storage index is unique within each storage type and is used to identify listeners of the same type
-    /// @return Optional pointer to the listener details if found, nullopt otherwise
+    /// @note The storage handle is unique within each storage type and is used to identify listeners of the same type
+    /// @return Optional pointer to the listener details if found, nullopt if the handle is invalid or outdated
     template <typename ListenerType>
-    inline auto get_stored_listener(StorageIndex storage_index) -> iox::optional<ListenerDetails<ListenerType>*>;
+    inline auto get_stored_listener(const StorageHandle& storage_handle)
+        -> iox::optional<ListenerDetails<ListenerType>*>;
 
     /// @brief Maps a stored listener to an RMW index.
+    /// @details A listener mapped to multiple RMW indices in the same mapping round, e.g. for multiple subscribers to
+    ///          the same topic, is only attached once but reported for each of the indices.
+    /// @tparam ListenerType The type of listener (GuardConditionListener or SubscriberListener)
+    /// @tparam EntityType The type of the mapped entity (GuardCondition or Subscriber)
     /// @param[in] entity_type
-    /// @param[in] storage_index The index where associated listener is stored in its given storage
+    /// @param[in] storage_handle The handle to the associated listener in its given storage
     /// @param[in] rmw_index The index used by RMW to track attached entities.
-    auto map_stored_listener(WaitableEntity entity_type, StorageIndex storage_index, RmwIndex rmw_index) -> void;
+    /// @param[in] entity The mapped entity, its lifetime keeps the listener from being reclaimed
+    template <typename ListenerType, typename EntityType>
+    auto map_stored_listener(WaitableEntity entity_type,
+                             const StorageHandle& storage_handle,
+                             RmwIndex rmw_index,
+                             EntityType& entity) -> void;
 
     /// @brief Get the storage of a specific listener type.
     /// @details Each listener type has its own dedicated storage. This method returns a reference to the
     ///          corresponding storage based on the template parameter.
     /// @tparam ListenerType The type of listener to get storage for (GuardConditionListener or SubscriberListener)
-    /// @return Reference to the storage vector containing listeners of the specified type
+    /// @return Reference to the storage containing listeners of the specified type
     template <typename ListenerType>
-    inline auto listener_storage() -> std::vector<ListenerDetails<ListenerType>>&;
+    inline auto listener_storage() -> ListenerStorage<ListenerType>&;
+
+    /// @brief Get the trigger results of a specific waitable type.
+    /// @details Each waitable type has its own dedicated result storage, indexed by RMW index.
+    /// @param[in] waitable_type The type of waitable entity
+    /// @return Reference to the trigger results of the waitable type
+    auto triggered_storage(WaitableEntity waitable_type) -> std::vector<bool>&;
+
+    /// @brief Clear the trigger results of all waitable types without releasing their memory.
+    auto clear_triggered() -> void;
 
     /// @brief Determine if provided timeout exists AND is zero
     /// @return True if timeout provided but it is zero i.e. process events without waiting
@@ -228,74 +431,201 @@ private:
     /// @return True if timeout is a nullopt i.e. wait indefinitely
     auto no_timeout(const iox::optional<Duration>& timeout) const -> bool;
 
-    /// @brief Attach a timeout to the waitset.
-    /// @details Creates an interval attachment to the waitset that will trigger after the specified duration
-    /// @param[in] timeout The duration after which the timeout should trigger
-    /// @param[out] ctx The context for the given wait call where the timeout attachment will be stored
-    /// @return Success if the timeout was attached, error otherwise
-    auto attach_timeout(const Duration& timeout, WaitContext& ctx) -> ::iox::expected<void, ErrorType>;
-
-    /// @brief Attach all mapped listeners to the waitset.
-    /// @details For each mapped listener, creates a notification attachment to the waitset and stores the details.
-    ///          If any attachment fails, returns an error immediately. Waiting should not proceed in this case.
-    /// @param[out] ctx The context for the given wait call where the notification attachment will be stored
-    /// @return Success if all listeners were attached, error otherwise
-    auto attach_mapped_listeners(WaitContext& ctx) -> iox::expected<void, ErrorType>;
-
-    /// @brief Attach a mapped listener to the waitset.
-    /// @details Creates a notification attachment to the waitset for the given mapping. The mapping must reference
-    ///          a valid listener in storage.
+    /// @brief Poll the mapped entities until data is detected or the budget is exhausted.
+    /// @param[in] budget The maximum time to poll for
+    /// @return The number of triggered waitables
+    auto spin(const Duration& budget) -> size_t;
+
+    /// @brief Poll all mapped entities once, recording the triggered ones.
+    /// @details The events of triggered guard conditions are drained so that they are not reported again by a
+    ///          subsequent blocking wait. Events of subscribers are drained once they are triggered.
+    /// @return The number of triggered waitables
+    auto poll_mapped() -> size_t;
+
+    /// @brief Poll a mapped entity without blocking.
+    /// @details Triggers of guard conditions are consumed by polling, thus reported once.
+    /// @param[in] mapping The mapping of the entity to poll
+    /// @return True if the entity has data available, i.e. a subscriber holds samples or a guard condition was
+    ///         triggered
+    auto poll(const RmwMapping& mapping) -> bool;
+
+    /// @brief Record a triggered waitable in the result of the current wait call.
+    /// @details Only records the result, triggers of guard conditions are consumed by whoever detected them.
+    /// @param[in] mapping The mapping of the triggered entity
+    auto record_trigger(const RmwMapping& mapping) -> void;
+
+    /// @brief Get the time remaining until the deadline.
+    /// @param[in] deadline The deadline of the current wait call
+    /// @return The remaining time, zero if the deadline has passed
+    auto time_until(const Deadline& deadline) const -> Duration;
+
+    /// @brief Update the waitset attachments to reflect the current mapping.
+    /// @details Mapped listeners that are not yet attached are attached to the waitset. Attached listeners that are
+    ///          no longer mapped are detached and reclaimed if all of their owners are destroyed. If any attachment
+    ///          fails, returns an error immediately. Waiting should not proceed in this case.
+    /// @return Success if all mapped listeners are attached, error otherwise
+    auto update_attachments() -> iox::expected<void, ErrorType>;
+
+    /// @brief Attach a mapped listener to the waitset, if not already attached.
+    /// @details The mapping must reference a valid listener in storage.
     /// @param[in] mapping The mapping containing details about the listener to attach
-    /// @return Success with the attachment details if successful, error otherwise
-    auto attach_mapped_listener(const RmwMapping& mapping) -> iox::expected<AttachmentDetails, ErrorType>;
+    /// @return Success if the listener is attached, error otherwise
+    auto attach_mapped_listener(const RmwMapping& mapping) -> iox::expected<void, ErrorType>;
 
-    /// @brief Attach a mapped listener of a specific type to the waitset.
-    /// @details Creates a notification attachment to the waitset for the given mapping. The mapping must reference
-    ///          a valid listener in storage.
+    /// @brief Attach a mapped listener of a specific type to the waitset, if not already attached.
     /// @tparam ListenerType The type of listener (GuardConditionListener or SubscriberListener)
     /// @param[in] mapping The mapping containing details about the listener to attach
-    /// @return Success with the attachment details if successful, error otherwise
+    /// @return Success if the listener is attached, error otherwise
+    template <typename ListenerType>
+    auto attach_mapped_listener_impl(const RmwMapping& mapping) -> iox::expected<void, ErrorType>;
+
+    /// @brief Rebuild the index from attachment IDs to the mappings of the attached listeners.
+    /// @note Only to be called once all mapped listeners are attached, the index is valid until the mapping or the
+    ///       attachments change
+    auto index_attachments() -> void;
+
+    /// @brief Find the mappings of the listener attached with the given attachment ID.
+    /// @param[in] id The attachment ID reported by the waitset
+    /// @return The range of index entries referencing the mappings, empty if the attachment is not mapped
+    auto find_mappings(const AttachmentId& id) const
+        -> std::pair<TriggerIndex::const_iterator, TriggerIndex::const_iterator>;
+
+    /// @brief Detach all listeners of a specific type that were not mapped in the current mapping round.
+    /// @details Listeners whose owners are all destroyed are reclaimed, releasing their iceoryx2 resources. All others
+    ///          remain in the storage for re-use in subsequent calls.
+    /// @tparam ListenerType The type of listener (GuardConditionListener or SubscriberListener)
+    template <typename ListenerType>
+    auto release_unmapped_listeners() -> void;
+
+    /// @brief Get the attachment of the listener referenced by the mapping.
+    /// @param[in] mapping The mapping containing details about the listener
+    /// @return Pointer to the attachment, nullptr if the listener is not attached
+    auto attachment_of(const RmwMapping& mapping) -> const AttachmentDetails*;
+
+    /// @brief Get the attachment of the listener of a specific type.
+    /// @tparam ListenerType The type of listener (GuardConditionListener or SubscriberListener)
+    /// @param[in] storage_handle The handle to the listener in its given storage
+    /// @return Pointer to the attachment, nullptr if the listener is not attached
     template <typename ListenerType>
-    auto attach_mapped_listener_impl(const RmwMapping& mapping) -> iox::expected<AttachmentDetails, ErrorType>;
+    auto attachment_of_impl(const StorageHandle& storage_handle) -> const AttachmentDetails*;
 
     /// @brief Process a triggered waitable entity
     /// @details Processes a triggered waitable entity by consuming the events from the associated listener
     /// @param[in] waitable_type The type of waitable entity that was triggered
-    /// @param[in] storage_index The index where the triggered entity's listener is stored
+    /// @param[in] storage_handle The handle to the triggered entity's listener in its given storage
     /// @return Success if all events were consumed successfully, error otherwise
     auto process_trigger(const WaitableEntity waitable_type,
-                         const StorageIndex storage_index) -> iox::expected<void, ErrorType>;
+                         const StorageHandle& storage_handle) -> iox::expected<void, ErrorType>;
 
 private:
     Context& m_context;
     iox::optional<IceoryxWaitSet> m_waitset;
 
+    // Allows the listener registry to wake up the waitset on events of the mapped subscribers.
+    // Declared before the listeners so that it outlives their registration with the listener registry.
+    iox::optional<Waker> m_waker;
+    iox::optional<AttachmentDetails> m_waker_attachment;
+
     // Storage for all attached listeners.
-    // Listeners for entities are created on first mapping, and re-used in subsequent calls.
-    // WARNING: Listeners must not be removed once added to the storage as this invalidates held storage indicies.
-    // TODO: A less error-prone solution. This is the quickest "dumb" implementation to get things working.
-    std::vector<ListenerDetails<GuardConditionListener>> m_guard_condition_listeners;
-    std::vector<ListenerDetails<SubscriberListener>> m_subscriber_listeners;
+    // Listeners for entities are created on first mapping, re-used in subsequent calls and reclaimed once the
+    // entities are destroyed.
+    // Declared after the waitset so that all attachments are detached before the waitset is destroyed.
+    ListenerStorage<GuardConditionListener> m_guard_condition_listeners;
+    ListenerStorage<SubscriberListener> m_subscriber_listeners;
 
     // Listeners staged to be waited on in the next wait call.
     // Maps the attachment to the index used in the RMW for tracking.
     std::vector<RmwMapping> m_mapping;
+
+    // Index from the attachment IDs to the mappings, sorted by attachment ID.
+    // Rebuilt when the attachments are updated before blocking, so that triggers are mapped back in logarithmic time.
+    TriggerIndex m_trigger_index;
+
+    // Results of the last wait call, indexed by RMW index.
+    // Grown when mapping so that the results can be written without allocating.
+    std::vector<bool> m_triggered_guard_conditions;
+    std::vector<bool> m_triggered_subscribers;
+
+    // Consecutive deferrals of the subscribers by priority, indexed by RMW index.
+    // Grown when mapping, like the results.
+    std::vector<DeferralCount> m_deferrals;
+
+    // Time for which the mapped entities are polled before blocking.
+    Duration m_spin_budget;
+
+    // Whether triggered subscribers are deferred in favor of those with higher priority.
+    bool m_prioritization;
+
+    // Incremented on every unmap_all() to identify the listeners mapped since.
+    // Starts ahead of the listeners so that newly stored listeners are not considered mapped.
+    MappingRound m_mapping_round{1};
 };
 
 // ===================================================================================================================
 
 template <typename ListenerType>
-auto WaitSet::get_storage_index(const std::string& service_name) -> iox::expected<StorageIndex, ErrorType> {
+auto WaitSet::get_storage_handle(const std::string& service_name, size_t service_name_hash)
+    -> iox::expected<StorageHandle, ErrorType> {
     using ::iox::err;
     using ::iox::ok;
 
     auto& storage = listener_storage<ListenerType>();
 
-    auto it = std::find_if(storage.begin(), storage.end(), [&service_name](const auto& listener) {
-        return listener.service_name == service_name;
-    });
+    if (auto it = find_stored_listener<ListenerType>(service_name, service_name_hash); it != storage.lookup.end()) {
+        // An iceoryx2 listener already exists. Reuse it.
+        auto storage_index = it->second;
+        return ok(StorageHandle{storage_index, storage.slots[storage_index].generation});
+    }
+
+    auto listener = create_listener<ListenerType>(service_name);
+    if (listener.has_error()) {
+        return err(listener.error());
+    }
+
+    // Re-use a reclaimed slot if available
+    StorageIndex storage_index{0};
+    if (storage.free_slots.empty()) {
+        storage_index = static_cast<StorageIndex>(storage.slots.size());
+        storage.slots.emplace_back();
+    } else {
+        storage_index = storage.free_slots.back();
+        storage.free_slots.pop_back();
+    }
+
+    auto& slot = storage.slots[storage_index];
+    slot.details.emplace(ListenerDetails<ListenerType>{service_name, service_name_hash, std::move(listener.value())});
+    storage.lookup.emplace(service_name_hash, storage_index);
+    return ok(StorageHandle{storage_index, slot.generation});
+}
+
+template <typename ListenerType>
+auto WaitSet::find_stored_listener(const std::string& service_name, size_t service_name_hash)
+    -> StorageLookup::iterator {
+    auto& storage = listener_storage<ListenerType>();
+
+    // Only compares the service names of listeners with the same hash, usually at most one
+    auto [first, last] = storage.lookup.equal_range(service_name_hash);
+    for (auto it = first; it != last; ++it) {
+        if (storage.slots[it->second].details->service_name == service_name) {
+            return it;
+        }
+    }
+    return storage.lookup.end();
+}
 
-    if (it == storage.end()) {
+template <typename ListenerType>
+auto WaitSet::create_listener(const std::string& service_name) -> iox::expected<ListenerType, ErrorType> {
+    using ::iox::err;
+    using ::iox::ok;
+
+    if constexpr (std::is_same_v<ListenerType, SubscriberListener>) {
+        auto listener = m_context.listener_registry().acquire(service_name, m_waker.value());
+        if (listener.has_error()) {
+            RMW_IOX2_CHAIN_ERROR_MSG("failed to acquire shared listener");
+            return err(ErrorType::LISTENER_CREATION_FAILURE);
+        }
+        return ok(std::move(listener.value()));
+    } else {
         auto service_result =
             m_context.iox2().service_builder<ServiceType<ListenerType>>(service_name).event().open_or_create();
         if (service_result.has_error()) {
@@ -309,29 +639,66 @@ auto WaitSet::get_storage_index(const std::string& service_name) -> iox::expecte
             RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(listener.error()));
             return err(ErrorType::LISTENER_CREATION_FAILURE);
         }
-
-        storage.emplace_back(ListenerDetails<ListenerType>{service_name, std::move(listener.value())});
-        auto storage_index = static_cast<StorageIndex>(storage.size() - 1);
-        return ok(storage_index);
-    } else {
-        // An iceoryx2 listener already exists. Reuse it and mark it for attachment.
-        auto storage_index = static_cast<StorageIndex>(it - storage.begin());
-        return ok(storage_index);
+        return ok(std::move(listener.value()));
     }
 }
 
 template <typename ListenerType>
-auto WaitSet::get_stored_listener(StorageIndex storage_index) -> iox::optional<ListenerDetails<ListenerType>*> {
+auto WaitSet::get_stored_listener(const StorageHandle& storage_handle)
+    -> iox::optional<ListenerDetails<ListenerType>*> {
     auto& storage = listener_storage<ListenerType>();
 
-    if (storage_index < storage.size()) {
-        return &storage[storage_index];
+    if (storage_handle.index < storage.slots.size()) {
+        auto& slot = storage.slots[storage_handle.index];
+        if (slot.generation == storage_handle.generation && slot.details.has_value()) {
+            return &slot.details.value();
+        }
     }
     return iox::nullopt;
 }
 
+template <typename ListenerType, typename EntityType>
+auto WaitSet::map_stored_listener(WaitableEntity waitable_type,
+                                  const StorageHandle& storage_handle,
+                                  RmwIndex rmw_index,
+                                  EntityType& entity) -> void {
+    // Ensure the result for this index can be recorded without allocating while waiting
+    auto& triggered = triggered_storage(waitable_type);
+    if (triggered.size() <= rmw_index) {
+        triggered.resize(rmw_index + 1, false);
+    }
+    if (waitable_type == WaitableEntity::SUBSCRIBER) {
+        if (m_deferrals.size() <= rmw_index) {
+            m_deferrals.resize(rmw_index + 1, DeferralCount{nullptr, 0});
+        }
+        if (auto& deferral = m_deferrals[rmw_index]; deferral.entity != &entity) {
+            deferral = DeferralCount{&entity, 0};
+        }
+    }
+
+    if (auto result = get_stored_listener<ListenerType>(storage_handle); result.has_value()) {
+        auto& listener_details = result.value();
+
+        // Track the lifetime of the entity to know when the listener can be reclaimed. Observers of destroyed entities
+        // are pruned here as well, as a listener that remains mapped is never released while entities sharing it come
+        // and go.
+        const auto& owner = entity.lifetime();
+        auto& owners = listener_details->owners;
+        auto expired = [](const auto& observer) { return observer.expired(); };
+        owners.erase(std::remove_if(owners.begin(), owners.end(), expired), owners.end());
+        if (std::none_of(owners.begin(), owners.end(), [&owner](const auto& observer) {
+                return observer.observes(owner);
+            })) {
+            owners.push_back(owner.observe());
+        }
+
+        listener_details->mapped_in_round = m_mapping_round;
+        m_mapping.push_back(RmwMapping{waitable_type, storage_handle, rmw_index, &entity});
+    }
+}
+
 template <typename ListenerType>
-inline auto WaitSet::listener_storage() -> std::vector<ListenerDetails<ListenerType>>& {
+inline auto WaitSet::listener_storage() -> ListenerStorage<ListenerType>& {
     if constexpr (std::is_same_v<ListenerType, GuardConditionListener>) {
         return m_guard_condition_listeners;
     } else if constexpr (std::is_same_v<ListenerType, SubscriberListener>) {
@@ -342,23 +709,78 @@ inline auto WaitSet::listener_storage() -> std::vector<ListenerDetails<ListenerT
 }
 
 template <typename ListenerType>
-auto WaitSet::attach_mapped_listener_impl(const RmwMapping& mapping) -> iox::expected<AttachmentDetails, ErrorType> {
+auto WaitSet::attach_mapped_listener_impl(const RmwMapping& mapping) -> iox::expected<void, ErrorType> {
     using ::iox::err;
     using ::iox::ok;
 
-    if (auto result = get_stored_listener<ListenerType>(mapping.storage_index); result.has_value()) {
+    if (auto result = get_stored_listener<ListenerType>(mapping.storage_handle); result.has_value()) {
         auto& listener_details = result.value();
-        auto guard = m_waitset->attach_notification(listener_details->listener.file_descriptor());
-        if (guard.has_error()) {
-            RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(guard.error()));
-            return err(ErrorType::ATTACHMENT_FAILURE);
+        auto file_descriptor = [&listener_details]() {
+            if constexpr (std::is_same_v<ListenerType, SubscriberListener>) {
+                return listener_details->listener.listener().file_descriptor();
+            } else {
+                return listener_details->listener.file_descriptor();
+            }
+        };
+        if constexpr (std::is_same_v<ListenerType, SubscriberListener>) {
+            if (!listener_details->listener.exclusive()) {
+                // Shared with other waitsets, thus attached to the waitset of the listener registry instead, which
+                // wakes up this waitset via its waker
+                listener_details->attachment.reset();
+                return ok();
+            }
+        }
+        if (!listener_details->attachment.has_value()) {
+            auto guard = m_waitset->attach_notification(file_descriptor());
+            if (guard.has_error()) {
+                RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(guard.error()));
+                return err(ErrorType::ATTACHMENT_FAILURE);
+            }
+            listener_details->attachment.emplace(std::move(guard.value()));
         }
-        return ok(AttachmentDetails(std::move(guard.value()), mapping));
+        return ok();
     }
     RMW_IOX2_CHAIN_ERROR_MSG("mapped listener not found in listener storage");
     return err(ErrorType::INVALID_STORAGE_INDEX);
 }
 
+template <typename ListenerType>
+auto WaitSet::release_unmapped_listeners() -> void {
+    auto& storage = listener_storage<ListenerType>();
+
+    for (StorageIndex storage_index = 0; storage_index < storage.slots.size(); storage_index++) {
+        auto& slot = storage.slots[storage_index];
+        if (!slot.details.has_value() || slot.details->mapped_in_round == m_mapping_round) {
+            continue;
+        }
+        auto& listener_details = slot.details.value();
+
+        // Destroying the guard detaches the listener from the waitset
+        listener_details.attachment.reset();
+
+        auto& owners = listener_details.owners;
+        owners.erase(std::remove_if(owners.begin(), owners.end(), [](const auto& owner) { return owner.expired(); }),
+                     owners.end());
+        if (owners.empty()) {
+            // All entities using the listener are destroyed, release the listener and its port
+            storage.lookup.erase(
+                find_stored_listener<ListenerType>(listener_details.service_name, listener_details.service_name_hash));
+            slot.details.reset();
+            slot.generation++;
+            storage.free_slots.push_back(storage_index);
+        }
+    }
+}
+
+template <typename ListenerType>
+auto WaitSet::attachment_of_impl(const StorageHandle& storage_handle) -> const AttachmentDetails* {
+    if (auto result = get_stored_listener<ListenerType>(storage_handle); result.has_value()) {
+        auto& attachment = result.value()->attachment;
+        return attachment.has_value() ? &attachment.value() : nullptr;
+    }
+    return nullptr;
+}
+
 } // namespace rmw::iox2
 
 #endif
@@ -0,0 +1,55 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#ifndef RMW_IOX2_LOAN_STATISTICS_HPP_
+#define RMW_IOX2_LOAN_STATISTICS_HPP_
+
+#include "rmw/ret_types.h"
+#include "rmw/types.h"
+#include "rmw/visibility_control.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+extern "C" {
+
+/// @brief Statistics of the messages loaned from a publisher or subscription
+/// @details Allows detecting loans that are never returned before the loans are exhausted, at which point
+///          publishers fail to loan and subscriptions fail to take loaned messages.
+typedef struct rmw_iox2_loan_statistics_s
+{
+    /// The maximum number of loans that can be held at once
+    size_t capacity;
+    /// The number of loans currently held
+    size_t outstanding;
+    /// The largest number of loans held at once since creation
+    size_t high_water_mark;
+    /// How long the oldest loan currently held has been held for in nanoseconds, zero if no loans are held
+    int64_t oldest_loan_age_ns;
+} rmw_iox2_loan_statistics_t;
+
+/// @brief Get the statistics of the messages loaned from a publisher
+/// @param[in] rmw_publisher The publisher
+/// @param[out] statistics The statistics, filled on success
+/// @return RMW_RET_OK on success, RMW_RET_INVALID_ARGUMENT or RMW_RET_INCORRECT_RMW_IMPLEMENTATION otherwise
+RMW_PUBLIC
+rmw_ret_t rmw_iox2_publisher_get_loan_statistics(const rmw_publisher_t* rmw_publisher,
+                                                 rmw_iox2_loan_statistics_t* statistics);
+
+/// @brief Get the statistics of the messages loaned from a subscription
+/// @param[in] rmw_subscription The subscription
+/// @param[out] statistics The statistics, filled on success
+/// @return RMW_RET_OK on success, RMW_RET_INVALID_ARGUMENT or RMW_RET_INCORRECT_RMW_IMPLEMENTATION otherwise
+RMW_PUBLIC
+rmw_ret_t rmw_iox2_subscription_get_loan_statistics(const rmw_subscription_t* rmw_subscription,
+                                                    rmw_iox2_loan_statistics_t* statistics);
+
+} // extern "C"
+
+#endif // RMW_IOX2_LOAN_STATISTICS_HPP_
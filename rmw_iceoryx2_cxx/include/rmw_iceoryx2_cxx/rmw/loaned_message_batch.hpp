@@ -0,0 +1,51 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#ifndef RMW_IOX2_LOANED_MESSAGE_BATCH_HPP_
+#define RMW_IOX2_LOANED_MESSAGE_BATCH_HPP_
+
+#include "rmw/ret_types.h"
+#include "rmw/types.h"
+#include "rmw/visibility_control.h"
+
+#include <stddef.h>
+
+extern "C" {
+
+/// @brief Take all pending messages of a subscription as loans, up to the given count
+/// @details Intended for consumers processing several messages at once, e.g. all pending camera frames in parallel.
+///          At most as many messages are taken as the subscription can still loan, see
+///          rmw_iox2_subscription_get_loan_statistics. Only supported for self-contained messages.
+/// @param[in] rmw_subscription The subscription
+/// @param[in] count The maximum number of messages to take
+/// @param[out] loaned_messages Storage for at least count pointers, filled with the loaned messages from the start
+/// @param[out] taken The number of messages taken
+/// @return RMW_RET_OK on success, also if no messages were taken, RMW_RET_INVALID_ARGUMENT,
+///         RMW_RET_INCORRECT_RMW_IMPLEMENTATION, RMW_RET_UNSUPPORTED or RMW_RET_ERROR otherwise
+RMW_PUBLIC
+rmw_ret_t rmw_iox2_take_loaned_messages(const rmw_subscription_t* rmw_subscription,
+                                        size_t count,
+                                        void** loaned_messages,
+                                        size_t* taken);
+
+/// @brief Return multiple messages loaned from a subscription at once
+/// @details Valid loans are returned even if others are invalid.
+/// @param[in] rmw_subscription The subscription the messages were loaned from
+/// @param[in] loaned_messages The loaned messages to return
+/// @param[in] count The number of messages
+/// @return RMW_RET_OK on success, RMW_RET_INVALID_ARGUMENT, RMW_RET_INCORRECT_RMW_IMPLEMENTATION, RMW_RET_UNSUPPORTED
+///         or RMW_RET_ERROR otherwise
+RMW_PUBLIC
+rmw_ret_t rmw_iox2_return_loaned_messages_from_subscription(const rmw_subscription_t* rmw_subscription,
+                                                            void* const* loaned_messages,
+                                                            size_t count);
+
+} // extern "C"
+
+#endif // RMW_IOX2_LOANED_MESSAGE_BATCH_HPP_
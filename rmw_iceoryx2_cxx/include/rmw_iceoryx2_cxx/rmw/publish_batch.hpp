@@ -0,0 +1,35 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#ifndef RMW_IOX2_PUBLISH_BATCH_HPP_
+#define RMW_IOX2_PUBLISH_BATCH_HPP_
+
+#include "rmw/ret_types.h"
+#include "rmw/types.h"
+#include "rmw/visibility_control.h"
+
+#include <stddef.h>
+
+extern "C" {
+
+/// @brief Publish multiple messages, notifying subscribers once instead of once per message
+/// @details Intended for bursts of messages, e.g. the packets of one revolution of a lidar. Subscribers are woken up
+///          once for the whole batch. Messages published before a failure remain published.
+/// @param[in] rmw_publisher The publisher
+/// @param[in] ros_messages Pointers to the messages to publish, in order
+/// @param[in] count The number of messages
+/// @return RMW_RET_OK on success, RMW_RET_INVALID_ARGUMENT, RMW_RET_INCORRECT_RMW_IMPLEMENTATION or RMW_RET_ERROR
+///         otherwise
+RMW_PUBLIC
+rmw_ret_t
+rmw_iox2_publish_batch(const rmw_publisher_t* rmw_publisher, const void* const* ros_messages, size_t count);
+
+} // extern "C"
+
+#endif // RMW_IOX2_PUBLISH_BATCH_HPP_
@@ -0,0 +1,44 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#ifndef RMW_IOX2_SEGMENT_STATISTICS_HPP_
+#define RMW_IOX2_SEGMENT_STATISTICS_HPP_
+
+#include "rmw/ret_types.h"
+#include "rmw/types.h"
+#include "rmw/visibility_control.h"
+
+#include <stdint.h>
+
+extern "C" {
+
+/// @brief Statistics of the shared memory segment a publisher loans payloads from
+/// @details Payloads of serialized messages vary in size. The segment grows to the next power of two when a payload
+///          does not fit, frequent growth indicates the topic should start out with larger payloads.
+typedef struct rmw_iox2_segment_statistics_s
+{
+    /// The largest payload in bytes the segment can currently provide without growing
+    uint64_t max_slice_len;
+    /// The largest payload in bytes loaned since creation
+    uint64_t payload_high_water_mark;
+    /// The number of times the segment grew to provide a larger payload
+    uint64_t resizes;
+} rmw_iox2_segment_statistics_t;
+
+/// @brief Get the statistics of the payload segment of a publisher
+/// @param[in] rmw_publisher The publisher
+/// @param[out] statistics The statistics, filled on success
+/// @return RMW_RET_OK on success, RMW_RET_INVALID_ARGUMENT or RMW_RET_INCORRECT_RMW_IMPLEMENTATION otherwise
+RMW_PUBLIC
+rmw_ret_t rmw_iox2_publisher_get_segment_statistics(const rmw_publisher_t* rmw_publisher,
+                                                    rmw_iox2_segment_statistics_t* statistics);
+
+} // extern "C"
+
+#endif // RMW_IOX2_SEGMENT_STATISTICS_HPP_
@@ -0,0 +1,45 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#ifndef RMW_IOX2_SUBSCRIPTION_OPTIONS_HPP_
+#define RMW_IOX2_SUBSCRIPTION_OPTIONS_HPP_
+
+#include "rmw/visibility_control.h"
+
+#include <stdint.h>
+
+extern "C" {
+
+/// Identifies a payload as rmw_iox2_subscription_options_t, payloads not starting with it are ignored
+#define RMW_IOX2_SUBSCRIPTION_OPTIONS_MAGIC 0x494f5832u
+
+/// @brief Subscription options specific to rmw_iceoryx2_cxx
+/// @details Passed to rmw_create_subscription() via rmw_subscription_options_t::rmw_specific_subscription_payload.
+///          The options are copied during creation. To be initialized via
+///          rmw_iox2_get_default_subscription_options(), payloads with a different magic are ignored.
+typedef struct rmw_iox2_subscription_options_s
+{
+    /// Must be RMW_IOX2_SUBSCRIPTION_OPTIONS_MAGIC
+    uint32_t magic;
+    /// Priority of the subscription in wait results. Only applies to waitsets with prioritization enabled via the
+    /// RMW_IOX2_WAITSET_PRIORITIZATION environment variable. When subscriptions of different priorities are triggered
+    /// in the same wait, only those with the highest priority are reported. The others are reported by subsequent
+    /// waits, at the latest after being deferred in four consecutive waits.
+    /// Higher values take precedence. Overrides the priority configured for the topic, which is 0 by default.
+    uint8_t priority;
+} rmw_iox2_subscription_options_t;
+
+/// @brief Get subscription options with the magic set and all options at their defaults
+/// @return The default options
+RMW_PUBLIC
+rmw_iox2_subscription_options_t rmw_iox2_get_default_subscription_options(void);
+
+} // extern "C"
+
+#endif // RMW_IOX2_SUBSCRIPTION_OPTIONS_HPP_
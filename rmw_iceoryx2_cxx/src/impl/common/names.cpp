@@ -31,6 +31,10 @@ std::string guard_condition(const uint32_t context_id, const uint32_t guard_cond
     return "ros2://context/" + std::to_string(context_id) + "/guard_conditions/" + std::to_string(guard_condition_id);
 }
 
+std::string waitset(const uint32_t context_id, const uint32_t waitset_id) {
+    return "ros2://context/" + std::to_string(context_id) + "/waitsets/" + std::to_string(waitset_id);
+}
+
 std::string topic(const char* topic) {
     auto s = "ros2://topics" + std::string(topic);
     return s;
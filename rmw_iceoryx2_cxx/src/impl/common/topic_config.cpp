@@ -0,0 +1,241 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#include "rmw_iceoryx2_cxx/impl/common/topic_config.hpp"
+
+#include "iox/optional.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/error_message.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace rmw::iox2
+{
+
+namespace
+{
+
+constexpr const char* DEFAULTS_TABLE{"defaults"};
+constexpr const char* TOPICS_TABLE_PREFIX{"topics."};
+
+/// A key-value pair read from the configuration, retained until all tables are known
+struct Assignment
+{
+    std::string key;
+    uint64_t value;
+    size_t line_number;
+};
+
+using Assignments = std::vector<Assignment>;
+
+auto trim(const std::string& text) -> std::string {
+    constexpr const char* WHITESPACE{" \t\r"};
+    auto begin = text.find_first_not_of(WHITESPACE);
+    if (begin == std::string::npos) {
+        return {};
+    }
+    auto end = text.find_last_not_of(WHITESPACE);
+    return text.substr(begin, end - begin + 1);
+}
+
+auto strip_comment(const std::string& line) -> std::string {
+    bool quoted{false};
+    for (size_t index = 0; index < line.size(); index++) {
+        if (line[index] == '"') {
+            quoted = !quoted;
+        } else if (line[index] == '#' && !quoted) {
+            return line.substr(0, index);
+        }
+    }
+    return line;
+}
+
+auto parse_value(const std::string& text) -> iox::optional<uint64_t> {
+    // Booleans are handled as integers, validated against the range of the setting
+    if (text == "true") {
+        return 1U;
+    }
+    if (text == "false") {
+        return 0U;
+    }
+    if (text.empty() || text.front() == '-' || text.front() == '+') {
+        return iox::nullopt;
+    }
+    char* end{nullptr};
+    errno = 0;
+    auto number = std::strtoull(text.c_str(), &end, 10);
+    if (*end != '\0' || errno == ERANGE) {
+        return iox::nullopt;
+    }
+    return static_cast<uint64_t>(number);
+}
+
+auto apply(TopicSettings& settings, const Assignment& assignment) -> iox::expected<void, TopicConfigError> {
+    using ::iox::err;
+    using ::iox::ok;
+
+    auto set = [&assignment](auto& setting, uint64_t min, uint64_t max) -> iox::expected<void, TopicConfigError> {
+        if (assignment.value < min || assignment.value > max) {
+            RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING("line %zu: value of '%s' must be in range [%llu, %llu]",
+                                                        assignment.line_number,
+                                                        assignment.key.c_str(),
+                                                        static_cast<unsigned long long>(min),
+                                                        static_cast<unsigned long long>(max));
+            return err(TopicConfigError::INVALID_VALUE);
+        }
+        setting = static_cast<std::remove_reference_t<decltype(setting)>>(assignment.value);
+        return ok();
+    };
+
+    if (assignment.key == "max_publishers") {
+        return set(settings.max_publishers, 1, TopicSettings::MAX_PORTS);
+    }
+    if (assignment.key == "max_subscribers") {
+        return set(settings.max_subscribers, 1, TopicSettings::MAX_PORTS);
+    }
+    if (assignment.key == "history_size") {
+        return set(settings.history_size, 0, TopicSettings::MAX_QUEUED_SAMPLES);
+    }
+    if (assignment.key == "subscriber_max_buffer_size") {
+        return set(settings.subscriber_max_buffer_size, 1, TopicSettings::MAX_QUEUED_SAMPLES);
+    }
+    if (assignment.key == "subscriber_max_borrowed_samples") {
+        return set(settings.subscriber_max_borrowed_samples, 0, TopicSettings::MAX_QUEUED_SAMPLES);
+    }
+    if (assignment.key == "max_loaned_samples") {
+        return set(settings.max_loaned_samples, 1, TopicSettings::MAX_LOANED_SAMPLES);
+    }
+    if (assignment.key == "safe_overflow") {
+        return set(settings.safe_overflow, 0, 1);
+    }
+    if (assignment.key == "coalesce_notifications") {
+        return set(settings.coalesce_notifications, 0, 1);
+    }
+    if (assignment.key == "suppress_idle_notifications") {
+        return set(settings.suppress_idle_notifications, 0, 1);
+    }
+    if (assignment.key == "keep_latest") {
+        return set(settings.keep_latest, 0, 1);
+    }
+    if (assignment.key == "priority") {
+        return set(settings.priority, 0, std::numeric_limits<uint8_t>::max());
+    }
+
+    RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING(
+        "line %zu: unknown key '%s'", assignment.line_number, assignment.key.c_str());
+    return err(TopicConfigError::UNKNOWN_KEY);
+}
+
+auto apply(TopicSettings& settings, const Assignments& assignments) -> iox::expected<void, TopicConfigError> {
+    for (const auto& assignment : assignments) {
+        if (auto result = apply(settings, assignment); result.has_error()) {
+            return result;
+        }
+    }
+    return iox::ok();
+}
+
+} // namespace
+
+auto TopicConfig::from_file(const std::string& path) -> iox::expected<TopicConfig, ErrorType> {
+    using ::iox::err;
+
+    std::ifstream file{path};
+    if (!file.is_open()) {
+        RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING("failed to open topic configuration '%s'", path.c_str());
+        return err(ErrorType::FILE_ACCESS_FAILURE);
+    }
+    return parse(file);
+}
+
+auto TopicConfig::parse(std::istream& input) -> iox::expected<TopicConfig, ErrorType> {
+    using ::iox::err;
+    using ::iox::ok;
+
+    Assignments defaults;
+    std::unordered_map<std::string, Assignments> topics;
+    Assignments* table{nullptr};
+
+    std::string line;
+    size_t line_number{0};
+    while (std::getline(input, line)) {
+        line_number++;
+        auto content = trim(strip_comment(line));
+        if (content.empty()) {
+            continue;
+        }
+
+        // Table header
+        if (content.front() == '[') {
+            if (content.back() != ']') {
+                RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING("line %zu: unterminated table header", line_number);
+                return err(ErrorType::INVALID_SYNTAX);
+            }
+            auto name = trim(content.substr(1, content.size() - 2));
+            if (name == DEFAULTS_TABLE) {
+                table = &defaults;
+                continue;
+            }
+            if (name.rfind(TOPICS_TABLE_PREFIX, 0) == 0) {
+                auto topic = trim(name.substr(std::strlen(TOPICS_TABLE_PREFIX)));
+                if (topic.size() > 2 && topic.front() == '"' && topic.back() == '"') {
+                    // References to elements of unordered_map remain valid when inserting further elements
+                    table = &topics[topic.substr(1, topic.size() - 2)];
+                    continue;
+                }
+            }
+            RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING("line %zu: unknown table '%s'", line_number, name.c_str());
+            return err(ErrorType::UNKNOWN_TABLE);
+        }
+
+        // Key-value pair
+        auto separator = content.find('=');
+        if (separator == std::string::npos || table == nullptr) {
+            RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING("line %zu: expected a table header or key-value pair",
+                                                        line_number);
+            return err(ErrorType::INVALID_SYNTAX);
+        }
+        auto key = trim(content.substr(0, separator));
+        auto value = parse_value(trim(content.substr(separator + 1)));
+        if (!value.has_value()) {
+            RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING(
+                "line %zu: value of '%s' must be an unsigned integer or boolean", line_number, key.c_str());
+            return err(ErrorType::INVALID_VALUE);
+        }
+        table->push_back(Assignment{key, value.value(), line_number});
+    }
+
+    // Topics inherit the defaults, regardless of where the defaults are placed in the file
+    TopicConfig config;
+    if (auto result = apply(config.m_defaults, defaults); result.has_error()) {
+        return err(result.error());
+    }
+    for (const auto& [topic, assignments] : topics) {
+        auto settings = config.m_defaults;
+        if (auto result = apply(settings, assignments); result.has_error()) {
+            return err(result.error());
+        }
+        config.m_topics.emplace(topic, settings);
+    }
+    return ok(std::move(config));
+}
+
+auto TopicConfig::settings(const std::string& topic) const -> const TopicSettings& {
+    if (auto it = m_topics.find(topic); it != m_topics.end()) {
+        return it->second;
+    }
+    return m_defaults;
+}
+
+} // namespace rmw::iox2
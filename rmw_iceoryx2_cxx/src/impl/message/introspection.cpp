@@ -130,10 +130,16 @@ size_t serialized_message_size(const void* ros_message, const rosidl_message_typ
     }
     if (auto handle =
             get_message_typesupport_handle(type_support, rosidl_typesupport_fastrtps_cpp::typesupport_identifier)) {
-        auto callbacks = static_cast<const message_type_support_callbacks_t*>(handle->data);
-        return 4 + callbacks->get_serialized_size(ros_message); // 4 bytes for CDR header
+        return serialized_message_size(ros_message, static_cast<const message_type_support_callbacks_t*>(handle->data));
     }
     return 0;
 }
 
+size_t serialized_message_size(const void* ros_message, const message_type_support_callbacks_t* callbacks) {
+    if (!callbacks) {
+        return 0;
+    }
+    return 4 + callbacks->get_serialized_size(ros_message); // 4 bytes for CDR header
+}
+
 } // namespace rmw::iox2
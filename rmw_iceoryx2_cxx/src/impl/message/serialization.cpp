@@ -0,0 +1,113 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#include "rmw_iceoryx2_cxx/impl/message/serialization.hpp"
+
+#include "fastcdr/exceptions/NotEnoughMemoryException.h"
+#include "rmw_iceoryx2_cxx/impl/common/error_message.hpp"
+#include "rosidl_typesupport_fastrtps_cpp/identifier.hpp"
+#include "rosidl_typesupport_fastrtps_cpp/message_type_support.h"
+
+namespace rmw::iox2
+{
+
+namespace
+{
+
+auto fastrtps_callbacks(const rosidl_message_type_support_t* type_support) -> const message_type_support_callbacks_t* {
+    const rosidl_message_type_support_t* handle =
+        get_message_typesupport_handle(type_support, rosidl_typesupport_fastrtps_cpp::typesupport_identifier);
+    if (!handle) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to get typesupport handle");
+        return nullptr;
+    }
+
+    auto callbacks = static_cast<const message_type_support_callbacks_t*>(handle->data);
+    if (!callbacks) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to get typesupport callbacks");
+        return nullptr;
+    }
+    return callbacks;
+}
+
+} // namespace
+
+auto serialize(const void* ros_message,
+               const rosidl_message_type_support_t* type_support,
+               uint8_t* buffer,
+               size_t capacity) -> iox::expected<size_t, SerializationError> {
+    return serialize(ros_message, fastrtps_callbacks(type_support), buffer, capacity);
+}
+
+auto serialize(const void* ros_message,
+               const message_type_support_callbacks_t* callbacks,
+               uint8_t* buffer,
+               size_t capacity) -> iox::expected<size_t, SerializationError> {
+    using ::iox::err;
+    using ::iox::ok;
+
+    if (!callbacks) {
+        RMW_IOX2_CHAIN_ERROR_MSG("no typesupport callbacks available");
+        return err(SerializationError::TYPESUPPORT_UNAVAILABLE);
+    }
+
+    // The buffer is not owned by the serializer, thus it cannot grow and throws when exhausted
+    auto fast_buffer = eprosima::fastcdr::FastBuffer(reinterpret_cast<char*>(buffer), capacity);
+    auto serializer = eprosima::fastcdr::Cdr(
+        fast_buffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::DDS_CDR);
+
+    try {
+        callbacks->cdr_serialize(ros_message, serializer);
+    }
+    catch (eprosima::fastcdr::exception::NotEnoughMemoryException&) {
+        return err(SerializationError::INSUFFICIENT_CAPACITY);
+    }
+    catch (std::exception& e) {
+        RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING("failed to serialize: %s", e.what());
+        return err(SerializationError::SERIALIZATION_FAILURE);
+    }
+
+    return ok(serializer.get_serialized_data_length());
+}
+
+auto deserialize(const uint8_t* buffer,
+                 size_t size,
+                 const rosidl_message_type_support_t* type_support,
+                 void* ros_message) -> iox::expected<void, SerializationError> {
+    return deserialize(buffer, size, fastrtps_callbacks(type_support), ros_message);
+}
+
+auto deserialize(const uint8_t* buffer,
+                 size_t size,
+                 const message_type_support_callbacks_t* callbacks,
+                 void* ros_message) -> iox::expected<void, SerializationError> {
+    using ::iox::err;
+    using ::iox::ok;
+
+    if (!callbacks) {
+        RMW_IOX2_CHAIN_ERROR_MSG("no typesupport callbacks available");
+        return err(SerializationError::TYPESUPPORT_UNAVAILABLE);
+    }
+
+    eprosima::fastcdr::FastBuffer fast_buffer(const_cast<char*>(reinterpret_cast<const char*>(buffer)), size);
+    eprosima::fastcdr::Cdr deserializer(
+        fast_buffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::DDS_CDR);
+
+    try {
+        callbacks->cdr_deserialize(deserializer, ros_message);
+    }
+    catch (std::exception& e) {
+        RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING("failed to deserialize: %s", e.what());
+        return err(SerializationError::DESERIALIZATION_FAILURE);
+    }
+
+    return ok();
+}
+
+} // namespace rmw::iox2
@@ -0,0 +1,40 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#include "rmw_iceoryx2_cxx/impl/message/type_support.hpp"
+
+#include "rmw_iceoryx2_cxx/impl/message/introspection.hpp"
+#include "rosidl_typesupport_fastrtps_cpp/identifier.hpp"
+#include "rosidl_typesupport_introspection_cpp/identifier.hpp"
+
+namespace rmw::iox2
+{
+
+auto resolve(const rosidl_message_type_support_t* type_support) -> MessageTypeSupport {
+    MessageTypeSupport resolved;
+    resolved.type_support = type_support;
+    if (type_support == nullptr) {
+        return resolved;
+    }
+
+    if (auto handle =
+            get_message_typesupport_handle(type_support, rosidl_typesupport_fastrtps_cpp::typesupport_identifier)) {
+        resolved.callbacks = static_cast<const message_type_support_callbacks_t*>(handle->data);
+    }
+    if (auto handle = get_message_typesupport_handle(type_support,
+                                                     rosidl_typesupport_introspection_cpp::typesupport_identifier)) {
+        resolved.members = static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers*>(handle->data);
+    }
+    resolved.size = message_size(type_support);
+    resolved.is_pod = is_pod(resolved.members);
+
+    return resolved;
+}
+
+} // namespace rmw::iox2
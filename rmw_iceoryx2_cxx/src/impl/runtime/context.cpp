@@ -10,11 +10,30 @@
 #include "rmw_iceoryx2_cxx/impl/runtime/context.hpp"
 
 #include "rmw_iceoryx2_cxx/impl/common/create.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/environment.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/error_message.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/log.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/names.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/publisher.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+// Source of the generations identifying contexts, never reused within the process
+std::atomic<uint64_t> g_context_generation{0};
+
+// The generation of the context the calling thread last waited in, zero if none. Identified by generation rather
+// than address, so that a context created at the address of a destroyed one is not taken for it.
+thread_local uint64_t t_waiting_context{0};
+} // namespace
 
 rmw_context_impl_s::rmw_context_impl_s(CreationLock, iox::optional<ErrorType>& error, const uint32_t id)
-    : m_id{id} {
+    : m_id{id}
+    , m_generation{g_context_generation.fetch_add(1, std::memory_order_relaxed) + 1} {
     using ::rmw::iox2::create_in_place;
+    namespace env = rmw::iox2::env;
     namespace names = rmw::iox2::names;
 
     if (auto result = create_in_place<Iceoryx2>(m_iox2, names::context(id)); result.has_error()) {
@@ -22,6 +41,36 @@ rmw_context_impl_s::rmw_context_impl_s(CreationLock, iox::optional<ErrorType>& e
         error.emplace(ErrorType::HANDLE_CREATION_FAILURE);
         return;
     }
+    // The registry thread is woken up like a waitset, thus its waker is named like one
+    m_listener_registry.emplace(m_iox2.value(), names::waitset(id, generate_waitset_id()));
+
+    if (auto spin_budget = env::get_uint(env::WAITSET_SPIN_BUDGET_US); spin_budget.has_value()) {
+        m_waitset_spin_budget = Duration::fromMicroseconds(spin_budget.value());
+    } else if (env::get(env::WAITSET_SPIN_BUDGET_US).has_value()) {
+        RMW_IOX2_LOG_WARN("Ignoring invalid value of %s", env::WAITSET_SPIN_BUDGET_US);
+    }
+
+    if (auto prioritization = env::get_uint(env::WAITSET_PRIORITIZATION); prioritization.has_value()) {
+        m_waitset_prioritization = prioritization.value() != 0;
+    } else if (env::get(env::WAITSET_PRIORITIZATION).has_value()) {
+        RMW_IOX2_LOG_WARN("Ignoring invalid value of %s", env::WAITSET_PRIORITIZATION);
+    }
+
+    if (auto speculative = env::get_uint(env::SPECULATIVE_SERIALIZATION); speculative.has_value()) {
+        m_speculative_serialization = speculative.value() != 0;
+    } else if (env::get(env::SPECULATIVE_SERIALIZATION).has_value()) {
+        RMW_IOX2_LOG_WARN("Ignoring invalid value of %s", env::SPECULATIVE_SERIALIZATION);
+    }
+
+    if (auto path = env::get(env::TOPIC_CONFIG); path.has_value()) {
+        if (auto config = TopicConfig::from_file(path.value()); config.has_value()) {
+            m_topic_config = std::move(config.value());
+        } else {
+            RMW_IOX2_LOG_WARN("Ignoring invalid topic configuration, using defaults for all topics: %s",
+                              rcutils_get_error_string().str);
+            rcutils_reset_error();
+        }
+    }
 }
 
 auto rmw_context_impl_s::id() -> uint32_t {
@@ -35,3 +84,96 @@ auto rmw_context_impl_s::iox2() -> Iceoryx2& {
 auto rmw_context_impl_s::generate_guard_condition_id() -> uint32_t {
     return m_guard_condition_counter++;
 }
+
+auto rmw_context_impl_s::generate_waitset_id() -> uint32_t {
+    return m_waitset_counter++;
+}
+
+auto rmw_context_impl_s::listener_registry() -> ListenerRegistry& {
+    return m_listener_registry.value();
+}
+
+auto rmw_context_impl_s::event_dispatcher() -> iox::expected<EventDispatcher*, ErrorType> {
+    using ::iox::err;
+    using ::iox::ok;
+    using ::rmw::iox2::create_in_place;
+    namespace names = rmw::iox2::names;
+
+    std::lock_guard<std::mutex> lock{m_event_dispatcher_mutex};
+    if (!m_event_dispatcher.has_value()) {
+        // The dispatcher is woken up like a waitset, thus its waker is named like one
+        if (create_in_place(m_event_dispatcher,
+                            m_iox2.value(),
+                            m_listener_registry.value(),
+                            names::waitset(m_id, generate_waitset_id()))
+                .has_error()) {
+            // Retried on next use
+            m_event_dispatcher.reset();
+            RMW_IOX2_CHAIN_ERROR_MSG("failed to create event dispatcher");
+            return err(ErrorType::EVENT_DISPATCHER_CREATION_FAILURE);
+        }
+    }
+    return ok(&m_event_dispatcher.value());
+}
+
+auto rmw_context_impl_s::waitset_spin_budget() const -> Duration {
+    return m_waitset_spin_budget;
+}
+
+auto rmw_context_impl_s::waitset_prioritization() const -> bool {
+    return m_waitset_prioritization;
+}
+
+auto rmw_context_impl_s::topic_config() const -> const TopicConfig& {
+    return m_topic_config;
+}
+
+auto rmw_context_impl_s::speculative_serialization() const -> bool {
+    return m_speculative_serialization;
+}
+
+auto rmw_context_impl_s::payload_size_hint(const std::string& topic) -> uint64_t {
+    std::lock_guard<std::mutex> lock{m_payload_size_mutex};
+    if (auto it = m_payload_size_hints.find(topic); it != m_payload_size_hints.end()) {
+        return it->second;
+    }
+    return 0;
+}
+
+auto rmw_context_impl_s::record_payload_size(const std::string& topic, uint64_t number_of_bytes) -> void {
+    std::lock_guard<std::mutex> lock{m_payload_size_mutex};
+    auto& hint = m_payload_size_hints[topic];
+    hint = std::max(hint, number_of_bytes);
+}
+
+auto rmw_context_impl_s::mark_waiting_thread() -> void {
+    t_waiting_context = m_generation;
+}
+
+auto rmw_context_impl_s::is_waiting_thread() const -> bool {
+    return t_waiting_context == m_generation;
+}
+
+auto rmw_context_impl_s::defer_notification(Publisher& publisher) -> void {
+    std::lock_guard<std::mutex> lock{m_deferred_notifications_mutex};
+    m_deferred_notifications.push_back(&publisher);
+}
+
+auto rmw_context_impl_s::cancel_deferred_notification(Publisher& publisher) -> void {
+    std::lock_guard<std::mutex> lock{m_deferred_notifications_mutex};
+    m_deferred_notifications.erase(
+        std::remove(m_deferred_notifications.begin(), m_deferred_notifications.end(), &publisher),
+        m_deferred_notifications.end());
+}
+
+auto rmw_context_impl_s::flush_deferred_notifications() -> void {
+    std::lock_guard<std::mutex> lock{m_deferred_notifications_mutex};
+    for (auto* publisher : m_deferred_notifications) {
+        if (auto result = publisher->flush_notification(); result.has_error()) {
+            RMW_IOX2_LOG_ERROR("Failed to flush deferred notification of publisher to '%s'",
+                               publisher->topic().c_str());
+        }
+    }
+    // Retains the capacity, so that deferring notifications does not allocate in steady state
+    m_deferred_notifications.clear();
+}
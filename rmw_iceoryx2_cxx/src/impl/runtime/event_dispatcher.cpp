@@ -0,0 +1,244 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#include "rmw_iceoryx2_cxx/impl/runtime/event_dispatcher.hpp"
+
+#include "iox2/callback_progression.hpp"
+#include "iox2/waitset.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/create.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/error_message.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/log.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/subscriber.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace rmw::iox2
+{
+
+EventDispatcher::EventDispatcher(CreationLock,
+                                 iox::optional<ErrorType>& error,
+                                 Iceoryx2& iox2,
+                                 ListenerRegistry& listener_registry,
+                                 const std::string& waker_service_name)
+    : m_listener_registry{listener_registry} {
+    auto waitset = Iceoryx2::WaitSet::create();
+    if (waitset.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(waitset.error()));
+        error.emplace(ErrorType::WAITSET_CREATION_FAILURE);
+        return;
+    }
+    m_waitset.emplace(std::move(waitset.value()));
+
+    if (create_in_place(m_waker, iox2, waker_service_name).has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to create waker");
+        error.emplace(ErrorType::LISTENER_CREATION_FAILURE);
+        return;
+    }
+
+    auto guard = m_waitset->attach_notification(m_waker->listener().file_descriptor());
+    if (guard.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(guard.error()));
+        error.emplace(ErrorType::ATTACHMENT_FAILURE);
+        return;
+    }
+    m_waker_attachment.emplace(std::move(guard.value()));
+
+    // Started last, the waitset is only accessed by the dispatcher thread from here on
+    m_thread = std::thread{[this] { run(); }};
+}
+
+EventDispatcher::~EventDispatcher() {
+    if (m_thread.joinable()) {
+        m_stop = true;
+        wake();
+        m_thread.join();
+    }
+
+    // Release all listeners before the waker armed on them is destroyed
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_registrations.clear();
+    m_sources.clear();
+}
+
+auto EventDispatcher::set_callback(Subscriber& subscriber, rmw_event_callback_t callback, const void* user_data)
+    -> iox::expected<void, ErrorType> {
+    using ::iox::err;
+    using ::iox::ok;
+
+    if (callback == nullptr) {
+        remove_callback(subscriber);
+        return ok();
+    }
+
+    std::lock_guard<std::recursive_mutex> dispatch_lock{m_dispatch_mutex};
+    std::unique_lock<std::mutex> lock{m_mutex};
+
+    auto registration = std::find_if(m_registrations.begin(), m_registrations.end(), [&subscriber](const auto& r) {
+        return r.subscriber == &subscriber;
+    });
+    if (registration != m_registrations.end()) {
+        // The samples held were already reported to the replaced callback, thus are not reported again
+        registration->callback = callback;
+        registration->user_data = user_data;
+        return ok();
+    }
+
+    auto& source = m_sources[subscriber.service_name()];
+    if (!source) {
+        auto listener = m_listener_registry.acquire(subscriber.service_name(), m_waker.value(), true);
+        if (listener.has_error()) {
+            m_sources.erase(subscriber.service_name());
+            RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING("failed to acquire listener for topic '%s'",
+                                                        subscriber.topic().c_str());
+            return err(ErrorType::LISTENER_CREATION_FAILURE);
+        }
+        source = std::make_unique<Source>(std::move(listener.value()));
+    }
+    source->registrations++;
+
+    // Samples sent before arming may not have been notified, they are covered by the check below
+    if (auto* waiters = subscriber.waiters(); waiters != nullptr) {
+        waiters->arm();
+    }
+    m_registrations.push_back(Registration{&subscriber, callback, user_data, source.get()});
+    registration = std::prev(m_registrations.end());
+
+    // Report the samples received before the callback was first set. Their number is unknown, the depth bounds it.
+    if (has_samples(*registration)) {
+        const auto number_of_events = std::max<size_t>(1, subscriber.qos().depth);
+        lock.unlock();
+        callback(user_data, number_of_events);
+    }
+    return ok();
+}
+
+auto EventDispatcher::remove_callback(Subscriber& subscriber) -> void {
+    // Waits for callbacks being invoked by other threads
+    std::lock_guard<std::recursive_mutex> dispatch_lock{m_dispatch_mutex};
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    auto registration = std::find_if(m_registrations.begin(), m_registrations.end(), [&subscriber](const auto& r) {
+        return r.subscriber == &subscriber;
+    });
+    if (registration == m_registrations.end()) {
+        return;
+    }
+
+    if (auto* waiters = subscriber.waiters(); waiters != nullptr) {
+        waiters->disarm();
+    }
+    if (--registration->source->registrations == 0) {
+        // Disarms and releases the listener
+        m_sources.erase(subscriber.service_name());
+    }
+    m_registrations.erase(registration);
+}
+
+auto EventDispatcher::registration_count() const -> size_t {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_registrations.size();
+}
+
+auto EventDispatcher::run() -> void {
+    using ::iox2::CallbackProgression;
+
+    bool degraded{false};
+    while (!m_stop) {
+        // Woken up by the listener registry on events of the registered topics, or on shutdown
+        auto on_event = [this](auto id) -> CallbackProgression {
+            if (m_waker_attachment->id() == id) {
+                if (auto result = m_waker->drain(); result.has_error()) {
+                    RMW_IOX2_LOG_ERROR("Failed to process wakeup of the event dispatcher");
+                }
+            }
+            return CallbackProgression::Continue;
+        };
+
+        // The events of the sources keep being counted by the listener registry, thus callbacks are still invoked
+        // while waiting fails or returns immediately, only delayed by the dispatch interval
+        auto result = m_waitset->wait_and_process_once(on_event);
+        if (result.has_error()) {
+            if (!degraded) {
+                RMW_IOX2_LOG_ERROR("Event dispatcher failed to wait for events, dispatching periodically: %s",
+                                   ::iox::into<const char*>(result.error()));
+                degraded = true;
+            }
+            std::this_thread::sleep_for(DEGRADED_DISPATCH_INTERVAL);
+        } else if (result.value() == ::iox2::WaitSetRunResult::TerminationRequest) {
+            // Waiting again returns immediately once the process is requested to terminate
+            std::this_thread::sleep_for(DEGRADED_DISPATCH_INTERVAL);
+        } else {
+            degraded = false;
+        }
+
+        if (!m_stop) {
+            std::lock_guard<std::recursive_mutex> dispatch_lock{m_dispatch_mutex};
+            dispatch();
+        }
+    }
+}
+
+auto EventDispatcher::dispatch() -> void {
+    m_invocations.clear();
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        for (auto& [service_name, source] : m_sources) {
+            source->pending = source->events.exchange(0, std::memory_order_acquire);
+        }
+        // Each subscriber receives every sample of its topic, thus all are passed the notifications of the topic.
+        // Notifications of samples already taken are not reported.
+        for (const auto& registration : m_registrations) {
+            if (registration.source->pending > 0 && has_samples(registration)) {
+                m_invocations.push_back(
+                    Invocation{registration.subscriber, static_cast<size_t>(registration.source->pending)});
+            }
+        }
+    }
+
+    for (const auto& invocation : m_invocations) {
+        invoke(invocation);
+    }
+}
+
+auto EventDispatcher::has_samples(const Registration& registration) -> bool {
+    auto has_samples = registration.subscriber->has_samples();
+    if (has_samples.has_error()) {
+        RMW_IOX2_LOG_ERROR("Failed to check for samples of subscriber to %s",
+                           registration.subscriber->topic().c_str());
+        return false;
+    }
+    return has_samples.value();
+}
+
+auto EventDispatcher::invoke(const Invocation& invocation) -> void {
+    rmw_event_callback_t callback{nullptr};
+    const void* user_data{nullptr};
+    {
+        // The registration may have been replaced or removed by a previously invoked callback
+        std::lock_guard<std::mutex> lock{m_mutex};
+        auto registration = std::find_if(m_registrations.begin(), m_registrations.end(), [&invocation](const auto& r) {
+            return r.subscriber == invocation.subscriber;
+        });
+        if (registration == m_registrations.end()) {
+            return;
+        }
+        callback = registration->callback;
+        user_data = registration->user_data;
+    }
+    callback(user_data, invocation.number_of_events);
+}
+
+auto EventDispatcher::wake() -> void {
+    if (auto result = m_waker->wake(); result.has_error()) {
+        RMW_IOX2_LOG_ERROR("Failed to wake up the event dispatcher");
+    }
+}
+
+} // namespace rmw::iox2
@@ -15,12 +15,15 @@
 #include "rmw_iceoryx2_cxx/impl/common/names.hpp"
 #include "rmw_iceoryx2_cxx/impl/middleware/iceoryx2.hpp"
 
+#include <functional>
+
 namespace rmw::iox2
 {
 
 GuardCondition::GuardCondition(CreationLock, iox::optional<ErrorType>& error, Context& context)
     : m_trigger_id{context.generate_guard_condition_id()}
-    , m_service_name{names::guard_condition(context.id(), m_trigger_id)} {
+    , m_service_name{names::guard_condition(context.id(), m_trigger_id)}
+    , m_service_name_hash{std::hash<std::string>{}(m_service_name)} {
     auto iox2_service_name = Iceoryx2::ServiceName::create(m_service_name.c_str());
     if (iox2_service_name.has_error()) {
         RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(iox2_service_name.error()));
@@ -59,6 +62,14 @@ auto GuardCondition::service_name() const -> const std::string& {
     return m_service_name;
 }
 
+auto GuardCondition::service_name_hash() const -> size_t {
+    return m_service_name_hash;
+}
+
+auto GuardCondition::lifetime() const -> const Lifetime& {
+    return m_lifetime;
+}
+
 auto GuardCondition::trigger() -> iox::expected<void, ErrorType> {
     using ::iox::err;
     using ::iox::ok;
@@ -69,7 +80,18 @@ auto GuardCondition::trigger() -> iox::expected<void, ErrorType> {
         return err(ErrorType::NOTIFICATION_FAILURE);
     };
 
+    // Set after notifying so that the event can be drained by whoever consumes the trigger
+    m_triggered.store(true, std::memory_order_release);
+
     return ok();
 }
 
+auto GuardCondition::consume_trigger() -> bool {
+    // Check before exchanging to avoid contending on the flag while it is polled
+    if (!m_triggered.load(std::memory_order_acquire)) {
+        return false;
+    }
+    return m_triggered.exchange(false, std::memory_order_acq_rel);
+}
+
 } // namespace rmw::iox2
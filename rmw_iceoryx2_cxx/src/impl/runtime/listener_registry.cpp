@@ -0,0 +1,466 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#include "rmw_iceoryx2_cxx/impl/runtime/listener_registry.hpp"
+
+#include "iox2/callback_progression.hpp"
+#include "iox2/waitset.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/create.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/error_message.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/log.hpp"
+
+#include <algorithm>
+
+namespace rmw::iox2
+{
+
+Waker::Waker(CreationLock, iox::optional<ErrorType>& error, Iceoryx2& iox2, const std::string& service_name) {
+    auto service = iox2.service_builder<Iceoryx2::ServiceType::Local>(service_name).event().open_or_create();
+    if (service.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(service.error()));
+        error.emplace(ErrorType::SERVICE_CREATION_FAILURE);
+        return;
+    }
+
+    auto listener = service.value().listener_builder().create();
+    if (listener.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(listener.error()));
+        error.emplace(ErrorType::LISTENER_CREATION_FAILURE);
+        return;
+    }
+    m_listener.emplace(std::move(listener.value()));
+
+    auto notifier = service.value().notifier_builder().create();
+    if (notifier.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(notifier.error()));
+        error.emplace(ErrorType::NOTIFIER_CREATION_FAILURE);
+        return;
+    }
+    m_notifier.emplace(std::move(notifier.value()));
+}
+
+auto Waker::listener() -> Listener& {
+    return m_listener.value();
+}
+
+auto Waker::wake() -> iox::expected<void, ErrorType> {
+    using ::iox::err;
+    using ::iox::ok;
+
+    std::lock_guard<std::mutex> lock{m_notifier_mutex};
+    if (auto result = m_notifier->notify(); result.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(result.error()));
+        return err(ErrorType::NOTIFICATION_FAILURE);
+    }
+    return ok();
+}
+
+auto Waker::drain() -> iox::expected<bool, ErrorType> {
+    using ::iox::err;
+    using ::iox::ok;
+
+    bool woken{false};
+    if (auto result = m_listener->try_wait_all([&woken](auto) { woken = true; }); result.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve events from waker");
+        return err(ErrorType::LISTENER_FAILURE);
+    }
+    return ok(woken);
+}
+
+// ===================================================================================================================
+
+ListenerRegistry::Entry::Entry(const std::string& service_name, Listener&& listener)
+    : service_name{service_name}
+    , listener{std::move(listener)} {
+}
+
+ListenerRegistry::Handle::Handle(ListenerRegistry& registry, Entry& entry, Waker& waker, bool relaying)
+    : m_registry{&registry}
+    , m_entry{&entry}
+    , m_waker{&waker}
+    , m_relaying{relaying} {
+}
+
+ListenerRegistry::Handle::Handle(Handle&& other) noexcept
+    : m_registry{other.m_registry}
+    , m_entry{other.m_entry}
+    , m_waker{other.m_waker}
+    , m_relaying{other.m_relaying}
+    , m_armed{other.m_armed} {
+    other.m_entry = nullptr;
+    other.m_armed = false;
+}
+
+auto ListenerRegistry::Handle::operator=(Handle&& other) noexcept -> Handle& {
+    if (this != &other) {
+        release();
+        m_registry = other.m_registry;
+        m_entry = other.m_entry;
+        m_waker = other.m_waker;
+        m_relaying = other.m_relaying;
+        m_armed = other.m_armed;
+        other.m_entry = nullptr;
+        other.m_armed = false;
+    }
+    return *this;
+}
+
+ListenerRegistry::Handle::~Handle() {
+    release();
+}
+
+auto ListenerRegistry::Handle::arm(std::atomic<uint64_t>* events) -> void {
+    if (m_entry == nullptr || m_armed) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock{m_entry->mutex};
+    m_entry->armed.push_back(Armed{m_waker, events});
+    m_armed = true;
+}
+
+auto ListenerRegistry::Handle::disarm() -> void {
+    if (m_entry == nullptr || !m_armed) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock{m_entry->mutex};
+    auto& armed = m_entry->armed;
+    auto it = std::find_if(armed.begin(), armed.end(), [this](const auto& a) { return a.waker == m_waker; });
+    if (it != armed.end()) {
+        armed.erase(it);
+    }
+    m_armed = false;
+}
+
+auto ListenerRegistry::Handle::exclusive() const -> bool {
+    return m_entry != nullptr && !m_entry->relayed.load(std::memory_order_acquire);
+}
+
+auto ListenerRegistry::Handle::listener() -> Listener& {
+    return m_entry->listener;
+}
+
+auto ListenerRegistry::Handle::drain() -> bool {
+    if (m_entry == nullptr) {
+        return false;
+    }
+    return m_registry->drain(*m_entry, m_waker) > 0;
+}
+
+auto ListenerRegistry::Handle::release() -> void {
+    if (m_entry == nullptr) {
+        return;
+    }
+    disarm();
+    m_registry->release(*m_entry, m_relaying);
+    m_entry = nullptr;
+}
+
+// ===================================================================================================================
+
+ListenerRegistry::ListenerRegistry(Iceoryx2& iox2, const std::string& waker_service_name)
+    : m_iox2{iox2}
+    , m_waker_service_name{waker_service_name} {
+}
+
+ListenerRegistry::~ListenerRegistry() {
+    if (m_thread.joinable()) {
+        m_stop = true;
+        wake();
+        m_thread.join();
+    }
+
+    // Detach all listeners before the waitset is destroyed
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_index.clear();
+    m_entries.clear();
+}
+
+auto ListenerRegistry::acquire(const std::string& service_name, Waker& waker, bool relaying)
+    -> iox::expected<Handle, ErrorType> {
+    using ::iox::err;
+    using ::iox::ok;
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    // Counted before relaying is determined, undone if the registry thread cannot be started
+    auto share = [&](Entry& entry) -> iox::expected<Handle, ErrorType> {
+        entry.handles++;
+        entry.relaying_handles += relaying ? 1 : 0;
+        if (auto result = update_relayed(entry); result.has_error()) {
+            entry.handles--;
+            entry.relaying_handles -= relaying ? 1 : 0;
+            return err(result.error());
+        }
+        return ok(Handle{*this, entry, waker, relaying});
+    };
+
+    if (auto it = m_entries.find(service_name); it != m_entries.end()) {
+        // Another waitset already holds a listener for the service, or it is not yet released. Share it.
+        return share(*it->second);
+    }
+
+    auto service = m_iox2.service_builder<Iceoryx2::ServiceType::Ipc>(service_name).event().open_or_create();
+    if (service.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(service.error()));
+        return err(ErrorType::SERVICE_CREATION_FAILURE);
+    }
+
+    auto listener = service.value().listener_builder().create();
+    if (listener.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(listener.error()));
+        return err(ErrorType::LISTENER_CREATION_FAILURE);
+    }
+
+    // Attached by the holder or the registry thread, events received in the meantime remain pending on the listener
+    auto& entry = *m_entries.emplace(service_name, std::make_unique<Entry>(service_name, std::move(listener.value())))
+                       .first->second;
+    auto handle = share(entry);
+    if (handle.has_error()) {
+        // Only fails if the registry thread is not running, thus the listener is not released by it
+        m_entries.erase(service_name);
+    }
+    return handle;
+}
+
+auto ListenerRegistry::listener_count() const -> size_t {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return static_cast<size_t>(std::count_if(
+        m_entries.begin(), m_entries.end(), [](const auto& entry) { return entry.second->handles > 0; }));
+}
+
+auto ListenerRegistry::healthy() const -> bool {
+    return m_healthy.load(std::memory_order_acquire);
+}
+
+auto ListenerRegistry::update_relayed(Entry& entry) -> iox::expected<void, ErrorType> {
+    using ::iox::err;
+    using ::iox::ok;
+
+    const bool relayed = entry.handles > 1 || entry.relaying_handles > 0;
+    if (relayed == entry.relayed.load(std::memory_order_relaxed)) {
+        return ok();
+    }
+    if (relayed) {
+        if (auto result = start(); result.has_error()) {
+            return err(result.error());
+        }
+    }
+    entry.relayed.store(relayed, std::memory_order_release);
+    wake();
+    return ok();
+}
+
+auto ListenerRegistry::start() -> iox::expected<void, ErrorType> {
+    using ::iox::err;
+    using ::iox::ok;
+
+    if (m_thread.joinable()) {
+        return ok();
+    }
+
+    if (!m_waitset.has_value()) {
+        auto waitset = Iceoryx2::WaitSet::create();
+        if (waitset.has_error()) {
+            RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(waitset.error()));
+            return err(ErrorType::WAITSET_CREATION_FAILURE);
+        }
+        m_waitset.emplace(std::move(waitset.value()));
+    }
+
+    if (!m_waker.has_value() && create_in_place(m_waker, m_iox2, m_waker_service_name).has_error()) {
+        // Retried on next acquisition
+        m_waker.reset();
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to create waker");
+        return err(ErrorType::LISTENER_CREATION_FAILURE);
+    }
+
+    if (!m_waker_attachment.has_value()) {
+        auto guard = m_waitset->attach_notification(m_waker->listener().file_descriptor());
+        if (guard.has_error()) {
+            RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(guard.error()));
+            return err(ErrorType::ATTACHMENT_FAILURE);
+        }
+        m_waker_attachment.emplace(std::move(guard.value()));
+    }
+
+    // Started last, the waitset is only accessed by the registry thread from here on
+    m_thread = std::thread{[this] { run(); }};
+    return ok();
+}
+
+auto ListenerRegistry::run() -> void {
+    using ::iox2::CallbackProgression;
+
+    while (!m_stop) {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            update_attachments();
+        }
+
+        auto on_event = [this](auto id) -> CallbackProgression {
+            if (m_waker_attachment->id() == id) {
+                // Woken up on changed listeners or on shutdown
+                if (auto result = m_waker->drain(); result.has_error()) {
+                    RMW_IOX2_LOG_ERROR("Failed to process wakeup of the listener registry");
+                }
+                return CallbackProgression::Continue;
+            }
+
+            // Find the triggered listener by binary search, the index is sorted by attachment ID
+            auto entry_before = [](const IndexEntry& entry, const auto& key) { return *entry.id < key; };
+            auto it = std::lower_bound(m_index.begin(), m_index.end(), id, entry_before);
+            if (it != m_index.end() && *it->id == id) {
+                drain(*it->entry);
+            }
+            return CallbackProgression::Continue;
+        };
+
+        auto result = m_waitset->wait_and_process_once(on_event);
+        if (result.has_error()) {
+            // Reported to the waitsets blocked on relayed listeners, waiting is retried until the registry is stopped
+            if (m_healthy.exchange(false, std::memory_order_acq_rel)) {
+                RMW_IOX2_LOG_ERROR("Listener registry failed to wait for events: %s",
+                                   ::iox::into<const char*>(result.error()));
+            }
+            wake_all_armed();
+            std::this_thread::sleep_for(DEGRADED_POLL_INTERVAL);
+            continue;
+        }
+        if (!m_healthy.exchange(true, std::memory_order_acq_rel)) {
+            RMW_IOX2_LOG_INFO("Listener registry recovered, waiting for events again");
+        }
+        if (result.value() == ::iox2::WaitSetRunResult::TerminationRequest) {
+            // Waiting again returns immediately once the process is requested to terminate. The request is forwarded
+            // to the blocked waitsets and the listeners are drained periodically instead, so that the waitsets keep
+            // being woken up on events until the context is shut down.
+            wake_all_armed();
+            std::this_thread::sleep_for(DEGRADED_POLL_INTERVAL);
+        }
+    }
+}
+
+auto ListenerRegistry::wake_all_armed() -> void {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    for (auto& [service_name, entry] : m_entries) {
+        if (!entry->attachment.has_value()) {
+            continue;
+        }
+        if (drain(*entry) == 0) {
+            std::lock_guard<std::mutex> entry_lock{entry->mutex};
+            wake_armed(*entry, nullptr);
+        }
+    }
+}
+
+auto ListenerRegistry::update_attachments() -> void {
+    bool changed{false};
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        auto& entry = *it->second;
+        if (entry.handles == 0) {
+            // Detached before the listener is released
+            entry.attachment.reset();
+            it = m_entries.erase(it);
+            changed = true;
+            continue;
+        }
+        if (!entry.relayed.load(std::memory_order_relaxed)) {
+            if (entry.attachment.has_value()) {
+                // Exclusive again, the remaining holder attaches the listener once woken up
+                entry.attachment.reset();
+                changed = true;
+                std::lock_guard<std::mutex> entry_lock{entry.mutex};
+                wake_armed(entry, nullptr);
+            }
+            ++it;
+            continue;
+        }
+        if (!entry.attachment.has_value()) {
+            auto guard = m_waitset->attach_notification(entry.listener.file_descriptor());
+            if (guard.has_error()) {
+                RMW_IOX2_LOG_ERROR("Failed to attach listener for %s to the listener registry: %s",
+                                   it->first.c_str(),
+                                   ::iox::into<const char*>(guard.error()));
+            } else {
+                entry.attachment.emplace(std::move(guard.value()));
+                changed = true;
+            }
+        }
+        ++it;
+    }
+
+    if (changed) {
+        m_index.clear();
+        for (auto& [service_name, entry] : m_entries) {
+            if (entry->attachment.has_value()) {
+                m_index.push_back(IndexEntry{&entry->attachment->id(), entry.get()});
+            }
+        }
+        std::sort(m_index.begin(), m_index.end(), [](const auto& lhs, const auto& rhs) {
+            return *lhs.id < *rhs.id;
+        });
+    }
+}
+
+auto ListenerRegistry::drain(Entry& entry, const Waker* except) -> uint64_t {
+    // Done while holding the lock so that the wakers cannot be disarmed and destroyed in the meantime, and so that
+    // the listener is not drained concurrently while changing between exclusive and relayed
+    std::lock_guard<std::mutex> lock{entry.mutex};
+    uint64_t events{0};
+    if (auto result = entry.listener.try_wait_all([&events](auto) { events++; }); result.has_error()) {
+        RMW_IOX2_LOG_ERROR("Failed to retrieve events for %s", entry.service_name.c_str());
+        return 0;
+    }
+
+    // Only the waitsets blocked on the listener are woken up, the others check for data before blocking
+    if (events > 0) {
+        for (const auto& armed : entry.armed) {
+            if (armed.events != nullptr) {
+                armed.events->fetch_add(events, std::memory_order_release);
+            }
+        }
+        wake_armed(entry, except);
+    }
+    return events;
+}
+
+auto ListenerRegistry::wake_armed(Entry& entry, const Waker* except) -> void {
+    for (const auto& armed : entry.armed) {
+        if (armed.waker != except && armed.waker->wake().has_error()) {
+            RMW_IOX2_LOG_WARN("Failed to wake up waitset waiting on %s", entry.service_name.c_str());
+        }
+    }
+}
+
+auto ListenerRegistry::release(Entry& entry, bool relaying) -> void {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    entry.relaying_handles -= relaying ? 1 : 0;
+    // The listener is released by the registry thread if running, as it must be detached from its waitset first.
+    // If the service is acquired again in the meantime, the listener is kept.
+    if (--entry.handles == 0) {
+        if (m_thread.joinable()) {
+            wake();
+        } else {
+            m_entries.erase(entry.service_name);
+        }
+        return;
+    }
+    // Only relaying fewer listeners, which does not require starting the registry thread
+    (void)update_relayed(entry);
+}
+
+auto ListenerRegistry::wake() -> void {
+    if (!m_waker.has_value()) {
+        return;
+    }
+    if (auto result = m_waker->wake(); result.has_error()) {
+        RMW_IOX2_LOG_ERROR("Failed to wake up the listener registry");
+    }
+}
+
+} // namespace rmw::iox2
@@ -17,7 +17,8 @@ namespace rmw::iox2
 {
 
 Node::Node(CreationLock, iox::optional<ErrorType>& error, Context& context, const char* name, const char* ns)
-    : m_name{name} {
+    : m_context{context}
+    , m_name{name} {
     using ::rmw::iox2::create_in_place;
     namespace names = rmw::iox2::names;
 
@@ -38,6 +39,10 @@ auto Node::name() const -> const std::string& {
     return m_name;
 }
 
+auto Node::context() -> Context& {
+    return m_context;
+}
+
 auto Node::iox2() -> Iceoryx2& {
     return m_iox2.value();
 }
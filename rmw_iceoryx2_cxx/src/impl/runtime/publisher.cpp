@@ -9,23 +9,46 @@
 
 #include "rmw_iceoryx2_cxx/impl/runtime/publisher.hpp"
 
+#include "rmw_iceoryx2_cxx/impl/common/create.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/error_message.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/log.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/names.hpp"
-#include "rmw_iceoryx2_cxx/impl/message/introspection.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/qos.hpp"
 #include "rmw_iceoryx2_cxx/impl/middleware/iceoryx2.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
 namespace rmw::iox2
 {
 
+namespace
+{
+
+auto next_power_of_two(uint64_t value) -> uint64_t {
+    uint64_t power{1};
+    while (power < value) {
+        power <<= 1U;
+    }
+    return power;
+}
+
+} // namespace
+
 Publisher::Publisher(CreationLock,
                      iox::optional<ErrorType>& error,
                      Node& node,
                      const char* topic,
-                     const rosidl_message_type_support_t* type_support)
-    : m_topic{topic}
-    , m_typesupport{type_support}
-    , m_unserialized_size{::rmw::iox2::message_size(type_support)}
-    , m_service_name{::rmw::iox2::names::topic(topic)} {
+                     const rosidl_message_type_support_t* type_support,
+                     const rmw_qos_profile_t& requested_qos)
+    : m_context{node.context()}
+    , m_topic{topic}
+    , m_message_type{::rmw::iox2::resolve(type_support)}
+    , m_unserialized_size{m_message_type.size}
+    , m_service_name{::rmw::iox2::names::topic(topic)}
+    , m_qos{requested_qos}
+    , m_speculative_serialization{node.context().speculative_serialization()} {
     auto iox2_service_name = Iceoryx2::ServiceName::create(m_service_name.c_str());
     if (iox2_service_name.has_error()) {
         RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(iox2_service_name.error()));
@@ -33,15 +56,19 @@ Publisher::Publisher(CreationLock,
         return;
     }
 
+    const auto& settings = node.context().topic_config().settings(m_topic);
+    m_coalesce_notifications = settings.coalesce_notifications;
     auto iox2_pubsub_service = node.iox2()
                                    .ipc()
                                    .service_builder(iox2_service_name.value())
                                    .publish_subscribe<Payload>()
-                                   // TODO: make configurable
-                                   .max_publishers(64)
-                                   .max_subscribers(64)
-                                   .history_size(10)
-                                   .subscriber_max_buffer_size(10)
+                                   .user_header<UserHeader>()
+                                   .max_publishers(settings.max_publishers)
+                                   .max_subscribers(settings.max_subscribers)
+                                   .history_size(settings.history_size)
+                                   .subscriber_max_buffer_size(settings.subscriber_max_buffer_size)
+                                   .subscriber_max_borrowed_samples(settings.borrowed_samples())
+                                   .enable_safe_overflow(settings.safe_overflow)
                                    .payload_alignment(8) // All ROS2 messages have alignment 8. Maybe?
                                    .open_or_create();    // TODO: set attribute for ROS typename
 
@@ -51,9 +78,25 @@ Publisher::Publisher(CreationLock,
         return;
     }
 
+    // Blocking until subscribers have space is only possible when samples are not overwritten instead. The settings
+    // of the service may differ from the local settings if it was created by another process.
+    auto service_config = iox2_pubsub_service.value().static_config();
+    const bool reliable = qos::requests_reliable(requested_qos) && !service_config.has_safe_overflow();
+    m_max_deferred_notifications = service_config.subscriber_max_buffer_size();
+    if (qos::requests_reliable(requested_qos) && !reliable) {
+        qos::log_reliability_downgrade(m_topic.c_str(), "publisher");
+    }
+
+    // Start out large enough for the largest payload previously loaned on the topic, so that publishers of
+    // variable-size messages do not grow their segment step by step again
+    m_max_slice_len = std::max(m_unserialized_size, m_context.payload_size_hint(m_topic));
     auto publisher = iox2_pubsub_service.value()
                          .publisher_builder()
-                         .initial_max_slice_len(::rmw::iox2::message_size(m_typesupport))
+                         .initial_max_slice_len(m_max_slice_len.load())
+                         .allocation_strategy(::iox2::AllocationStrategy::PowerOfTwo)
+                         .max_loaned_samples(settings.max_loaned_samples)
+                         .unable_to_deliver_strategy(reliable ? ::iox2::UnableToDeliverStrategy::Block
+                                                              : ::iox2::UnableToDeliverStrategy::DiscardSample)
                          .create();
     if (publisher.has_error()) {
         RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(publisher.error()));
@@ -61,8 +104,17 @@ Publisher::Publisher(CreationLock,
         return;
     }
     m_iox_unique_id.emplace(publisher->id());
+    if (const auto& bytes = m_iox_unique_id->bytes(); bytes.has_value()) {
+        std::copy(bytes->data(), bytes->data() + RMW_GID_STORAGE_SIZE, m_gid);
+    }
     m_iox2_publisher.emplace(std::move(publisher.value()));
 
+    // The loans are limited by the publisher, thus they can be stored without allocating
+    m_registry.emplace(settings.max_loaned_samples);
+
+    m_qos = qos::effective(
+        requested_qos, qos::requested_depth(requested_qos), reliable, service_config.history_size() > 0);
+
     auto iox2_event_service = node.iox2().ipc().service_builder(iox2_service_name.value()).event().open_or_create();
     if (iox2_event_service.has_error()) {
         RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(iox2_event_service.error()));
@@ -77,8 +129,24 @@ Publisher::Publisher(CreationLock,
         return;
     }
     m_iox2_notifier.emplace(std::move(notifier.value()));
+
+    if (settings.suppress_idle_notifications) {
+        if (create_in_place(m_waiters, m_service_name).has_error()) {
+            RMW_IOX2_CHAIN_ERROR_MSG("failed to open waiter count");
+            error.emplace(ErrorType::WAITER_COUNT_CREATION_FAILURE);
+            return;
+        }
+    }
 }
 
+Publisher::~Publisher() {
+    m_context.cancel_deferred_notification(*this);
+    if (m_notification_pending.exchange(false) && m_iox2_notifier.has_value()) {
+        if (auto result = notify_now(); result.has_error()) {
+            RMW_IOX2_LOG_ERROR("Failed to notify subscribers of '%s' on destruction", m_topic.c_str());
+        }
+    }
+}
 
 auto Publisher::unique_id() -> const iox::optional<RawIdType>& {
     auto& bytes = m_iox_unique_id->bytes();
@@ -90,9 +158,12 @@ auto Publisher::topic() const -> const std::string& {
 }
 
 auto Publisher::typesupport() const -> const rosidl_message_type_support_t* {
-    return m_typesupport;
+    return m_message_type.type_support;
 }
 
+auto Publisher::message_type() const -> const MessageTypeSupport& {
+    return m_message_type;
+}
 
 auto Publisher::unserialized_size() const -> uint64_t {
     return m_unserialized_size;
@@ -102,73 +173,201 @@ auto Publisher::service_name() const -> const std::string& {
     return m_service_name;
 }
 
+auto Publisher::qos() const -> const rmw_qos_profile_t& {
+    return m_qos;
+}
+
+auto Publisher::speculative_payload_size() const -> uint64_t {
+    if (!m_speculative_serialization) {
+        return 0;
+    }
+    return m_payload_high_water_mark.load(std::memory_order_relaxed);
+}
+
 // TODO: Make return uint8_t
 auto Publisher::loan(uint64_t number_of_bytes) -> iox::expected<void*, ErrorType> {
     using iox::err;
     using iox::ok;
 
+    std::unique_lock<std::mutex> lock{m_port_mutex};
     auto sample = m_iox2_publisher->loan_slice_uninit(number_of_bytes);
+    if (sample.has_value()) {
+        track_payload_size(number_of_bytes);
+    }
+    lock.unlock();
     if (sample.has_error()) {
+        auto statistics = m_registry->statistics();
+        RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING(
+            "failed to loan sample (%zu of %zu loans held, oldest held for %lld ns)",
+            statistics.outstanding,
+            statistics.capacity,
+            static_cast<long long>(statistics.oldest_loan_age.count()));
         return err(ErrorType::LOAN_FAILURE);
     }
 
     // Store the sample for later use when publishing
-    auto ptr = m_registry.store(std::move(sample.value()));
+    auto ptr = m_registry->store(std::move(sample.value()));
+    if (ptr.has_error()) {
+        lock.lock();
+        Iceoryx2::InterProcess::drop(std::move(sample.value()));
+        RMW_IOX2_CHAIN_ERROR_MSG("exceeded the maximum number of loaned samples");
+        return err(ErrorType::LOAN_FAILURE);
+    }
 
-    return ok(static_cast<void*>(ptr));
+    return ok(static_cast<void*>(ptr.value()));
 }
 
 auto Publisher::return_loan(void* loaned_memory) -> iox::expected<void, ErrorType> {
     using ::iox::err;
     using ::iox::ok;
 
-    if (auto result = m_registry.release(static_cast<uint8_t*>(loaned_memory)); result.has_error()) {
-        switch (result.error()) {
+    auto sample = m_registry->release(static_cast<uint8_t*>(loaned_memory));
+    if (sample.has_error()) {
+        switch (sample.error()) {
         case SampleRegistryError::INVALID_PAYLOAD:
+        case SampleRegistryError::CAPACITY_EXCEEDED:
             return err(ErrorType::INVALID_PAYLOAD);
         }
     }
+
+    std::lock_guard<std::mutex> lock{m_port_mutex};
+    Iceoryx2::InterProcess::drop(std::move(sample.value()));
     return ok();
 }
 
 auto Publisher::publish_loan(void* loaned_memory) -> iox::expected<void, ErrorType> {
+    if (auto result = send_loan(loaned_memory); result.has_error()) {
+        return result;
+    }
+    return notify();
+}
+
+auto Publisher::publish_copy(const void* data, uint64_t number_of_bytes) -> iox::expected<void, ErrorType> {
+    return publish_batch(&data, 1, number_of_bytes);
+}
+
+auto Publisher::publish_batch(const void* const* data, size_t count, uint64_t number_of_bytes)
+    -> iox::expected<void, ErrorType> {
     using ::iox::err;
     using ::iox::ok;
 
-    // Send
-    auto sample = m_registry.release(static_cast<uint8_t*>(loaned_memory));
+    // Send, copying into loans as the header has to be written before sending
+    size_t sent{0};
+    {
+        std::lock_guard<std::mutex> lock{m_port_mutex};
+        for (; sent < count; sent++) {
+            auto sample = m_iox2_publisher->loan_slice_uninit(number_of_bytes);
+            if (sample.has_error()) {
+                RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(sample.error()));
+                break;
+            }
+            track_payload_size(number_of_bytes);
+            std::memcpy(sample->payload_mut().data(), data[sent], number_of_bytes);
+            stamp(sample->user_header_mut(), number_of_bytes);
+            if (auto result = Iceoryx2::InterProcess::send<Payload, UserHeader>(std::move(sample.value()));
+                result.has_error()) {
+                RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(result.error()));
+                break;
+            }
+        }
+    }
+
+    // Notify, also of the samples sent before a failure
+    if (sent > 0) {
+        if (auto result = notify(); result.has_error()) {
+            return result;
+        }
+    }
+    if (sent < count) {
+        return err(ErrorType::SEND_FAILURE);
+    }
+
+    return ok();
+}
+
+auto Publisher::send_loan(void* loaned_memory, const iox::optional<uint64_t>& number_of_bytes)
+    -> iox::expected<void, ErrorType> {
+    using ::iox::err;
+    using ::iox::ok;
+
+    auto sample = m_registry->release(static_cast<uint8_t*>(loaned_memory));
     if (!sample.has_value()) {
         RMW_IOX2_CHAIN_ERROR_MSG("invalid payload pointer");
         return err(ErrorType::INVALID_PAYLOAD);
     }
-    if (auto result = Iceoryx2::InterProcess::send<Payload>(std::move(sample.value())); result.has_error()) {
-        RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(result.error()));
-        return err(ErrorType::SEND_FAILURE);
+
+    const auto loaned_bytes = sample->payload().number_of_bytes();
+    if (number_of_bytes.has_value() && number_of_bytes.value() > loaned_bytes) {
+        std::lock_guard<std::mutex> lock{m_port_mutex};
+        Iceoryx2::InterProcess::drop(std::move(sample.value()));
+        RMW_IOX2_CHAIN_ERROR_MSG("message exceeds the loaned payload");
+        return err(ErrorType::INVALID_PAYLOAD);
     }
 
-    // Notify
-    if (auto result = m_iox2_notifier->notify(); result.has_error()) {
+    std::lock_guard<std::mutex> lock{m_port_mutex};
+    stamp(sample->user_header_mut(), number_of_bytes.value_or(loaned_bytes));
+    if (auto result = Iceoryx2::InterProcess::send<Payload, UserHeader>(std::move(sample.value()));
+        result.has_error()) {
         RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(result.error()));
-        return err(ErrorType::NOTIFICATION_FAILURE);
+        return err(ErrorType::SEND_FAILURE);
     }
 
     return ok();
 }
 
-auto Publisher::publish_copy(const void* data, uint64_t number_of_bytes) -> iox::expected<void, ErrorType> {
+auto Publisher::notify() -> iox::expected<void, ErrorType> {
+    // Threads that do not wait in the context, e.g. timer threads, might never flush the notification
+    if (!m_coalesce_notifications || !m_context.is_waiting_thread()) {
+        return notify_now();
+    }
+
+    // Samples deferred beyond the buffer size of subscribers would overwrite each other before they are woken up. A
+    // pending deferred notification remains registered, flushing it only causes a spurious wakeup.
+    if (m_deferred_notifications.fetch_add(1) + 1 >= m_max_deferred_notifications) {
+        return notify_now();
+    }
+
+    // Registered once until flushed by the next wait in the context
+    if (!m_notification_pending.exchange(true)) {
+        m_context.defer_notification(*this);
+    }
+    return iox::ok();
+}
+
+auto Publisher::flush_notification() -> iox::expected<void, ErrorType> {
+    if (!m_notification_pending.exchange(false)) {
+        return iox::ok();
+    }
+    return notify_now();
+}
+
+auto Publisher::suppressed_notifications() const -> uint64_t {
+    return m_suppressed_notifications.load(std::memory_order_relaxed);
+}
+
+auto Publisher::loan_statistics() const -> LoanStatistics {
+    return m_registry->statistics();
+}
+
+auto Publisher::segment_statistics() const -> SegmentStatistics {
+    return SegmentStatistics{m_max_slice_len.load(std::memory_order_relaxed),
+                             m_payload_high_water_mark.load(std::memory_order_relaxed),
+                             m_segment_resizes.load(std::memory_order_relaxed)};
+}
+
+auto Publisher::notify_now() -> iox::expected<void, ErrorType> {
     using ::iox::err;
-    using ::iox::ImmutableSlice;
     using ::iox::ok;
 
-    // Send
-    auto payload = ImmutableSlice<uint8_t>{static_cast<const uint8_t*>(data), number_of_bytes};
+    m_deferred_notifications = 0;
 
-    if (auto result = m_iox2_publisher->send_slice_copy(payload); result.has_error()) {
-        RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(result.error()));
-        return err(ErrorType::SEND_FAILURE);
+    // Waitsets that are not blocked find the samples when checking for data before they block
+    if (m_waiters.has_value() && !m_waiters->any_waiting()) {
+        m_suppressed_notifications.fetch_add(1, std::memory_order_relaxed);
+        return ok();
     }
 
-    // Notify
+    std::lock_guard<std::mutex> lock{m_port_mutex};
     if (auto result = m_iox2_notifier->notify(); result.has_error()) {
         RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(result.error()));
         return err(ErrorType::NOTIFICATION_FAILURE);
@@ -177,4 +376,24 @@ auto Publisher::publish_copy(const void* data, uint64_t number_of_bytes) -> iox:
     return ok();
 }
 
+auto Publisher::track_payload_size(uint64_t number_of_bytes) -> void {
+    // Mirrors the power-of-two allocation strategy of the publisher, which grows the segment on demand
+    if (number_of_bytes > m_max_slice_len.load(std::memory_order_relaxed)) {
+        m_max_slice_len.store(next_power_of_two(number_of_bytes), std::memory_order_relaxed);
+        m_segment_resizes.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (number_of_bytes > m_payload_high_water_mark.load(std::memory_order_relaxed)) {
+        m_payload_high_water_mark.store(number_of_bytes, std::memory_order_relaxed);
+        m_context.record_payload_size(m_topic, number_of_bytes);
+    }
+}
+
+auto Publisher::stamp(UserHeader& header, uint64_t payload_size) -> void {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    header.source_timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+    header.sequence_number = ++m_sequence_number;
+    std::memcpy(header.publisher_gid, m_gid, sizeof(m_gid));
+    header.payload_size = payload_size;
+}
+
 } // namespace rmw::iox2
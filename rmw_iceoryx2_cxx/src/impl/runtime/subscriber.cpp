@@ -9,10 +9,16 @@
 
 #include "rmw_iceoryx2_cxx/impl/runtime/subscriber.hpp"
 
+#include "rmw_iceoryx2_cxx/impl/common/create.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/error_message.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/log.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/names.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/qos.hpp"
 #include "rmw_iceoryx2_cxx/impl/middleware/iceoryx2.hpp"
 
+#include <algorithm>
+#include <functional>
+
 namespace rmw::iox2
 {
 
@@ -20,10 +26,14 @@ Subscriber::Subscriber(CreationLock,
                        iox::optional<ErrorType>& error,
                        Node& node,
                        const char* topic,
-                       const rosidl_message_type_support_t* type_support)
-    : m_topic{topic}
-    , m_typesupport{type_support}
-    , m_service_name{::rmw::iox2::names::topic(topic)} {
+                       const rosidl_message_type_support_t* type_support,
+                       const rmw_qos_profile_t& requested_qos)
+    : m_context{node.context()}
+    , m_topic{topic}
+    , m_message_type{::rmw::iox2::resolve(type_support)}
+    , m_service_name{::rmw::iox2::names::topic(topic)}
+    , m_service_name_hash{std::hash<std::string>{}(m_service_name)}
+    , m_qos{requested_qos} {
     auto iox2_service_name = Iceoryx2::ServiceName::create(m_service_name.c_str());
     if (iox2_service_name.has_error()) {
         RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(iox2_service_name.error()));
@@ -31,15 +41,18 @@ Subscriber::Subscriber(CreationLock,
         return;
     }
 
+    const auto& settings = node.context().topic_config().settings(m_topic);
     auto iox2_pubsub_service = node.iox2()
                                    .ipc()
                                    .service_builder(iox2_service_name.value())
                                    .publish_subscribe<Payload>()
-                                   // TODO: make configurable
-                                   .max_publishers(64)
-                                   .max_subscribers(64)
-                                   .history_size(10)
-                                   .subscriber_max_buffer_size(10)
+                                   .user_header<UserHeader>()
+                                   .max_publishers(settings.max_publishers)
+                                   .max_subscribers(settings.max_subscribers)
+                                   .history_size(settings.history_size)
+                                   .subscriber_max_buffer_size(settings.subscriber_max_buffer_size)
+                                   .subscriber_max_borrowed_samples(settings.borrowed_samples())
+                                   .enable_safe_overflow(settings.safe_overflow)
                                    .payload_alignment(8) // All ROS2 messages have alignment 8. Maybe?
                                    .open_or_create();    // TODO: set attribute for ROS typename
     if (iox2_pubsub_service.has_error()) {
@@ -48,7 +61,15 @@ Subscriber::Subscriber(CreationLock,
         return;
     }
 
-    auto iox2_subscriber = iox2_pubsub_service.value().subscriber_builder().create();
+    // The depth is bounded by the buffer size of the service, which may have been created by another process
+    auto service_config = iox2_pubsub_service.value().static_config();
+    auto buffer_size = service_config.subscriber_max_buffer_size();
+    if (!qos::requests_keep_all(requested_qos)) {
+        buffer_size = std::clamp<uint64_t>(qos::requested_depth(requested_qos), 1, buffer_size);
+    }
+    // Subscribers buffering a single sample always take the newest one, thus only enabled via the configuration
+    m_keep_latest = settings.keep_latest;
+    auto iox2_subscriber = iox2_pubsub_service.value().subscriber_builder().buffer_size(buffer_size).create();
     if (iox2_subscriber.has_error()) {
         RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(iox2_subscriber.error()));
         error.emplace(ErrorType::SUBSCRIBER_CREATION_FAILURE);
@@ -56,6 +77,41 @@ Subscriber::Subscriber(CreationLock,
     }
     m_iox2_unique_id.emplace(iox2_subscriber->id());
     m_iox2_subscriber.emplace(std::move(iox2_subscriber.value()));
+
+    // iceoryx2 limits the number of samples held at once, thus they can be stored without allocating
+    m_registry.emplace(service_config.subscriber_max_borrowed_samples());
+
+    // Delivery is only guaranteed when publishers block instead of overwriting queued samples
+    const bool reliable = qos::requests_reliable(requested_qos) && !service_config.has_safe_overflow();
+    if (qos::requests_reliable(requested_qos) && !reliable) {
+        qos::log_reliability_downgrade(m_topic.c_str(), "subscription");
+    }
+    m_qos = qos::effective(requested_qos, buffer_size, reliable, service_config.history_size() > 0);
+    if (m_keep_latest) {
+        // Only the newest sample is taken regardless of the size of the queue, older queued samples are discarded
+        m_qos.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+        m_qos.depth = 1;
+        if (buffer_size > 1) {
+            m_qos.reliability = RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT;
+        }
+    }
+
+    // May be overridden by options passed on creation of the subscription
+    m_priority = settings.priority;
+
+    // Only opened if publishers of the topic suppress notifications, which requires the same configuration in all
+    // processes communicating on the topic
+    if (settings.suppress_idle_notifications && create_in_place(m_waiters, m_service_name).has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to open waiter count");
+        error.emplace(ErrorType::WAITER_COUNT_CREATION_FAILURE);
+        return;
+    }
+}
+
+Subscriber::~Subscriber() {
+    if (auto result = set_event_callback(nullptr, nullptr); result.has_error()) {
+        RMW_IOX2_LOG_ERROR("Failed to remove new-message callback of subscriber to %s", m_topic.c_str());
+    }
 }
 
 auto Subscriber::unique_id() -> const iox::optional<RawIdType>& {
@@ -68,29 +124,100 @@ auto Subscriber::topic() const -> const std::string& {
 }
 
 auto Subscriber::typesupport() const -> const rosidl_message_type_support_t* {
-    return m_typesupport;
+    return m_message_type.type_support;
+}
+
+auto Subscriber::message_type() const -> const MessageTypeSupport& {
+    return m_message_type;
 }
 
 auto Subscriber::service_name() const -> const std::string& {
     return m_service_name;
 }
 
-auto Subscriber::take_copy(void* dest) -> iox::expected<bool, ErrorType> {
+auto Subscriber::service_name_hash() const -> size_t {
+    return m_service_name_hash;
+}
+
+auto Subscriber::waiters() -> WaiterCount* {
+    return m_waiters.has_value() ? &m_waiters.value() : nullptr;
+}
+
+auto Subscriber::qos() const -> const rmw_qos_profile_t& {
+    return m_qos;
+}
+
+auto Subscriber::lifetime() const -> const Lifetime& {
+    return m_lifetime;
+}
+
+auto Subscriber::keep_latest() const -> bool {
+    return m_keep_latest;
+}
+
+auto Subscriber::priority() const -> Priority {
+    return m_priority;
+}
+
+auto Subscriber::set_priority(Priority priority) -> void {
+    m_priority = priority;
+}
+
+auto Subscriber::set_event_callback(rmw_event_callback_t callback,
+                                    const void* user_data) -> iox::expected<void, ErrorType> {
+    using iox::err;
+    using iox::ok;
+
+    // Executors clear the callback of every subscription they release, do not start the dispatcher for that
+    if (callback == nullptr && !m_event_callback_set) {
+        return ok();
+    }
+
+    auto dispatcher = m_context.event_dispatcher();
+    if (dispatcher.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve event dispatcher");
+        return err(ErrorType::EVENT_CALLBACK_FAILURE);
+    }
+    if (auto result = dispatcher.value()->set_callback(*this, callback, user_data); result.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to register new-message callback");
+        return err(ErrorType::EVENT_CALLBACK_FAILURE);
+    }
+    m_event_callback_set = callback != nullptr;
+    return ok();
+}
+
+auto Subscriber::has_samples() -> iox::expected<bool, ErrorType> {
+    using iox::err;
+    using iox::ok;
+
+    std::lock_guard<std::mutex> lock{m_port_mutex};
+    if (auto result = m_iox2_subscriber->has_samples(); result.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(result.error()));
+        return err(ErrorType::RECV_FAILURE);
+    } else {
+        return ok(result.value());
+    }
+}
+
+auto Subscriber::take_copy(void* dest, UserHeader* header) -> iox::expected<bool, ErrorType> {
     using iox::err;
     using iox::nullopt;
     using iox::ok;
     using iox::optional;
 
-    if (auto result = m_iox2_subscriber->receive(); result.has_error()) {
+    // Held until the sample is dropped at the end of the scope
+    std::lock_guard<std::mutex> lock{m_port_mutex};
+    if (auto result = receive(); result.has_error()) {
         RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(result.error()));
         return err(ErrorType::RECV_FAILURE);
     } else {
         auto sample = std::move(result.value());
 
         if (sample.has_value()) {
-            auto payload = sample.value().payload();
-            auto number_of_bytes = payload.number_of_bytes();
-            std::memcpy(dest, payload.data(), number_of_bytes);
+            std::memcpy(dest, sample.value().payload().data(), message_size(sample.value()));
+            if (header != nullptr) {
+                *header = sample.value().user_header();
+            }
         }
 
         return ok(sample.has_value());
@@ -103,36 +230,135 @@ auto Subscriber::take_loan() -> iox::expected<iox::optional<SubscriberLoan>, Err
     using iox::ok;
     using iox::optional;
 
-    auto result = m_iox2_subscriber->receive();
+    std::unique_lock<std::mutex> lock{m_port_mutex};
+    auto result = receive();
+    lock.unlock();
     if (result.has_error()) {
-        RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(result.error()));
+        auto statistics = m_registry->statistics();
+        RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING("%s (%zu of %zu loans held, oldest held for %lld ns)",
+                                                    ::iox::into<const char*>(result.error()),
+                                                    statistics.outstanding,
+                                                    statistics.capacity,
+                                                    static_cast<long long>(statistics.oldest_loan_age.count()));
         return err(ErrorType::RECV_FAILURE);
     }
     auto sample = std::move(result.value());
 
     if (sample.has_value()) {
         auto data = sample->payload().data();
-        auto number_of_bytes = sample->payload().number_of_bytes();
-        m_registry.store(std::move(sample.value()));
+        auto number_of_bytes = message_size(sample.value());
+        auto header = sample->user_header();
+        if (m_registry->store(std::move(sample.value())).has_error()) {
+            lock.lock();
+            Iceoryx2::InterProcess::drop(std::move(sample.value()));
+            RMW_IOX2_CHAIN_ERROR_MSG("exceeded the maximum number of borrowed samples");
+            return err(ErrorType::RECV_FAILURE);
+        }
 
         // Const cast required because of RMW API
-        return ok(optional<SubscriberLoan>({const_cast<uint8_t*>(data), number_of_bytes}));
+        return ok(optional<SubscriberLoan>({const_cast<uint8_t*>(data), number_of_bytes, header}));
     } else {
         return ok(optional<SubscriberLoan>{nullopt});
     }
 }
 
+auto Subscriber::take_loans(void** loaned_memory, size_t count) -> iox::expected<size_t, ErrorType> {
+    using iox::err;
+    using iox::ok;
+
+    // Bounded by the free slots of the registry, which has the capacity iceoryx2 permits to be borrowed at once
+    auto statistics = m_registry->statistics();
+    count = std::min(count, statistics.capacity - std::min(statistics.outstanding, statistics.capacity));
+
+    std::lock_guard<std::mutex> lock{m_port_mutex};
+    size_t taken{0};
+    while (taken < count) {
+        auto result = receive();
+        if (result.has_error()) {
+            RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(result.error()));
+            if (taken == 0) {
+                return err(ErrorType::RECV_FAILURE);
+            }
+            break;
+        }
+        auto sample = std::move(result.value());
+        if (!sample.has_value()) {
+            break;
+        }
+
+        auto stored = m_registry->store(std::move(sample.value()));
+        if (stored.has_error()) {
+            // Only possible when loaning concurrently from other threads
+            Iceoryx2::InterProcess::drop(std::move(sample.value()));
+            RMW_IOX2_CHAIN_ERROR_MSG("exceeded the maximum number of borrowed samples");
+            if (taken == 0) {
+                return err(ErrorType::RECV_FAILURE);
+            }
+            break;
+        }
+        loaned_memory[taken] = stored.value();
+        taken++;
+    }
+    return ok(taken);
+}
+
+auto Subscriber::return_loans(void* const* loaned_memory, size_t count) -> iox::expected<void, ErrorType> {
+    using ::iox::err;
+    using ::iox::ok;
+
+    std::lock_guard<std::mutex> lock{m_port_mutex};
+    auto released = m_registry->release_all(
+        loaned_memory, count, [](auto&& sample) { Iceoryx2::InterProcess::drop(std::move(sample)); });
+    if (released < count) {
+        RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING("%zu of %zu pointers are not loans", count - released, count);
+        return err(ErrorType::INVALID_PAYLOAD);
+    }
+    return ok();
+}
+
 auto Subscriber::return_loan(void* loaned_memory) -> iox::expected<void, ErrorType> {
     using ::iox::err;
     using ::iox::ok;
 
-    if (auto result = m_registry.release(static_cast<uint8_t*>(loaned_memory)); result.has_error()) {
-        switch (result.error()) {
+    auto sample = m_registry->release(static_cast<uint8_t*>(loaned_memory));
+    if (sample.has_error()) {
+        switch (sample.error()) {
         case SampleRegistryError::INVALID_PAYLOAD:
+        case SampleRegistryError::CAPACITY_EXCEEDED:
             return err(ErrorType::INVALID_PAYLOAD);
         }
     }
+
+    std::lock_guard<std::mutex> lock{m_port_mutex};
+    Iceoryx2::InterProcess::drop(std::move(sample.value()));
     return ok();
 }
 
+auto Subscriber::loan_statistics() const -> LoanStatistics {
+    return m_registry->statistics();
+}
+
+auto Subscriber::receive() -> ReceiveResult {
+    auto result = m_iox2_subscriber->receive();
+    if (!m_keep_latest) {
+        return result;
+    }
+
+    while (!result.has_error() && result.value().has_value()) {
+        auto newer = m_iox2_subscriber->has_samples();
+        if (newer.has_error() || !newer.value()) {
+            break;
+        }
+        // Released before receiving the next, so that only one sample is held at a time
+        result.value().reset();
+        result = m_iox2_subscriber->receive();
+    }
+    return result;
+}
+
+auto Subscriber::message_size(const IceoryxSample& sample) -> size_t {
+    auto payload_size = sample.payload().number_of_bytes();
+    return static_cast<size_t>(std::min<uint64_t>(sample.user_header().payload_size, payload_size));
+}
+
 } // namespace rmw::iox2
@@ -0,0 +1,243 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#include "rmw_iceoryx2_cxx/impl/runtime/waiter_count.hpp"
+
+#include "rmw_iceoryx2_cxx/impl/common/error_message.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rmw::iox2
+{
+
+namespace
+{
+
+/// Only accessible by the user owning the processes, like the resources of iceoryx2
+constexpr mode_t PERMISSIONS{0600};
+
+/// Holds the exclusive lock on a shared memory object for the duration of a scope
+class ExclusiveLock
+{
+public:
+    explicit ExclusiveLock(int fd)
+        : m_fd{fd} {
+        while (flock(m_fd, LOCK_EX) != 0 && errno == EINTR) {
+        }
+    }
+    ExclusiveLock(const ExclusiveLock&) = delete;
+    ExclusiveLock(ExclusiveLock&&) = delete;
+    ExclusiveLock& operator=(const ExclusiveLock&) = delete;
+    ExclusiveLock& operator=(ExclusiveLock&&) = delete;
+    ~ExclusiveLock() {
+        flock(m_fd, LOCK_UN);
+    }
+
+private:
+    int m_fd;
+};
+
+/// Describes the lock of the slot at the given index, i.e. the byte of the shared memory object at that offset
+auto slot_lock(size_t index, short type) -> struct flock {
+    struct flock lock{};
+    lock.l_type = type;
+    lock.l_whence = SEEK_SET;
+    lock.l_start = static_cast<off_t>(index);
+    lock.l_len = 1;
+    return lock;
+}
+
+/// Decrements the counter unless it is zero, so that unbalanced decrements do not wrap around
+auto decrement_if_positive(std::atomic<uint32_t>& counter) -> bool {
+    auto value = counter.load(std::memory_order_relaxed);
+    while (value > 0) {
+        if (counter.compare_exchange_weak(value, value - 1, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+WaiterCount::WaiterCount(CreationLock, iox::optional<ErrorType>& error, const std::string& service_name)
+    : m_name{shared_memory_name(service_name)} {
+    static_assert(std::atomic<uint32_t>::is_always_lock_free,
+                  "the count must be lock-free to be shared between processes");
+
+    // The object is unlinked by the last instance while holding its lock. An object unlinked after opening but before
+    // locking it is no longer shared, thus opening is retried.
+    while (true) {
+        m_fd = shm_open(m_name.c_str(), O_RDWR | O_CREAT, PERMISSIONS);
+        if (m_fd < 0) {
+            RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING(
+                "failed to open shared memory '%s': %s", m_name.c_str(), std::strerror(errno));
+            error.emplace(ErrorType::SHARED_MEMORY_FAILURE);
+            return;
+        }
+        ExclusiveLock lock{m_fd};
+
+        struct stat status{};
+        if (fstat(m_fd, &status) != 0) {
+            RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING(
+                "failed to inspect shared memory '%s': %s", m_name.c_str(), std::strerror(errno));
+            error.emplace(ErrorType::SHARED_MEMORY_FAILURE);
+            return;
+        }
+        if (status.st_nlink == 0) {
+            close(m_fd);
+            m_fd = -1;
+            continue;
+        }
+
+        // Sized by the creator while holding the lock, the initial contents are zero
+        if (static_cast<size_t>(status.st_size) < sizeof(Segment) && ftruncate(m_fd, sizeof(Segment)) != 0) {
+            RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING(
+                "failed to size shared memory '%s': %s", m_name.c_str(), std::strerror(errno));
+            error.emplace(ErrorType::SHARED_MEMORY_FAILURE);
+            return;
+        }
+
+        auto* memory = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (memory == MAP_FAILED) {
+            RMW_IOX2_CHAIN_ERROR_MSG_WITH_FORMAT_STRING(
+                "failed to map shared memory '%s': %s", m_name.c_str(), std::strerror(errno));
+            error.emplace(ErrorType::SHARED_MEMORY_FAILURE);
+            return;
+        }
+        m_segment = static_cast<Segment*>(memory);
+
+        reclaim_stale_slots();
+        claim_slot();
+        return;
+    }
+}
+
+WaiterCount::~WaiterCount() {
+    if (m_fd < 0) {
+        return;
+    }
+    if (m_segment != nullptr) {
+        ExclusiveLock lock{m_fd};
+        if (m_slot != nullptr) {
+            release(*m_slot);
+        }
+        reclaim_stale_slots();
+
+        // Removed with the last instance on the host, the next instance starts out with a new object
+        if (std::none_of(std::begin(m_segment->slots), std::end(m_segment->slots), [](const Slot& slot) {
+                return slot.claimed.load(std::memory_order_relaxed) != 0;
+            })) {
+            shm_unlink(m_name.c_str());
+        }
+        munmap(m_segment, sizeof(Segment));
+    }
+    close(m_fd);
+}
+
+auto WaiterCount::arm() -> void {
+    if (m_slot != nullptr) {
+        m_slot->waiting.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_segment->waiting.fetch_add(1, std::memory_order_relaxed);
+    // Orders the increment before the subsequent check for samples, pairs with the fence in any_waiting()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+auto WaiterCount::disarm() -> void {
+    // The slot is only decremented if armed, the total along with it
+    if (m_slot != nullptr && !decrement_if_positive(m_slot->waiting)) {
+        return;
+    }
+    decrement_if_positive(m_segment->waiting);
+}
+
+auto WaiterCount::any_waiting() const -> bool {
+    // Orders the preceding send before reading the count, pairs with the fence in arm()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return m_segment->waiting.load(std::memory_order_relaxed) > 0;
+}
+
+auto WaiterCount::shared_memory_name(const std::string& service_name) -> std::string {
+    // Service names contain slashes and may exceed the length permitted for shared memory objects, thus are hashed.
+    // FNV-1a is used as it yields the same name in every process. Colliding hashes only cause additional
+    // notifications. The name uses the prefix of iceoryx2 and is namespaced by user, as the object is only
+    // accessible by its owner.
+    uint64_t hash{0xcbf29ce484222325ULL};
+    for (auto c : service_name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    char name[64];
+    std::snprintf(name,
+                  sizeof(name),
+                  "/iox2_rmw_waiters_%u_%016llx",
+                  static_cast<unsigned>(getuid()),
+                  static_cast<unsigned long long>(hash));
+    return name;
+}
+
+auto WaiterCount::claim_slot() -> void {
+    // Locks of open file descriptions are owned by the instance rather than by its process or thread, thus conflict
+    // with the locks of other instances in the same process and are kept when the creating thread exits
+    for (size_t index = 0; index < SLOT_COUNT; index++) {
+        auto lock = slot_lock(index, F_WRLCK);
+        if (fcntl(m_fd, F_OFD_SETLK, &lock) != 0) {
+            continue;
+        }
+        auto& slot = m_segment->slots[index];
+        if (slot.claimed.load(std::memory_order_relaxed) != 0) {
+            // Claimed by an instance that no longer exists
+            release(slot);
+        }
+        slot.waiting.store(0, std::memory_order_relaxed);
+        slot.claimed.store(1, std::memory_order_relaxed);
+        m_slot = &slot;
+        return;
+    }
+    // Waiters arming without a slot cannot be reclaimed if their process terminates, which only causes notifications
+    // to be sent unnecessarily
+}
+
+auto WaiterCount::is_held(size_t index) const -> bool {
+    auto lock = slot_lock(index, F_WRLCK);
+    if (fcntl(m_fd, F_OFD_GETLK, &lock) != 0) {
+        // Considered held, as reclaiming the slot of an existing instance would lose its wakeups
+        return true;
+    }
+    return lock.l_type != F_UNLCK;
+}
+
+auto WaiterCount::release(Slot& slot) -> void {
+    auto waiting = slot.waiting.exchange(0, std::memory_order_relaxed);
+    for (; waiting > 0 && decrement_if_positive(m_segment->waiting); waiting--) {
+    }
+    slot.claimed.store(0, std::memory_order_relaxed);
+}
+
+auto WaiterCount::reclaim_stale_slots() -> void {
+    for (size_t index = 0; index < SLOT_COUNT; index++) {
+        auto& slot = m_segment->slots[index];
+        if (&slot != m_slot && slot.claimed.load(std::memory_order_relaxed) != 0 && !is_held(index)) {
+            release(slot);
+        }
+    }
+}
+
+} // namespace rmw::iox2
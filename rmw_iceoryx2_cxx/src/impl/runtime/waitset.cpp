@@ -11,14 +11,21 @@
 
 #include "iox2/callback_progression.hpp"
 #include "iox2/waitset.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/create.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/error_message.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/log.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/names.hpp"
+
+#include <algorithm>
+#include <chrono>
 
 namespace rmw::iox2
 {
 
 WaitSet::WaitSet(CreationLock, iox::optional<WaitSetError>& error, Context& context)
-    : m_context{context} {
+    : m_context{context}
+    , m_spin_budget{context.waitset_spin_budget()}
+    , m_prioritization{context.waitset_prioritization()} {
     auto waitset = Iceoryx2::WaitSet::create();
     if (waitset.has_error()) {
         RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(waitset.error()));
@@ -26,17 +33,35 @@ WaitSet::WaitSet(CreationLock, iox::optional<WaitSetError>& error, Context& cont
         return;
     }
     m_waitset.emplace(std::move(waitset.value()));
+
+    if (create_in_place(m_waker, context.iox2(), names::waitset(context.id(), context.generate_waitset_id()))
+            .has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to create waker");
+        error.emplace(ErrorType::LISTENER_CREATION_FAILURE);
+        return;
+    }
+
+    auto guard = m_waitset->attach_notification(m_waker->listener().file_descriptor());
+    if (guard.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(guard.error()));
+        error.emplace(ErrorType::ATTACHMENT_FAILURE);
+        return;
+    }
+    m_waker_attachment.emplace(std::move(guard.value()));
 }
 
 auto WaitSet::map(RmwIndex rmw_index, GuardCondition& guard_condition) -> iox::expected<void, WaitSetError> {
     using ::iox::err;
     using ::iox::ok;
 
-    if (auto result = get_storage_index<GuardConditionListener>(guard_condition.service_name()); result.has_error()) {
+    if (auto result = get_storage_handle<GuardConditionListener>(guard_condition.service_name(),
+                                                                 guard_condition.service_name_hash());
+        result.has_error()) {
         return err(result.error());
     } else {
-        auto storage_index = result.value();
-        map_stored_listener(WaitableEntity::GUARD_CONDITION, storage_index, rmw_index);
+        auto storage_handle = result.value();
+        map_stored_listener<GuardConditionListener>(
+            WaitableEntity::GUARD_CONDITION, storage_handle, rmw_index, guard_condition);
         return ok();
     }
 }
@@ -45,41 +70,51 @@ auto WaitSet::map(RmwIndex rmw_index, Subscriber& subscriber) -> iox::expected<v
     using ::iox::err;
     using ::iox::ok;
 
-    if (auto result = get_storage_index<SubscriberListener>(subscriber.service_name()); result.has_error()) {
+    if (auto result = get_storage_handle<SubscriberListener>(subscriber.service_name(), subscriber.service_name_hash());
+        result.has_error()) {
         return err(result.error());
     } else {
-        auto storage_index = result.value();
-        map_stored_listener(WaitableEntity::SUBSCRIBER, storage_index, rmw_index);
+        auto storage_handle = result.value();
+        map_stored_listener<SubscriberListener>(WaitableEntity::SUBSCRIBER, storage_handle, rmw_index, subscriber);
         return ok();
     }
 }
 
-auto WaitSet::map_stored_listener(WaitableEntity waitable_type,
-                                  StorageIndex storage_index,
-                                  RmwIndex rmw_index) -> void {
-    auto it = std::find_if(m_mapping.begin(), m_mapping.end(), [waitable_type, storage_index](const auto& staged) {
-        return staged.waitable_type == waitable_type && staged.storage_index == storage_index;
-    });
-
-    if (it == m_mapping.end()) {
-        m_mapping.push_back(RmwMapping{waitable_type, storage_index, rmw_index});
-    }
-}
-
 auto WaitSet::unmap_all() -> void {
     // Detaching removes the mapping, but the listener remains in the storage for re-use in subsequent calls.
+    // Attachments are only dropped in the next wait call if the listener is not mapped again by then.
     m_mapping.clear();
+    ++m_mapping_round;
+}
+
+auto WaitSet::wait(const iox::optional<Duration>& timeout) -> iox::expected<size_t, ErrorType> {
+    using ::iox::err;
+    using ::iox::ok;
+
+    // Waiting ends the executor cycle, notify subscribers of the samples published during it. Publishers only defer
+    // notifications on threads that wait, as only these flush them again.
+    m_context.mark_waiting_thread();
+    m_context.flush_deferred_notifications();
+
+    auto result = wait_for_triggers(timeout);
+    if (result.has_error()) {
+        return err(result.error());
+    }
+    return ok(m_prioritization ? defer_lower_priorities(result.value()) : result.value());
 }
 
-auto WaitSet::wait(const iox::optional<Duration>& timeout) -> iox::expected<std::vector<TriggeredWaitable>, ErrorType> {
+auto WaitSet::wait_for_triggers(const iox::optional<Duration>& timeout) -> iox::expected<size_t, ErrorType> {
     using ::iox::err;
     using ::iox::ok;
     using ::iox2::CallbackProgression;
 
+    // Discard the results of the previous wait call
+    clear_triggered();
+
     if (m_mapping.empty()) {
         if (zero_timeout(timeout)) {
             // This is a NOOP.
-            return ok(std::vector<TriggeredWaitable>{});
+            return ok(static_cast<size_t>(0));
         }
         if (no_timeout(timeout)) {
             // Trying to wait indefinitely with nothing mapped.
@@ -88,61 +123,200 @@ auto WaitSet::wait(const iox::optional<Duration>& timeout) -> iox::expected<std:
         }
     }
 
-    // Context for this specific wait call.
-    // Cleaned up automatically at end of scope, detaching all attachments from the waitset.
-    WaitContext ctx;
+    // Attach listeners mapped since the previous wait call and detach those no longer mapped
+    if (auto result = update_attachments(); result.has_error()) {
+        return err(result.error());
+    }
 
-    // Attach the timeout to the waitset
+    // Return immediately if data is already available e.g. samples remaining from a previous notification
+    if (auto triggered_count = poll_mapped(); triggered_count > 0) {
+        return ok(triggered_count);
+    }
+
+    // The deadline covers the remainder of the call, including time spent spinning and waits resumed after wakeups
+    iox::optional<Deadline> deadline;
     if (timeout.has_value()) {
-        if (auto result = attach_timeout(timeout.value(), ctx); result.has_error()) {
-            return err(result.error());
+        deadline.emplace(std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeout->toNanoseconds()));
+    }
+
+    // In hybrid mode, poll the mapped entities for data before blocking
+    if (m_spin_budget > Duration::zero() && !zero_timeout(timeout)) {
+        auto budget = no_timeout(timeout) ? m_spin_budget : std::min(m_spin_budget, timeout.value());
+        if (auto triggered_count = spin(budget); triggered_count > 0) {
+            return ok(triggered_count);
         }
     }
 
-    // Attached all previously mapped listeners
-    if (auto result = attach_mapped_listeners(ctx); result.has_error()) {
-        return err(result.error());
+    // Register as blocked with the publishers of the mapped subscribers, which may skip notifying otherwise. Samples
+    // sent before registering may thus not have been notified, check for them once more before blocking.
+    ArmedSubscribers armed{*this};
+    if (auto triggered_count = poll_mapped(); triggered_count > 0) {
+        return ok(triggered_count);
     }
 
-    // Callback to process events received on listeners attached to waitset
-    auto on_event = [this, &ctx](auto id) -> CallbackProgression {
-        // Check for timeout
-        if (ctx.attached_timeout.has_value() && ctx.attached_timeout->id() == id) {
-            return CallbackProgression::Stop;
-        }
-
-        // Find the triggered attachment
-        for (const auto& attachment : ctx.attached_listeners) {
-            if (attachment.id() == id) {
-                // This waitable was triggered. Drain all events. The number of triggers is irrelevant.
-                if (auto result =
-                        process_trigger(attachment.mapping().waitable_type, attachment.mapping().storage_index);
-                    result.has_error()) {
-                    RMW_IOX2_LOG_ERROR("Failed to process trigger from a waitset attachment");
-                    // Continue checking for other triggers even on error
-                    return CallbackProgression::Continue;
-                } else {
-                    ctx.result.push_back(TriggeredWaitable{attachment.mapping()});
-                    // Continue checking for other triggers after finding one
-                    return CallbackProgression::Continue;
+    while (true) {
+        // Context for this specific blocking wait.
+        WaitContext ctx;
+
+        // Callback to process events received on listeners attached to waitset
+        auto on_event = [this, &ctx](auto id) -> CallbackProgression {
+            // Check for a wakeup by the listener registry on events of the mapped subscribers
+            if (m_waker_attachment->id() == id) {
+                if (auto result = m_waker->drain(); result.has_error()) {
+                    RMW_IOX2_LOG_ERROR("Failed to process wakeup of the waitset");
                 }
+                ctx.woken = true;
+                return CallbackProgression::Continue;
             }
+
+            // Find the triggered mappings, a listener may be mapped to multiple RMW indices
+            auto [first, last] = find_mappings(id);
+            if (first == last) {
+                RMW_IOX2_LOG_ERROR("Waitset was triggered by an unmapped subscriber or guard condition");
+                // Continue checking for other triggers, also so as not to hinder functionality on unexpected triggers.
+                return CallbackProgression::Continue;
+            }
+
+            // This waitable was triggered. Drain all events once. The number of triggers is irrelevant.
+            const auto& triggered = m_mapping[first->mapping_index];
+            if (auto result = process_trigger(triggered.waitable_type, triggered.storage_handle); result.has_error()) {
+                RMW_IOX2_LOG_ERROR("Failed to process trigger from a waitset attachment");
+                // Continue checking for other triggers even on error
+                return CallbackProgression::Continue;
+            }
+            if (triggered.waitable_type == WaitableEntity::SUBSCRIBER) {
+                // Subscribers of the same service are reported if they hold samples, which may already have been
+                // taken by another waitset mapping the same subscriber. Waiting continues if none does.
+                for (auto entry = first; entry != last; ++entry) {
+                    if (poll(m_mapping[entry->mapping_index])) {
+                        record_trigger(m_mapping[entry->mapping_index]);
+                        ctx.triggered_count++;
+                    }
+                }
+                ctx.woken = true;
+                return CallbackProgression::Continue;
+            }
+            // The trigger is reported by the event, consume the flag so that it is not reported again by polling
+            static_cast<GuardCondition*>(triggered.entity)->consume_trigger();
+            for (auto entry = first; entry != last; ++entry) {
+                record_trigger(m_mapping[entry->mapping_index]);
+                ctx.triggered_count++;
+            }
+            return CallbackProgression::Continue;
+        };
+
+        // Block until an attachment is triggered or the deadline is reached. If the deadline has already passed, only
+        // check for events and return immediately.
+        if (auto result = deadline.has_value()
+                              ? m_waitset->wait_and_process_once_with_timeout(on_event, time_until(deadline.value()))
+                              : m_waitset->wait_and_process_once(on_event);
+            result.has_error()) {
+            RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(result.error()));
+            return err(ErrorType::WAIT_FAILURE);
+        }
+
+        if (ctx.triggered_count > 0 || !ctx.woken) {
+            return ok(ctx.triggered_count);
         }
 
-        RMW_IOX2_LOG_ERROR("Waitset was triggered by an unmapped subscriber or guard condition");
-        // Continue looking for notifications from other attachments so as not to hinder functionality.
-        return CallbackProgression::Continue;
+        // Woken up by the listener registry, on failures of it or on listeners changed between exclusive and shared
+        if (!m_context.listener_registry().healthy()) {
+            RMW_IOX2_CHAIN_ERROR_MSG("listener registry failed to wait for events of shared subscribers");
+            return err(ErrorType::WAIT_FAILURE);
+        }
+        if (auto result = update_attachments(); result.has_error()) {
+            return err(result.error());
+        }
+
+        // Triggered subscribers are determined by their samples. The samples may already have been taken by another
+        // waitset mapping the same subscriber, in which case waiting continues.
+        if (auto triggered_count = poll_mapped(); triggered_count > 0) {
+            return ok(triggered_count);
+        }
+        if (deadline.has_value() && std::chrono::steady_clock::now() >= deadline.value()) {
+            return ok(static_cast<size_t>(0));
+        }
+    }
+}
+
+auto WaitSet::defer_lower_priorities(size_t triggered_count) -> size_t {
+    if (triggered_count == 0) {
+        return triggered_count;
+    }
+
+    auto is_triggered_subscriber = [this](const RmwMapping& mapping) {
+        return mapping.waitable_type == WaitableEntity::SUBSCRIBER
+               && is_triggered(mapping.waitable_type, mapping.rmw_index);
+    };
+    auto priority_of = [](const RmwMapping& mapping) {
+        return static_cast<const Subscriber*>(mapping.entity)->priority();
     };
 
-    // If timeout is non-zero, block and wait, otherwise check for events and return immediately.
-    if (auto result = no_timeout(timeout) ? m_waitset->wait_and_process_once(on_event)
-                                          : m_waitset->wait_and_process_once_with_timeout(on_event, timeout.value());
-        result.has_error()) {
-        RMW_IOX2_CHAIN_ERROR_MSG(::iox::into<const char*>(result.error()));
-        return err(ErrorType::WAIT_FAILURE);
+    // Determine the highest priority among the triggered subscribers
+    iox::optional<Subscriber::Priority> highest;
+    for (const auto& mapping : m_mapping) {
+        if (is_triggered_subscriber(mapping)) {
+            auto priority = priority_of(mapping);
+            highest.emplace(highest.has_value() ? std::max(highest.value(), priority) : priority);
+        }
+    }
+    if (!highest.has_value()) {
+        return triggered_count;
     }
 
-    return ok(ctx.result);
+    // Lower priority subscribers keep their samples and are reported again by the next wait call, unless they have
+    // been deferred too often in a row already
+    for (const auto& mapping : m_mapping) {
+        if (mapping.waitable_type != WaitableEntity::SUBSCRIBER) {
+            continue;
+        }
+        auto& deferral = m_deferrals[mapping.rmw_index];
+        if (!is_triggered_subscriber(mapping)) {
+            deferral.count = 0;
+        } else if (priority_of(mapping) < highest.value() && deferral.count < MAX_DEFERRALS) {
+            m_triggered_subscribers[mapping.rmw_index] = false;
+            deferral.count++;
+            triggered_count--;
+        } else {
+            deferral.count = 0;
+        }
+    }
+    return triggered_count;
+}
+
+auto WaitSet::is_triggered(WaitableEntity waitable_type, RmwIndex rmw_index) const -> bool {
+    const auto& triggered = waitable_type == WaitableEntity::GUARD_CONDITION ? m_triggered_guard_conditions
+                                                                             : m_triggered_subscribers;
+    return rmw_index < triggered.size() && triggered[rmw_index];
+}
+
+auto WaitSet::set_spin_budget(const Duration& spin_budget) -> void {
+    m_spin_budget = spin_budget;
+}
+
+auto WaitSet::spin_budget() const -> Duration {
+    return m_spin_budget;
+}
+
+auto WaitSet::set_prioritization(bool prioritization) -> void {
+    m_prioritization = prioritization;
+}
+
+auto WaitSet::prioritization() const -> bool {
+    return m_prioritization;
+}
+
+auto WaitSet::listener_count() const -> size_t {
+    return m_guard_condition_listeners.lookup.size() + m_subscriber_listeners.lookup.size();
+}
+
+auto WaitSet::triggered_storage(WaitableEntity waitable_type) -> std::vector<bool>& {
+    return waitable_type == WaitableEntity::GUARD_CONDITION ? m_triggered_guard_conditions : m_triggered_subscribers;
+}
+
+auto WaitSet::clear_triggered() -> void {
+    std::fill(m_triggered_guard_conditions.begin(), m_triggered_guard_conditions.end(), false);
+    std::fill(m_triggered_subscribers.begin(), m_triggered_subscribers.end(), false);
 }
 
 auto WaitSet::zero_timeout(const iox::optional<Duration>& timeout) const -> bool {
@@ -153,34 +327,108 @@ auto WaitSet::no_timeout(const iox::optional<Duration>& timeout) const -> bool {
     return !timeout.has_value();
 }
 
-auto WaitSet::attach_timeout(const Duration& timeout, WaitContext& ctx) -> ::iox::expected<void, ErrorType> {
-    using ::iox::err;
-    using ::iox::ok;
+auto WaitSet::spin(const Duration& budget) -> size_t {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(budget.toNanoseconds());
+    do {
+        if (auto triggered_count = poll_mapped(); triggered_count > 0) {
+            return triggered_count;
+        }
+    } while (std::chrono::steady_clock::now() < deadline);
+    return 0;
+}
 
-    auto guard = m_waitset->attach_interval(timeout);
-    if (guard.has_error()) {
-        return err(ErrorType::ATTACHMENT_FAILURE);
+auto WaitSet::poll_mapped() -> size_t {
+    size_t triggered_count{0};
+    for (const auto& mapping : m_mapping) {
+        if (poll(mapping)) {
+            // Drain the pending events of guard conditions so that the consumed trigger does not wake up a subsequent
+            // blocking wait. Subscriber events wake up the blocking wait, which continues if no samples remain.
+            if (mapping.waitable_type == WaitableEntity::GUARD_CONDITION) {
+                if (auto result = process_trigger(mapping.waitable_type, mapping.storage_handle); result.has_error()) {
+                    RMW_IOX2_LOG_ERROR("Failed to process trigger from a polled waitable");
+                }
+            }
+            record_trigger(mapping);
+            triggered_count++;
+        }
     }
-    ctx.attached_timeout.emplace(std::move(guard.value()));
-    return ok();
+    return triggered_count;
 }
 
-auto WaitSet::attach_mapped_listeners(WaitContext& ctx) -> iox::expected<void, ErrorType> {
+auto WaitSet::poll(const RmwMapping& mapping) -> bool {
+    switch (mapping.waitable_type) {
+    case WaitableEntity::GUARD_CONDITION:
+        return static_cast<GuardCondition*>(mapping.entity)->consume_trigger();
+    case WaitableEntity::SUBSCRIBER: {
+        auto result = static_cast<Subscriber*>(mapping.entity)->has_samples();
+        return result.has_value() && result.value();
+    }
+    default:
+        return false;
+    }
+}
+
+auto WaitSet::record_trigger(const RmwMapping& mapping) -> void {
+    triggered_storage(mapping.waitable_type)[mapping.rmw_index] = true;
+}
+
+WaitSet::ArmedSubscribers::ArmedSubscribers(WaitSet& waitset)
+    : m_waitset{waitset} {
+    for (const auto& mapping : m_waitset.m_mapping) {
+        if (mapping.waitable_type == WaitableEntity::SUBSCRIBER) {
+            if (auto* waiters = static_cast<Subscriber*>(mapping.entity)->waiters(); waiters != nullptr) {
+                waiters->arm();
+            }
+            if (auto listener = m_waitset.get_stored_listener<SubscriberListener>(mapping.storage_handle);
+                listener.has_value()) {
+                listener.value()->listener.arm();
+            }
+        }
+    }
+}
+
+WaitSet::ArmedSubscribers::~ArmedSubscribers() {
+    for (const auto& mapping : m_waitset.m_mapping) {
+        if (mapping.waitable_type == WaitableEntity::SUBSCRIBER) {
+            if (auto listener = m_waitset.get_stored_listener<SubscriberListener>(mapping.storage_handle);
+                listener.has_value()) {
+                listener.value()->listener.disarm();
+            }
+            if (auto* waiters = static_cast<Subscriber*>(mapping.entity)->waiters(); waiters != nullptr) {
+                waiters->disarm();
+            }
+        }
+    }
+}
+
+auto WaitSet::time_until(const Deadline& deadline) const -> Duration {
+    auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+        return Duration::zero();
+    }
+    return Duration::fromNanoseconds(
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count()));
+}
+
+auto WaitSet::update_attachments() -> iox::expected<void, ErrorType> {
     using ::iox::err;
     using ::iox::ok;
 
-    for (const auto& staged : m_mapping) {
-        auto result = attach_mapped_listener(staged);
-        if (result.has_error()) {
+    for (const auto& mapping : m_mapping) {
+        if (auto result = attach_mapped_listener(mapping); result.has_error()) {
             RMW_IOX2_CHAIN_ERROR_MSG("failed to attach mapped listeners to waitset");
             return err(result.error());
         }
-        ctx.attached_listeners.push_back(std::move(result.value()));
     }
+
+    release_unmapped_listeners<GuardConditionListener>();
+    release_unmapped_listeners<SubscriberListener>();
+
+    index_attachments();
     return ok();
 }
 
-auto WaitSet::attach_mapped_listener(const RmwMapping& mapping) -> iox::expected<AttachmentDetails, ErrorType> {
+auto WaitSet::attach_mapped_listener(const RmwMapping& mapping) -> iox::expected<void, ErrorType> {
     using ::iox::err;
     using ::iox::ok;
 
@@ -195,8 +443,42 @@ auto WaitSet::attach_mapped_listener(const RmwMapping& mapping) -> iox::expected
     }
 }
 
+auto WaitSet::index_attachments() -> void {
+    // Retains its capacity, thus waiting on an unchanged set of entities does not allocate
+    m_trigger_index.clear();
+    for (size_t mapping_index = 0; mapping_index < m_mapping.size(); mapping_index++) {
+        if (const auto* attachment = attachment_of(m_mapping[mapping_index]); attachment != nullptr) {
+            m_trigger_index.push_back(TriggerIndexEntry{&attachment->id(), mapping_index});
+        }
+    }
+    std::sort(m_trigger_index.begin(), m_trigger_index.end(), [](const auto& lhs, const auto& rhs) {
+        return *lhs.id < *rhs.id;
+    });
+}
+
+auto WaitSet::find_mappings(const AttachmentId& id) const
+    -> std::pair<TriggerIndex::const_iterator, TriggerIndex::const_iterator> {
+    auto entry_before = [](const TriggerIndexEntry& entry, const AttachmentId& key) { return *entry.id < key; };
+    auto key_before = [](const AttachmentId& key, const TriggerIndexEntry& entry) { return key < *entry.id; };
+
+    auto first = std::lower_bound(m_trigger_index.begin(), m_trigger_index.end(), id, entry_before);
+    auto last = std::upper_bound(first, m_trigger_index.end(), id, key_before);
+    return {first, last};
+}
+
+auto WaitSet::attachment_of(const RmwMapping& mapping) -> const AttachmentDetails* {
+    switch (mapping.waitable_type) {
+    case WaitableEntity::GUARD_CONDITION:
+        return attachment_of_impl<GuardConditionListener>(mapping.storage_handle);
+    case WaitableEntity::SUBSCRIBER:
+        return attachment_of_impl<SubscriberListener>(mapping.storage_handle);
+    default:
+        return nullptr;
+    }
+}
+
 auto WaitSet::process_trigger(const WaitableEntity waitable_type,
-                              const StorageIndex storage_index) -> iox::expected<void, ErrorType> {
+                              const StorageHandle& storage_handle) -> iox::expected<void, ErrorType> {
     using ::iox::err;
     using ::iox::ok;
 
@@ -213,7 +495,7 @@ auto WaitSet::process_trigger(const WaitableEntity waitable_type,
     // Retrieve the listener from the corresponding storage and drain all of its events
     switch (waitable_type) {
     case WaitableEntity::GUARD_CONDITION: {
-        if (auto result = get_stored_listener<GuardConditionListener>(storage_index); result.has_value()) {
+        if (auto result = get_stored_listener<GuardConditionListener>(storage_handle); result.has_value()) {
             auto& listener_details = result.value();
             if (auto result = drain_events(listener_details->listener); result.has_error()) {
                 return err(result.error());
@@ -225,11 +507,9 @@ auto WaitSet::process_trigger(const WaitableEntity waitable_type,
         break;
     }
     case WaitableEntity::SUBSCRIBER: {
-        if (auto result = get_stored_listener<SubscriberListener>(storage_index); result.has_value()) {
-            auto& listener_details = result.value();
-            if (auto result = drain_events(listener_details->listener); result.has_error()) {
-                return err(result.error());
-            }
+        // Only triggered if attached exclusively, waitsets sharing the listener and blocked on it are woken up
+        if (auto result = get_stored_listener<SubscriberListener>(storage_handle); result.has_value()) {
+            result.value()->listener.drain();
         } else {
             RMW_IOX2_CHAIN_ERROR_MSG("unable to find subscriber listener at provided index");
             return err(ErrorType::INVALID_STORAGE_INDEX);
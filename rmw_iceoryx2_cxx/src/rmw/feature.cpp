@@ -10,6 +10,10 @@
 #include "rmw/features.h"
 
 bool rmw_feature_supported(rmw_feature_t rmw_feature) {
-    static_cast<void>(rmw_feature);
-    return false;
+    switch (rmw_feature) {
+    case RMW_FEATURE_MESSAGE_INFO_PUBLICATION_SEQUENCE_NUMBER:
+        return true;
+    default:
+        return false;
+    }
 }
@@ -300,6 +300,7 @@ rmw_ret_t rmw_count_publishers(const rmw_node_t* rmw_node, const char* topic_nam
                               .ipc()
                               .service_builder(iox2_service_name.value())
                               .publish_subscribe<PublisherImpl::Payload>()
+                              .user_header<PublisherImpl::UserHeader>()
                               .open_or_create();
     if (service_result.has_error()) {
         RMW_IOX2_CHAIN_ERROR_MSG("failed to open service");
@@ -395,6 +396,7 @@ rmw_ret_t rmw_count_subscribers(const rmw_node_t* rmw_node, const char* topic_na
                               .ipc()
                               .service_builder(iox2_service_name.value())
                               .publish_subscribe<SubscriberImpl::Payload>()
+                              .user_header<SubscriberImpl::UserHeader>()
                               .open_or_create();
     if (service_result.has_error()) {
         RMW_IOX2_CHAIN_ERROR_MSG("failed to open service");
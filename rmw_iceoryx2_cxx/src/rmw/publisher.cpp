@@ -20,7 +20,69 @@
 #include "rmw_iceoryx2_cxx/impl/common/error_message.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/log.hpp"
 #include "rmw_iceoryx2_cxx/impl/message/introspection.hpp"
+#include "rmw_iceoryx2_cxx/impl/message/serialization.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/context.hpp"
+#include "rmw_iceoryx2_cxx/rmw/loan_statistics.hpp"
+#include "rmw_iceoryx2_cxx/rmw/publish_batch.hpp"
+#include "rmw_iceoryx2_cxx/rmw/segment_statistics.hpp"
+
+namespace
+{
+
+/// Serializes a message that is not self-contained into a loan and sends it, without notifying subscribers
+auto send_serialized(::rmw::iox2::Publisher& publisher, const void* ros_message) -> rmw_ret_t {
+    using ::rmw::iox2::serialize;
+    using ::rmw::iox2::serialized_message_size;
+    using ::rmw::iox2::SerializationError;
+
+    auto callbacks = publisher.message_type().callbacks;
+
+    // Speculatively loan as much as the largest message published so far and serialize in a single pass. Only
+    // messages that do not fit are sized, a full traversal of the message, and serialized into a new loan.
+    auto capacity = publisher.speculative_payload_size();
+    const bool speculative = capacity > 0;
+    if (!speculative) {
+        capacity = serialized_message_size(ros_message, callbacks);
+    }
+
+    auto loan = publisher.loan(capacity);
+    if (loan.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to loan bytes required for serialization");
+        return RMW_RET_ERROR;
+    }
+    auto serialized = serialize(ros_message, callbacks, static_cast<uint8_t*>(loan.value()), capacity);
+
+    if (speculative && serialized.has_error() && serialized.error() == SerializationError::INSUFFICIENT_CAPACITY) {
+        if (auto result = publisher.return_loan(loan.value()); result.has_error()) {
+            RMW_IOX2_CHAIN_ERROR_MSG("failed to return loan too small for serialization");
+            return RMW_RET_ERROR;
+        }
+        capacity = serialized_message_size(ros_message, callbacks);
+        loan = publisher.loan(capacity);
+        if (loan.has_error()) {
+            RMW_IOX2_CHAIN_ERROR_MSG("failed to loan bytes required for serialization");
+            return RMW_RET_ERROR;
+        }
+        serialized = serialize(ros_message, callbacks, static_cast<uint8_t*>(loan.value()), capacity);
+    }
+
+    if (serialized.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to serialize into loaned payload");
+        // Release the loan, the error of the serialization is reported
+        [[maybe_unused]] auto result = publisher.return_loan(loan.value());
+        return RMW_RET_ERROR;
+    }
+    // The loan may be larger than the message, only the serialized bytes are read by subscribers
+    auto number_of_bytes = static_cast<uint64_t>(serialized.value());
+    if (auto result = publisher.send_loan(loan.value(), number_of_bytes); result.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to send serialized payload");
+        return RMW_RET_ERROR;
+    }
+
+    return RMW_RET_OK;
+}
+
+} // namespace
 
 extern "C" {
 
@@ -50,8 +112,6 @@ rmw_publisher_t* rmw_create_publisher(const rmw_node_t* rmw_node,
     using ::rmw::iox2::create_in_place;
     using ::rmw::iox2::deallocate;
     using ::rmw::iox2::destruct;
-    using ::rmw::iox2::is_pod;
-    using ::rmw::iox2::message_size;
     using NodeImpl = ::rmw::iox2::Node;
     using PublisherImpl = ::rmw::iox2::Publisher;
     using ::rmw::iox2::unsafe_cast;
@@ -65,14 +125,6 @@ rmw_publisher_t* rmw_create_publisher(const rmw_node_t* rmw_node,
     }
     rmw_publisher->implementation_identifier = rmw_get_implementation_identifier();
 
-    if (is_pod(type_support)) {
-        rmw_publisher->can_loan_messages = true;
-    } else {
-        rmw_publisher->can_loan_messages = false;
-        RMW_IOX2_LOG_DEBUG("Message type '%s' is not self-contained. Loaning disabled.",
-                           type_support->get_type_description_func(type_support)->type_description.type_name.data);
-    }
-
     if (auto ptr = allocate_copy(topic_name); ptr.has_error()) {
         rmw_publisher_free(rmw_publisher);
         RMW_IOX2_CHAIN_ERROR_MSG("failed to allocate memory for topic name");
@@ -93,7 +145,8 @@ rmw_publisher_t* rmw_create_publisher(const rmw_node_t* rmw_node,
         RMW_IOX2_CHAIN_ERROR_MSG("failed to allocate memory for Publisher");
         return nullptr;
     } else {
-        if (create_in_place<PublisherImpl>(publisher_impl.value(), *node_impl.value(), topic_name, type_support)
+        if (create_in_place<PublisherImpl>(
+                publisher_impl.value(), *node_impl.value(), topic_name, type_support, *qos)
                 .has_error()) {
             destruct<PublisherImpl>(publisher_impl.value());
             deallocate<PublisherImpl>(publisher_impl.value());
@@ -103,6 +156,15 @@ rmw_publisher_t* rmw_create_publisher(const rmw_node_t* rmw_node,
         } else {
             rmw_publisher->data = publisher_impl.value();
         }
+
+        // Resolved on creation of the publisher
+        if (publisher_impl.value()->message_type().is_pod) {
+            rmw_publisher->can_loan_messages = true;
+        } else {
+            rmw_publisher->can_loan_messages = false;
+            RMW_IOX2_LOG_DEBUG("Message type '%s' is not self-contained. Loaning disabled.",
+                               type_support->get_type_description_func(type_support)->type_description.type_name.data);
+        }
     }
 
     return rmw_publisher;
@@ -140,7 +202,6 @@ rmw_publish(const rmw_publisher_t* rmw_publisher, const void* ros_message, rmw_p
 
     // Implementation -------------------------------------------------------------------------------
     using PublisherImpl = ::rmw::iox2::Publisher;
-    using ::rmw::iox2::serialized_message_size;
     using ::rmw::iox2::unsafe_cast;
 
     RMW_IOX2_LOG_DEBUG("Publishing to '%s'", rmw_publisher->topic_name);
@@ -161,28 +222,11 @@ rmw_publish(const rmw_publisher_t* rmw_publisher, const void* ros_message, rmw_p
         }
     } else {
         // Non-self-contained. Serialize message into payload.
-        auto type_support = publisher_impl.value()->typesupport();
-
-        // The serialized size of THIS specific message
-        auto serialized_size = serialized_message_size(ros_message, type_support);
-
-        auto loan = publisher_impl.value()->loan(serialized_size);
-        if (loan.has_error()) {
-            RMW_IOX2_CHAIN_ERROR_MSG("failed to loan bytes required for serialization");
-            return RMW_RET_ERROR;
+        if (auto result = send_serialized(*publisher_impl.value(), ros_message); result != RMW_RET_OK) {
+            return result;
         }
-
-        auto serialized_message = rmw_serialized_message_t{reinterpret_cast<uint8_t*>(loan.value()),
-                                                           serialized_size,
-                                                           serialized_size,
-                                                           rcutils_get_default_allocator()};
-
-        if (auto result = rmw_serialize(ros_message, type_support, &serialized_message); result != RMW_RET_OK) {
-            RMW_IOX2_CHAIN_ERROR_MSG("failed to serialize into loaned payload");
-            return RMW_RET_ERROR;
-        }
-        if (auto result = publisher_impl.value()->publish_loan(loan.value()); result.has_error()) {
-            RMW_IOX2_CHAIN_ERROR_MSG("failed to publish serialized payload");
+        if (auto result = publisher_impl.value()->notify(); result.has_error()) {
+            RMW_IOX2_CHAIN_ERROR_MSG("failed to notify subscribers of serialized payload");
             return RMW_RET_ERROR;
         }
     }
@@ -208,7 +252,6 @@ rmw_ret_t rmw_borrow_loaned_message(const rmw_publisher_t* rmw_publisher,
 
     // Implementation -------------------------------------------------------------------------------
     using PublisherImpl = ::rmw::iox2::Publisher;
-    using ::rmw::iox2::message_size;
     using ::rmw::iox2::unsafe_cast;
 
     RMW_IOX2_LOG_DEBUG("Borrowing loan from '%s'", rmw_publisher->topic_name);
@@ -219,7 +262,7 @@ rmw_ret_t rmw_borrow_loaned_message(const rmw_publisher_t* rmw_publisher,
         return RMW_RET_ERROR;
     }
 
-    auto loan = publisher_impl.value()->loan(message_size(publisher_impl.value()->typesupport()));
+    auto loan = publisher_impl.value()->loan(publisher_impl.value()->unserialized_size());
     if (loan.has_error()) {
         RMW_IOX2_CHAIN_ERROR_MSG("failed to loan memory for publisher payload");
         return RMW_RET_ERROR;
@@ -327,7 +370,15 @@ rmw_ret_t rmw_publisher_get_actual_qos(const rmw_publisher_t* rmw_publisher, rmw
     RMW_IOX2_ENSURE_NOT_NULL(qos, RMW_RET_INVALID_ARGUMENT);
 
     // Implementation -------------------------------------------------------------------------------
-    *qos = rmw_qos_profile_default;
+    using PublisherImpl = ::rmw::iox2::Publisher;
+    using ::rmw::iox2::unsafe_cast;
+
+    auto publisher_impl = unsafe_cast<PublisherImpl*>(rmw_publisher->data);
+    if (publisher_impl.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve Publisher");
+        return RMW_RET_ERROR;
+    }
+    *qos = publisher_impl.value()->qos();
 
     return RMW_RET_OK;
 }
@@ -371,4 +422,107 @@ rmw_ret_t rmw_publisher_get_network_flow_endpoints(const rmw_publisher_t* rmw_pu
                                                    rmw_network_flow_endpoint_array_t* network_flow_endpoint_array) {
     return RMW_RET_UNSUPPORTED;
 }
+
+rmw_ret_t rmw_iox2_publisher_get_loan_statistics(const rmw_publisher_t* rmw_publisher,
+                                                 rmw_iox2_loan_statistics_t* statistics) {
+    // Invariants ----------------------------------------------------------------------------------
+    RMW_IOX2_ENSURE_NOT_NULL(rmw_publisher, RMW_RET_INVALID_ARGUMENT);
+    RMW_IOX2_ENSURE_NOT_NULL(statistics, RMW_RET_INVALID_ARGUMENT);
+    RMW_IOX2_ENSURE_IMPLEMENTATION(rmw_publisher->implementation_identifier, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+    // Implementation -------------------------------------------------------------------------------
+    using PublisherImpl = ::rmw::iox2::Publisher;
+    using ::rmw::iox2::unsafe_cast;
+
+    auto publisher_impl = unsafe_cast<PublisherImpl*>(rmw_publisher->data);
+    if (publisher_impl.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve Publisher");
+        return RMW_RET_ERROR;
+    }
+
+    auto loan_statistics = publisher_impl.value()->loan_statistics();
+    statistics->capacity = loan_statistics.capacity;
+    statistics->outstanding = loan_statistics.outstanding;
+    statistics->high_water_mark = loan_statistics.high_water_mark;
+    statistics->oldest_loan_age_ns = static_cast<int64_t>(loan_statistics.oldest_loan_age.count());
+
+    return RMW_RET_OK;
+}
+
+rmw_ret_t rmw_iox2_publisher_get_segment_statistics(const rmw_publisher_t* rmw_publisher,
+                                                    rmw_iox2_segment_statistics_t* statistics) {
+    // Invariants ----------------------------------------------------------------------------------
+    RMW_IOX2_ENSURE_NOT_NULL(rmw_publisher, RMW_RET_INVALID_ARGUMENT);
+    RMW_IOX2_ENSURE_NOT_NULL(statistics, RMW_RET_INVALID_ARGUMENT);
+    RMW_IOX2_ENSURE_IMPLEMENTATION(rmw_publisher->implementation_identifier, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+    // Implementation -------------------------------------------------------------------------------
+    using PublisherImpl = ::rmw::iox2::Publisher;
+    using ::rmw::iox2::unsafe_cast;
+
+    auto publisher_impl = unsafe_cast<PublisherImpl*>(rmw_publisher->data);
+    if (publisher_impl.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve Publisher");
+        return RMW_RET_ERROR;
+    }
+
+    auto segment_statistics = publisher_impl.value()->segment_statistics();
+    statistics->max_slice_len = segment_statistics.max_slice_len;
+    statistics->payload_high_water_mark = segment_statistics.payload_high_water_mark;
+    statistics->resizes = segment_statistics.resizes;
+
+    return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_iox2_publish_batch(const rmw_publisher_t* rmw_publisher, const void* const* ros_messages, size_t count) {
+    // Invariants ----------------------------------------------------------------------------------
+    RMW_IOX2_ENSURE_NOT_NULL(rmw_publisher, RMW_RET_INVALID_ARGUMENT);
+    RMW_IOX2_ENSURE_IMPLEMENTATION(rmw_publisher->implementation_identifier, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+    RMW_IOX2_ENSURE_NOT_NULL(ros_messages, RMW_RET_INVALID_ARGUMENT);
+    for (size_t i = 0; i < count; i++) {
+        RMW_IOX2_ENSURE_NOT_NULL(ros_messages[i], RMW_RET_INVALID_ARGUMENT);
+    }
+
+    // Implementation -------------------------------------------------------------------------------
+    using PublisherImpl = ::rmw::iox2::Publisher;
+    using ::rmw::iox2::unsafe_cast;
+
+    RMW_IOX2_LOG_DEBUG("Publishing batch of %zu messages to '%s'", count, rmw_publisher->topic_name);
+
+    auto publisher_impl = unsafe_cast<PublisherImpl*>(rmw_publisher->data);
+    if (publisher_impl.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve Publisher");
+        return RMW_RET_ERROR;
+    }
+    auto publisher = publisher_impl.value();
+
+    if (rmw_publisher->can_loan_messages) {
+        // Self-contained. Copy messages into payloads.
+        if (auto result = publisher->publish_batch(ros_messages, count, publisher->unserialized_size());
+            result.has_error()) {
+            RMW_IOX2_CHAIN_ERROR_MSG("failed to publish batch of copies");
+            return RMW_RET_ERROR;
+        }
+        return RMW_RET_OK;
+    }
+
+    // Non-self-contained. Serialize messages into payloads, notifying subscribers of those sent before a failure.
+    rmw_ret_t ret{RMW_RET_OK};
+    size_t sent{0};
+    for (; sent < count; sent++) {
+        ret = send_serialized(*publisher, ros_messages[sent]);
+        if (ret != RMW_RET_OK) {
+            break;
+        }
+    }
+    if (sent > 0) {
+        if (auto result = publisher->notify(); result.has_error()) {
+            RMW_IOX2_CHAIN_ERROR_MSG("failed to notify subscribers of batch");
+            return RMW_RET_ERROR;
+        }
+    }
+
+    return ret;
+}
 }
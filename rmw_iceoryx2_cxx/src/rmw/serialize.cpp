@@ -11,9 +11,8 @@
 #include "rmw/rmw.h"
 #include "rmw_iceoryx2_cxx/impl/common/ensure.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/error_message.hpp"
+#include "rmw_iceoryx2_cxx/impl/message/serialization.hpp"
 #include "rosidl_typesupport_cpp/message_type_support.hpp"
-#include "rosidl_typesupport_fastrtps_cpp/identifier.hpp"
-#include "rosidl_typesupport_fastrtps_cpp/message_type_support.h"
 
 const char* const rmw_iox2_serialization_format = "iceoryx2";
 
@@ -40,39 +39,16 @@ rmw_ret_t rmw_serialize(const void* ros_message,
     RMW_IOX2_ENSURE_NOT_NULL(serialized_message, RMW_RET_INVALID_ARGUMENT);
 
     // Implementation -------------------------------------------------------------------------------
+    using ::rmw::iox2::serialize;
 
-    // Handle for fastrtps typesupport
-    const rosidl_message_type_support_t* handle =
-        get_message_typesupport_handle(type_support, rosidl_typesupport_fastrtps_cpp::typesupport_identifier);
-    if (!handle) {
-        RMW_IOX2_CHAIN_ERROR_MSG("failed to get typesupport handle");
-        return RMW_RET_ERROR;
-    }
-
-    // FastRTPS-specific callbacks
-    const message_type_support_callbacks_t* callbacks =
-        static_cast<const message_type_support_callbacks_t*>(handle->data);
-    if (!callbacks) {
-        RMW_IOX2_CHAIN_ERROR_MSG("failed to get typesupport callbacks");
-        return RMW_RET_ERROR;
-    }
-
-    // Prepare the buffer
-    auto fast_buffer = eprosima::fastcdr::FastBuffer(reinterpret_cast<char*>(serialized_message->buffer),
-                                                     serialized_message->buffer_capacity);
-    auto serializer = eprosima::fastcdr::Cdr(
-        fast_buffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::DDS_CDR);
-
-    // Serialize ros message into target buffer
-    try {
-        callbacks->cdr_serialize(ros_message, serializer);
-    }
-    catch (std::exception& e) {
+    auto result =
+        serialize(ros_message, type_support, serialized_message->buffer, serialized_message->buffer_capacity);
+    if (result.has_error()) {
         RMW_IOX2_CHAIN_ERROR_MSG("failed to serialize");
         return RMW_RET_ERROR;
     }
 
-    serialized_message->buffer_length = serializer.get_serialized_data_length();
+    serialized_message->buffer_length = result.value();
 
     return RMW_RET_OK;
 }
@@ -86,34 +62,12 @@ rmw_ret_t rmw_deserialize(const rmw_serialized_message_t* serialized_message,
     RMW_IOX2_ENSURE_NOT_NULL(serialized_message, RMW_RET_INVALID_ARGUMENT);
 
     // Implementation -------------------------------------------------------------------------------
+    using ::rmw::iox2::deserialize;
 
-    // Handle for fastrtps typesupport
-    const rosidl_message_type_support_t* handle =
-        get_message_typesupport_handle(type_support, rosidl_typesupport_fastrtps_cpp::typesupport_identifier);
-    if (!handle) {
-        RMW_IOX2_CHAIN_ERROR_MSG("failed to get typesupport handle");
-        return RMW_RET_ERROR;
-    }
-
-    // FastRTPS-specific callbacks
-    const message_type_support_callbacks_t* callbacks =
-        static_cast<const message_type_support_callbacks_t*>(handle->data);
-    if (!callbacks) {
-        RMW_IOX2_CHAIN_ERROR_MSG("failed to get typesupport callbacks");
-        return RMW_RET_ERROR;
-    }
-
-    // Prepare the buffer
-    eprosima::fastcdr::FastBuffer buffer(const_cast<char*>(reinterpret_cast<const char*>(serialized_message->buffer)),
-                                         serialized_message->buffer_capacity);
-    eprosima::fastcdr::Cdr deserializer(
-        buffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::DDS_CDR);
-
-    // Deserialize ros message into target buffer
-    try {
-        callbacks->cdr_deserialize(deserializer, ros_message);
-    }
-    catch (std::exception& e) {
+    // Only the bytes of the message are read, the remaining capacity of the buffer is not initialized
+    if (auto result =
+            deserialize(serialized_message->buffer, serialized_message->buffer_length, type_support, ros_message);
+        result.has_error()) {
         RMW_IOX2_CHAIN_ERROR_MSG("failed to deserialize");
         return RMW_RET_ERROR;
     }
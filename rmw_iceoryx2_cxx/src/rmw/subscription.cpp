@@ -8,6 +8,7 @@
 // SPDX-License-Identifier: Apache-2.0 OR MIT
 
 #include "iox/assertions_addendum.hpp"
+#include "rcutils/time.h"
 #include "rmw/allocators.h"
 #include "rmw/dynamic_message_type_support.h"
 #include "rmw/get_network_flow_endpoints.h"
@@ -19,9 +20,158 @@
 #include "rmw_iceoryx2_cxx/impl/common/ensure.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/error_message.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/log.hpp"
-#include "rmw_iceoryx2_cxx/impl/message/introspection.hpp"
+#include "rmw_iceoryx2_cxx/impl/message/message_header.hpp"
+#include "rmw_iceoryx2_cxx/impl/message/serialization.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/context.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/subscriber.hpp"
+#include "rmw_iceoryx2_cxx/rmw/loan_statistics.hpp"
+#include "rmw_iceoryx2_cxx/rmw/loaned_message_batch.hpp"
+#include "rmw_iceoryx2_cxx/rmw/subscription_options.hpp"
+
+#include <cstring>
+
+namespace
+{
+
+using ::rmw::iox2::MessageHeader;
+
+auto now() -> rcutils_time_point_value_t {
+    rcutils_time_point_value_t timestamp{0};
+    if (rcutils_system_time_now(&timestamp) != RCUTILS_RET_OK) {
+        rcutils_reset_error();
+        return 0;
+    }
+    return timestamp;
+}
+
+auto fill_message_info(rmw_message_info_t& info,
+                       const MessageHeader& header,
+                       rcutils_time_point_value_t received_timestamp) -> void {
+    info = rmw_get_zero_initialized_message_info();
+    info.source_timestamp = header.source_timestamp;
+    info.received_timestamp = received_timestamp;
+    info.publication_sequence_number = header.sequence_number;
+    info.reception_sequence_number = RMW_MESSAGE_INFO_SEQUENCE_NUMBER_UNSUPPORTED;
+    info.publisher_gid.implementation_identifier = rmw_get_implementation_identifier();
+    std::memcpy(info.publisher_gid.data, header.publisher_gid, RMW_GID_STORAGE_SIZE);
+    info.from_intra_process = false;
+}
+
+/// Takes a message by copying or deserializing it, optionally retrieving the header it was sent with
+auto take(const rmw_subscription_t* rmw_subscription, void* ros_message, bool* taken, MessageHeader* header)
+    -> rmw_ret_t {
+    using SubscriberImpl = ::rmw::iox2::Subscriber;
+    using ::rmw::iox2::deserialize;
+    using ::rmw::iox2::unsafe_cast;
+
+    RMW_IOX2_LOG_DEBUG("Taking from '%s'", rmw_subscription->topic_name);
+
+    if (auto result = unsafe_cast<SubscriberImpl*>(rmw_subscription->data); result.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve Subscriber");
+        return RMW_RET_ERROR;
+    } else {
+        auto subscriber_impl = result.value();
+
+        if (rmw_subscription->can_loan_messages) {
+            // Self-contained. Copy payload into message.
+            auto take_result = subscriber_impl->take_copy(ros_message, header);
+            if (take_result.has_error()) {
+                RMW_IOX2_CHAIN_ERROR_MSG("failed to take copy from subscriber");
+                return RMW_RET_ERROR;
+            }
+            *taken = take_result.value();
+        } else {
+            // Non-self-contained. Deserialize payload into message
+            auto loan_result = subscriber_impl->take_loan();
+            if (loan_result.has_error()) {
+                RMW_IOX2_CHAIN_ERROR_MSG("failed to take loan from subscriber");
+                return RMW_RET_ERROR;
+            } else {
+                auto sample = std::move(loan_result.value());
+                *taken = sample.has_value();
+
+                if (sample.has_value()) {
+                    auto callbacks = subscriber_impl->message_type().callbacks;
+                    auto loan = std::move(sample.value());
+                    if (header != nullptr) {
+                        *header = loan.header;
+                    }
+
+                    // The loan is returned regardless of the outcome, so that a malformed payload does not occupy
+                    // a slot of the subscriber
+                    auto deserialized = deserialize(loan.bytes, loan.number_of_bytes, callbacks, ros_message);
+                    if (auto result = subscriber_impl->return_loan(loan.bytes); result.has_error()) {
+                        RMW_IOX2_CHAIN_ERROR_MSG("failed to return loaned serialized payload");
+                        return RMW_RET_ERROR;
+                    }
+                    if (deserialized.has_error()) {
+                        RMW_IOX2_CHAIN_ERROR_MSG("failed to deserialize received message");
+                        return RMW_RET_ERROR;
+                    }
+                }
+            }
+        }
+    }
+
+    return RMW_RET_OK;
+}
+
+/// Takes a serialized message by copying it, optionally retrieving the header it was sent with
+auto take_serialized(const rmw_subscription_t* rmw_subscription,
+                     rmw_serialized_message_t* serialized_message,
+                     bool* taken,
+                     MessageHeader* header) -> rmw_ret_t {
+    using SubscriberImpl = ::rmw::iox2::Subscriber;
+    using ::rmw::iox2::unsafe_cast;
+
+    RMW_IOX2_LOG_DEBUG("Taking serialized message from '%s'", rmw_subscription->topic_name);
+
+    // Copy serialized payload into serialized message.
+    // WARNING: This take variant is usable if ONLY serialized payloads are published on this topic.
+    if (auto result = unsafe_cast<SubscriberImpl*>(rmw_subscription->data); result.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve Subscriber");
+        return RMW_RET_ERROR;
+    } else {
+        auto subscriber_impl = result.value();
+
+        auto loan_result = subscriber_impl->take_loan();
+        if (loan_result.has_error()) {
+            RMW_IOX2_CHAIN_ERROR_MSG("failed to take loan from subscriber");
+            return RMW_RET_ERROR;
+        } else {
+            auto sample = std::move(loan_result.value());
+            *taken = sample.has_value();
+
+            if (sample.has_value()) {
+                auto loan = std::move(sample.value());
+                if (header != nullptr) {
+                    *header = loan.header;
+                }
+
+                if (auto result = rmw_serialized_message_resize(serialized_message, loan.number_of_bytes);
+                    result != RMW_RET_OK) {
+                    RMW_IOX2_CHAIN_ERROR_MSG("failed to resize serialized message to store received payload");
+                    // Not leaked, the payload is dropped along with the loan
+                    if (subscriber_impl->return_loan(loan.bytes).has_error()) {
+                        RMW_IOX2_CHAIN_ERROR_MSG("failed to return loaned serialized payload");
+                    }
+                    return RMW_RET_ERROR;
+                }
+
+                memcpy(serialized_message->buffer, loan.bytes, loan.number_of_bytes);
+
+                if (auto result = subscriber_impl->return_loan(loan.bytes); result.has_error()) {
+                    RMW_IOX2_CHAIN_ERROR_MSG("failed to return loaned serialized payload");
+                    return RMW_RET_ERROR;
+                }
+            }
+        }
+    }
+
+    return RMW_RET_OK;
+}
+
+} // namespace
 
 extern "C" {
 
@@ -51,7 +201,6 @@ rmw_subscription_t* rmw_create_subscription(const rmw_node_t* rmw_node,
     using ::rmw::iox2::create_in_place;
     using ::rmw::iox2::deallocate;
     using ::rmw::iox2::destruct;
-    using ::rmw::iox2::is_pod;
     using NodeImpl = ::rmw::iox2::Node;
     using SubscriberImpl = ::rmw::iox2::Subscriber;
     using ::rmw::iox2::unsafe_cast;
@@ -65,14 +214,6 @@ rmw_subscription_t* rmw_create_subscription(const rmw_node_t* rmw_node,
     }
     rmw_subscription->implementation_identifier = rmw_get_implementation_identifier();
 
-    if (is_pod(type_support)) {
-        rmw_subscription->can_loan_messages = true;
-    } else {
-        rmw_subscription->can_loan_messages = false;
-        RMW_IOX2_LOG_DEBUG("Message type '%s' is not self-contained. Loaning disabled.",
-                           type_support->get_type_description_func(type_support)->type_description.type_name.data);
-    }
-
     if (auto ptr = allocate_copy(topic_name); ptr.has_error()) {
         rmw_subscription_free(rmw_subscription);
         RMW_IOX2_CHAIN_ERROR_MSG("failed to allocate memory for topic name");
@@ -93,7 +234,8 @@ rmw_subscription_t* rmw_create_subscription(const rmw_node_t* rmw_node,
         RMW_IOX2_CHAIN_ERROR_MSG("failed to allocate memory for Subscriber");
         return nullptr;
     } else {
-        if (create_in_place<SubscriberImpl>(subscriber_impl.value(), *node_impl.value(), topic_name, type_support)
+        if (create_in_place<SubscriberImpl>(
+                subscriber_impl.value(), *node_impl.value(), topic_name, type_support, *qos_profile)
                 .has_error()) {
             destruct<SubscriberImpl>(subscriber_impl.value());
             deallocate<SubscriberImpl>(subscriber_impl.value());
@@ -103,6 +245,27 @@ rmw_subscription_t* rmw_create_subscription(const rmw_node_t* rmw_node,
         } else {
             rmw_subscription->data = subscriber_impl.value();
         }
+
+        // Resolved on creation of the subscriber
+        if (subscriber_impl.value()->message_type().is_pod) {
+            rmw_subscription->can_loan_messages = true;
+        } else {
+            rmw_subscription->can_loan_messages = false;
+            RMW_IOX2_LOG_DEBUG("Message type '%s' is not self-contained. Loaning disabled.",
+                               type_support->get_type_description_func(type_support)->type_description.type_name.data);
+        }
+    }
+
+    // Apply options specific to this RMW, if provided
+    if (auto payload = subscription_options->rmw_specific_subscription_payload; payload != nullptr) {
+        auto options = static_cast<const rmw_iox2_subscription_options_t*>(payload);
+        if (options->magic == RMW_IOX2_SUBSCRIPTION_OPTIONS_MAGIC) {
+            static_cast<SubscriberImpl*>(rmw_subscription->data)->set_priority(options->priority);
+        } else {
+            RMW_IOX2_LOG_WARN("Ignoring subscription payload for topic '%s' not initialized via "
+                              "rmw_iox2_get_default_subscription_options()",
+                              topic_name);
+        }
     }
 
     return rmw_subscription;
@@ -142,58 +305,9 @@ rmw_ret_t rmw_take(const rmw_subscription_t* rmw_subscription,
     RMW_IOX2_ENSURE_NOT_NULL(taken, RMW_RET_INVALID_ARGUMENT);
 
     // Implementation -------------------------------------------------------------------------------
-    using SubscriberImpl = ::rmw::iox2::Subscriber;
-    using ::rmw::iox2::unsafe_cast;
-
-    RMW_IOX2_LOG_DEBUG("Taking from '%s'", rmw_subscription->topic_name);
-
-    if (auto result = unsafe_cast<SubscriberImpl*>(rmw_subscription->data); result.has_error()) {
-        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve Subscriber");
-        return RMW_RET_ERROR;
-    } else {
-        auto subscriber_impl = result.value();
-
-        if (rmw_subscription->can_loan_messages) {
-            // Self-contained. Copy payload into message.
-            auto take_result = subscriber_impl->take_copy(ros_message);
-            if (take_result.has_error()) {
-                RMW_IOX2_CHAIN_ERROR_MSG("failed to take copy from subscriber");
-                return RMW_RET_ERROR;
-            }
-            *taken = take_result.value();
-        } else {
-            // Non-self-contained. Deserialize payload into message
-            auto loan_result = subscriber_impl->take_loan();
-            if (loan_result.has_error()) {
-                RMW_IOX2_CHAIN_ERROR_MSG("failed to take loan from subscriber");
-                return RMW_RET_ERROR;
-            } else {
-                auto sample = std::move(loan_result.value());
-                *taken = sample.has_value();
-
-                if (sample.has_value()) {
-                    auto typesupport = subscriber_impl->typesupport();
-                    auto loan = std::move(sample.value());
-
-                    auto serialized_message = rmw_serialized_message_t{
-                        loan.bytes, loan.number_of_bytes, loan.number_of_bytes, rcutils_get_default_allocator()};
-
-                    if (auto result = rmw_deserialize(&serialized_message, typesupport, ros_message);
-                        result != RMW_RET_OK) {
-                        RMW_IOX2_CHAIN_ERROR_MSG("failed to deserialize received message");
-                        return RMW_RET_ERROR;
-                    }
-
-                    if (auto result = subscriber_impl->return_loan(loan.bytes); result.has_error()) {
-                        RMW_IOX2_CHAIN_ERROR_MSG("failed to return loaned serialized payload");
-                        return RMW_RET_ERROR;
-                    }
-                }
-            }
-        }
-    }
+    (void)allocation; // not used
 
-    return RMW_RET_OK;
+    return take(rmw_subscription, ros_message, taken, nullptr);
 }
 
 rmw_ret_t rmw_take_with_info(const rmw_subscription_t* rmw_subscription,
@@ -209,7 +323,17 @@ rmw_ret_t rmw_take_with_info(const rmw_subscription_t* rmw_subscription,
     RMW_IOX2_ENSURE_IMPLEMENTATION(rmw_subscription->implementation_identifier, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
 
     // Implementation -------------------------------------------------------------------------------
-    return rmw_take(rmw_subscription, ros_message, taken, allocation);
+    (void)allocation; // not used
+
+    MessageHeader header;
+    if (auto result = take(rmw_subscription, ros_message, taken, &header); result != RMW_RET_OK) {
+        return result;
+    }
+    if (*taken) {
+        fill_message_info(*message_info, header, now());
+    }
+
+    return RMW_RET_OK;
 }
 
 rmw_ret_t rmw_take_loaned_message(const rmw_subscription_t* rmw_subscription,
@@ -275,11 +399,39 @@ rmw_ret_t rmw_take_loaned_message_with_info(const rmw_subscription_t* rmw_subscr
     RMW_IOX2_ENSURE_IMPLEMENTATION(rmw_subscription->implementation_identifier, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
     RMW_IOX2_ENSURE_CAN_LOAN(rmw_subscription, RMW_RET_UNSUPPORTED);
     RMW_IOX2_ENSURE_NOT_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+    RMW_IOX2_ENSURE_NOT_NULL(loaned_message, RMW_RET_INVALID_ARGUMENT);
+    RMW_IOX2_ENSURE_NULL(*loaned_message, RMW_RET_INVALID_ARGUMENT);
+    RMW_IOX2_ENSURE_NOT_NULL(message_info, RMW_RET_INVALID_ARGUMENT);
 
     // Implementation -------------------------------------------------------------------------------
-    (void)message_info; // TODO: support this
+    using SubscriberImpl = ::rmw::iox2::Subscriber;
+    using ::rmw::iox2::unsafe_cast;
+    (void)allocation; // not used
+
+    RMW_IOX2_LOG_DEBUG("Taking loan with info from '%s'", rmw_subscription->topic_name);
 
-    return rmw_take_loaned_message(rmw_subscription, loaned_message, taken, allocation);
+    auto subscriber_impl = unsafe_cast<SubscriberImpl*>(rmw_subscription->data);
+    if (subscriber_impl.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve Subscriber");
+        return RMW_RET_ERROR;
+    }
+
+    auto loan = subscriber_impl.value()->take_loan();
+    if (loan.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to take sample from subscriber");
+        return RMW_RET_ERROR;
+    }
+
+    auto payload = std::move(loan.value());
+    if (payload.has_value()) {
+        *loaned_message = static_cast<void*>(payload->bytes);
+        fill_message_info(*message_info, payload->header, now());
+        *taken = true;
+    } else {
+        *taken = false;
+    }
+
+    return RMW_RET_OK;
 }
 
 rmw_ret_t rmw_return_loaned_message_from_subscription(const rmw_subscription_t* rmw_subscription,
@@ -326,47 +478,9 @@ rmw_ret_t rmw_take_serialized_message(const rmw_subscription_t* rmw_subscription
     RMW_IOX2_ENSURE_NOT_NULL(taken, RMW_RET_INVALID_ARGUMENT);
 
     // Implementation -------------------------------------------------------------------------------
-    using SubscriberImpl = ::rmw::iox2::Subscriber;
-    using ::rmw::iox2::unsafe_cast;
-
-    RMW_IOX2_LOG_DEBUG("Taking serialized message from '%s'", rmw_subscription->topic_name);
-
-    // Copy serialized payload into serialized message.
-    // WARNING: This take variant is usable if ONLY serialized payloads are published on this topic.
-    if (auto result = unsafe_cast<SubscriberImpl*>(rmw_subscription->data); result.has_error()) {
-        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve Subscriber");
-        return RMW_RET_ERROR;
-    } else {
-        auto subscriber_impl = result.value();
-
-        auto loan_result = subscriber_impl->take_loan();
-        if (loan_result.has_error()) {
-            RMW_IOX2_CHAIN_ERROR_MSG("failed to take loan from subscriber");
-            return RMW_RET_ERROR;
-        } else {
-            auto sample = std::move(loan_result.value());
-            *taken = sample.has_value();
-
-            if (sample.has_value()) {
-                auto loan = std::move(sample.value());
-
-                if (auto result = rmw_serialized_message_resize(serialized_message, loan.number_of_bytes);
-                    result != RMW_RET_OK) {
-                    RMW_IOX2_CHAIN_ERROR_MSG("failed to resize serialized message to store received payload");
-                    return RMW_RET_ERROR;
-                }
-
-                memcpy(serialized_message->buffer, loan.bytes, loan.number_of_bytes);
-
-                if (auto result = subscriber_impl->return_loan(loan.bytes); result.has_error()) {
-                    RMW_IOX2_CHAIN_ERROR_MSG("failed to return loaned serialized payload");
-                    return RMW_RET_ERROR;
-                }
-            }
-        }
-    }
+    (void)allocation; // not used
 
-    return RMW_RET_OK;
+    return take_serialized(rmw_subscription, serialized_message, taken, nullptr);
 }
 
 rmw_ret_t rmw_take_sequence(const rmw_subscription_t* rmw_subscription,
@@ -386,7 +500,50 @@ rmw_ret_t rmw_take_sequence(const rmw_subscription_t* rmw_subscription,
     }
 
     // Implementation -------------------------------------------------------------------------------
-    return RMW_RET_UNSUPPORTED;
+    using SubscriberImpl = ::rmw::iox2::Subscriber;
+    using ::rmw::iox2::deserialize;
+    using ::rmw::iox2::unsafe_cast;
+    (void)allocation; // not used
+
+    RMW_IOX2_LOG_DEBUG("Taking up to %zu messages from '%s'", count, rmw_subscription->topic_name);
+
+    *taken = 0;
+    message_sequence->size = 0;
+    message_info_sequence->size = 0;
+
+    auto subscriber_impl = unsafe_cast<SubscriberImpl*>(rmw_subscription->data);
+    if (subscriber_impl.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve Subscriber");
+        return RMW_RET_ERROR;
+    }
+    auto subscriber = subscriber_impl.value();
+
+    // All samples are received while holding the port lock once, each copied or deserialized into the provided
+    // messages before the next one is received. Messages taken before a failure are returned, the failure is reported
+    // by the next call.
+    auto messages = message_sequence->data;
+    const bool self_contained = rmw_subscription->can_loan_messages;
+    const auto* callbacks = subscriber->message_type().callbacks;
+    auto infos = message_info_sequence->data;
+    auto result = subscriber->take_batch(
+        count, [&](size_t index, const MessageHeader& header, const uint8_t* bytes, size_t number_of_bytes) -> bool {
+            fill_message_info(infos[index], header, now());
+            if (self_contained) {
+                std::memcpy(messages[index], bytes, number_of_bytes);
+                return true;
+            }
+            return !deserialize(bytes, number_of_bytes, callbacks, messages[index]).has_error();
+        });
+    if (result.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to take messages from subscriber");
+        return RMW_RET_ERROR;
+    }
+
+    *taken = result.value();
+    message_sequence->size = result.value();
+    message_info_sequence->size = result.value();
+
+    return RMW_RET_OK;
 }
 
 rmw_ret_t rmw_take_serialized_message_with_info(const rmw_subscription_t* rmw_subscription,
@@ -402,7 +559,17 @@ rmw_ret_t rmw_take_serialized_message_with_info(const rmw_subscription_t* rmw_su
     RMW_IOX2_ENSURE_NOT_NULL(message_info, RMW_RET_INVALID_ARGUMENT);
 
     // Implementation -------------------------------------------------------------------------------
-    return RMW_RET_UNSUPPORTED;
+    (void)allocation; // not used
+
+    MessageHeader header;
+    if (auto result = take_serialized(rmw_subscription, serialized_message, taken, &header); result != RMW_RET_OK) {
+        return result;
+    }
+    if (*taken) {
+        fill_message_info(*message_info, header, now());
+    }
+
+    return RMW_RET_OK;
 }
 
 rmw_ret_t rmw_subscription_count_matched_publishers(const rmw_subscription_t* rmw_subscription,
@@ -422,8 +589,16 @@ rmw_ret_t rmw_subscription_get_actual_qos(const rmw_subscription_t* rmw_subscrip
     RMW_IOX2_ENSURE_IMPLEMENTATION(rmw_subscription->implementation_identifier, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
     RMW_IOX2_ENSURE_NOT_NULL(qos, RMW_RET_INVALID_ARGUMENT);
 
-    // ementation -------------------------------------------------------------------------------
-    *qos = rmw_qos_profile_default;
+    // Implementation -------------------------------------------------------------------------------
+    using SubscriberImpl = ::rmw::iox2::Subscriber;
+    using ::rmw::iox2::unsafe_cast;
+
+    auto subscriber_impl = unsafe_cast<SubscriberImpl*>(rmw_subscription->data);
+    if (subscriber_impl.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve Subscriber");
+        return RMW_RET_ERROR;
+    }
+    *qos = subscriber_impl.value()->qos();
 
     return RMW_RET_OK;
 }
@@ -467,7 +642,27 @@ rmw_ret_t rmw_subscription_get_content_filter(const rmw_subscription_t* rmw_subs
 rmw_ret_t rmw_subscription_set_on_new_message_callback(rmw_subscription_t* rmw_subscription,
                                                        rmw_event_callback_t callback,
                                                        const void* user_data) {
-    return RMW_RET_UNSUPPORTED;
+    // Invariants ----------------------------------------------------------------------------------
+    RMW_IOX2_ENSURE_NOT_NULL(rmw_subscription, RMW_RET_INVALID_ARGUMENT);
+    RMW_IOX2_ENSURE_IMPLEMENTATION(rmw_subscription->implementation_identifier, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+    // Implementation -------------------------------------------------------------------------------
+    using SubscriberImpl = ::rmw::iox2::Subscriber;
+    using ::rmw::iox2::unsafe_cast;
+
+    auto subscriber_impl = unsafe_cast<SubscriberImpl*>(rmw_subscription->data);
+    if (subscriber_impl.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve Subscriber");
+        return RMW_RET_ERROR;
+    }
+
+    // Invoked by the event dispatcher thread of the context
+    if (auto result = subscriber_impl.value()->set_event_callback(callback, user_data); result.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to set new-message callback");
+        return RMW_RET_ERROR;
+    }
+
+    return RMW_RET_OK;
 }
 
 rmw_ret_t rmw_subscription_get_network_flow_endpoints(const rmw_subscription_t* rmw_subscription,
@@ -475,4 +670,101 @@ rmw_ret_t rmw_subscription_get_network_flow_endpoints(const rmw_subscription_t*
                                                       rmw_network_flow_endpoint_array_t* network_flow_endpoint_array) {
     return RMW_RET_UNSUPPORTED;
 }
+
+rmw_ret_t rmw_iox2_subscription_get_loan_statistics(const rmw_subscription_t* rmw_subscription,
+                                                    rmw_iox2_loan_statistics_t* statistics) {
+    // Invariants ----------------------------------------------------------------------------------
+    RMW_IOX2_ENSURE_NOT_NULL(rmw_subscription, RMW_RET_INVALID_ARGUMENT);
+    RMW_IOX2_ENSURE_NOT_NULL(statistics, RMW_RET_INVALID_ARGUMENT);
+    RMW_IOX2_ENSURE_IMPLEMENTATION(rmw_subscription->implementation_identifier, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+    // Implementation -------------------------------------------------------------------------------
+    using SubscriberImpl = ::rmw::iox2::Subscriber;
+    using ::rmw::iox2::unsafe_cast;
+
+    auto subscriber_impl = unsafe_cast<SubscriberImpl*>(rmw_subscription->data);
+    if (subscriber_impl.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve Subscriber");
+        return RMW_RET_ERROR;
+    }
+
+    auto loan_statistics = subscriber_impl.value()->loan_statistics();
+    statistics->capacity = loan_statistics.capacity;
+    statistics->outstanding = loan_statistics.outstanding;
+    statistics->high_water_mark = loan_statistics.high_water_mark;
+    statistics->oldest_loan_age_ns = static_cast<int64_t>(loan_statistics.oldest_loan_age.count());
+
+    return RMW_RET_OK;
+}
+
+rmw_ret_t rmw_iox2_take_loaned_messages(const rmw_subscription_t* rmw_subscription,
+                                        size_t count,
+                                        void** loaned_messages,
+                                        size_t* taken) {
+    // Invariants ----------------------------------------------------------------------------------
+    RMW_IOX2_ENSURE_NOT_NULL(rmw_subscription, RMW_RET_INVALID_ARGUMENT);
+    RMW_IOX2_ENSURE_IMPLEMENTATION(rmw_subscription->implementation_identifier, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+    RMW_IOX2_ENSURE_CAN_LOAN(rmw_subscription, RMW_RET_UNSUPPORTED);
+    RMW_IOX2_ENSURE_NOT_NULL(loaned_messages, RMW_RET_INVALID_ARGUMENT);
+    RMW_IOX2_ENSURE_NOT_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+
+    // Implementation -------------------------------------------------------------------------------
+    using SubscriberImpl = ::rmw::iox2::Subscriber;
+    using ::rmw::iox2::unsafe_cast;
+
+    RMW_IOX2_LOG_DEBUG("Taking up to %zu loans from '%s'", count, rmw_subscription->topic_name);
+
+    *taken = 0;
+
+    auto subscriber_impl = unsafe_cast<SubscriberImpl*>(rmw_subscription->data);
+    if (subscriber_impl.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve Subscriber");
+        return RMW_RET_ERROR;
+    }
+
+    auto result = subscriber_impl.value()->take_loans(loaned_messages, count);
+    if (result.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to take samples from subscriber");
+        return RMW_RET_ERROR;
+    }
+    *taken = result.value();
+
+    return RMW_RET_OK;
+}
+
+rmw_ret_t rmw_iox2_return_loaned_messages_from_subscription(const rmw_subscription_t* rmw_subscription,
+                                                            void* const* loaned_messages,
+                                                            size_t count) {
+    // Invariants ----------------------------------------------------------------------------------
+    RMW_IOX2_ENSURE_NOT_NULL(rmw_subscription, RMW_RET_INVALID_ARGUMENT);
+    RMW_IOX2_ENSURE_IMPLEMENTATION(rmw_subscription->implementation_identifier, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+    RMW_IOX2_ENSURE_CAN_LOAN(rmw_subscription, RMW_RET_UNSUPPORTED);
+    RMW_IOX2_ENSURE_NOT_NULL(loaned_messages, RMW_RET_INVALID_ARGUMENT);
+
+    // Implementation -------------------------------------------------------------------------------
+    using SubscriberImpl = ::rmw::iox2::Subscriber;
+    using ::rmw::iox2::unsafe_cast;
+
+    RMW_IOX2_LOG_DEBUG("Releasing %zu loans to '%s'", count, rmw_subscription->topic_name);
+
+    auto subscriber_impl = unsafe_cast<SubscriberImpl*>(rmw_subscription->data);
+    if (subscriber_impl.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to retrieve Subscriber");
+        return RMW_RET_ERROR;
+    }
+
+    if (auto result = subscriber_impl.value()->return_loans(loaned_messages, count); result.has_error()) {
+        RMW_IOX2_CHAIN_ERROR_MSG("failed to return loaned messages to publisher");
+        return RMW_RET_ERROR;
+    }
+
+    return RMW_RET_OK;
+}
+
+rmw_iox2_subscription_options_t rmw_iox2_get_default_subscription_options(void) {
+    rmw_iox2_subscription_options_t options{};
+    options.magic = RMW_IOX2_SUBSCRIPTION_OPTIONS_MAGIC;
+    options.priority = 0;
+    return options;
+}
 }
@@ -17,8 +17,6 @@
 #include "rmw_iceoryx2_cxx/impl/common/error_message.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/log.hpp"
 
-#include <set>
-
 extern "C" {
 rmw_wait_set_t* rmw_create_wait_set(rmw_context_t* rmw_context, size_t max_conditions) {
     // Invariants ----------------------------------------------------------------------------------
@@ -139,7 +137,8 @@ rmw_ret_t rmw_wait(rmw_subscriptions_t* rmw_subscriptions,
                 return RMW_RET_ERROR;
             }
             if (auto result = waitset_impl->map(index, *guard_condition.value()); result.has_error()) {
-                // TODO: maybe detach previously attached elements? Detach all?
+                // Discard the partial mapping so that it does not leak into the next wait call
+                waitset_impl->unmap_all();
                 RMW_IOX2_CHAIN_ERROR_MSG("failed to attach GuardCondition to WaitSet");
                 return RMW_RET_ERROR;
             }
@@ -155,7 +154,8 @@ rmw_ret_t rmw_wait(rmw_subscriptions_t* rmw_subscriptions,
                 return RMW_RET_ERROR;
             }
             if (auto result = waitset_impl->map(index, *subscriber.value()); result.has_error()) {
-                // TODO: maybe detach previously attached elements? Detach all?
+                // Discard the partial mapping so that it does not leak into the next wait call
+                waitset_impl->unmap_all();
                 RMW_IOX2_CHAIN_ERROR_MSG("failed to attach Subscriber to WaitSet");
                 return RMW_RET_ERROR;
             }
@@ -175,46 +175,33 @@ rmw_ret_t rmw_wait(rmw_subscriptions_t* rmw_subscriptions,
     }
 
     // Reset all mappings - each wait call provides a different set of mappings
+    // The results of the wait call remain accessible until the next wait.
     waitset_impl->unmap_all();
 
     // Process triggers
     auto return_code = RMW_RET_TIMEOUT;
-    auto triggers = std::move(wait_result.value());
-    if (!triggers.empty()) {
+    if (wait_result.value() > 0) {
         return_code = RMW_RET_OK;
 
-        // Collect all triggered indices
-        std::set<size_t> triggered_subscribers;
-        std::set<size_t> triggered_guard_conditions;
-        for (const auto& trigger : triggers) {
-            switch (trigger.waitable_type) {
-            case WaitableEntity::SUBSCRIBER:
-                triggered_subscribers.insert(trigger.rmw_index);
-                break;
-            case WaitableEntity::GUARD_CONDITION:
-                triggered_guard_conditions.insert(trigger.rmw_index);
-                break;
-            }
-        }
-
         // Set non-triggered indices to nullptr
         if (rmw_subscriptions) {
             for (size_t index = 0; index < rmw_subscriptions->subscriber_count; index++) {
-                if (triggered_subscribers.find(index) == triggered_subscribers.end()) {
+                if (!waitset_impl->is_triggered(WaitableEntity::SUBSCRIBER, index)) {
                     rmw_subscriptions->subscribers[index] = nullptr;
                 }
             }
         }
         if (rmw_guard_conditions) {
             for (size_t index = 0; index < rmw_guard_conditions->guard_condition_count; index++) {
-                if (triggered_guard_conditions.find(index) == triggered_guard_conditions.end()) {
+                if (!waitset_impl->is_triggered(WaitableEntity::GUARD_CONDITION, index)) {
                     rmw_guard_conditions->guard_conditions[index] = nullptr;
                 }
             }
         }
     }
 
-    // Set all events to null (not supported yet)
+    // Services, clients and events are not implemented yet, thus can never be triggered.
+    // They are set to null to signal this to the caller instead of being mapped to the waitset.
     if (rmw_events) {
         for (size_t index = 0; index < rmw_events->event_count; index++) {
             rmw_events->events[index] = nullptr;
@@ -37,4 +37,20 @@ TEST_F(ContextTest, construction) {
     ASSERT_FALSE(create_in_place(context_storage, test_id()).has_error());
 }
 
+TEST_F(ContextTest, waiting_thread_is_not_attributed_to_later_contexts) {
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+
+    // Constructed in the same storage, thus at the same address
+    iox::optional<Context> context_storage;
+    ASSERT_FALSE(create_in_place(context_storage, test_id()).has_error());
+    EXPECT_FALSE(context_storage->is_waiting_thread());
+    context_storage->mark_waiting_thread();
+    EXPECT_TRUE(context_storage->is_waiting_thread());
+
+    context_storage.reset();
+    ASSERT_FALSE(create_in_place(context_storage, test_id()).has_error());
+    EXPECT_FALSE(context_storage->is_waiting_thread());
+}
+
 } // namespace
@@ -0,0 +1,274 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#include <gtest/gtest.h>
+
+#include "iox/optional.hpp"
+#include "rmw/qos_profiles.h"
+#include "rmw_iceoryx2_cxx/impl/common/create.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/context.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/event_dispatcher.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/publisher.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/subscriber.hpp"
+#include "rmw_iceoryx2_cxx_test_msgs/msg/defaults.hpp"
+#include "testing/base.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <thread>
+
+namespace
+{
+
+using namespace rmw::iox2::testing;
+
+/// Records the invocations of a new-message callback
+struct CallbackRecord
+{
+    std::atomic<size_t> invocations{0};
+    std::atomic<size_t> number_of_events{0};
+};
+
+void record_callback(const void* user_data, size_t number_of_events) {
+    auto* record = static_cast<CallbackRecord*>(const_cast<void*>(user_data));
+    record->number_of_events = number_of_events;
+    record->invocations++;
+}
+
+template <typename Predicate>
+auto eventually(Predicate&& predicate) -> bool {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+class EventDispatcherTest : public TestBase
+{
+protected:
+    void SetUp() override {
+        using ::rmw::iox2::create_in_place;
+
+        create_in_place(m_context, test_id()).expect("failed to create context");
+        create_in_place(m_node, m_context.value(), "Node", "EventDispatcherTest").expect("failed to create node");
+    }
+
+    void TearDown() override {
+    }
+
+    auto create_publisher(const std::string& topic) -> ::rmw::iox2::Publisher& {
+        using ::rmw::iox2::create_in_place;
+        using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+        auto& storage = m_publishers.emplace_back();
+        create_in_place(storage, m_node.value(), topic.c_str(), test_type_support<Defaults>(), rmw_qos_profile_default)
+            .expect("failed to create publisher");
+        return storage.value();
+    }
+
+    auto create_subscriber(iox::optional<::rmw::iox2::Subscriber>& storage, const std::string& topic)
+        -> ::rmw::iox2::Subscriber& {
+        using ::rmw::iox2::create_in_place;
+        using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+        create_in_place(storage, m_node.value(), topic.c_str(), test_type_support<Defaults>(), rmw_qos_profile_default)
+            .expect("failed to create subscriber");
+        return storage.value();
+    }
+
+    auto dispatcher() -> ::rmw::iox2::EventDispatcher& {
+        return *m_context->event_dispatcher().expect("failed to create event dispatcher");
+    }
+
+    iox::optional<::rmw::iox2::Context> m_context;
+    iox::optional<::rmw::iox2::Node> m_node;
+    std::deque<iox::optional<::rmw::iox2::Publisher>> m_publishers;
+};
+
+TEST_F(EventDispatcherTest, callback_is_invoked_on_new_messages) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // Outlives the subscriber, which removes the callback when destroyed
+    CallbackRecord record;
+    const auto topic = create_test_topic();
+    auto& publisher = create_publisher(topic);
+    iox::optional<::rmw::iox2::Subscriber> subscriber_storage;
+    auto& subscriber = create_subscriber(subscriber_storage, topic);
+
+    ASSERT_FALSE(subscriber.set_event_callback(record_callback, &record).has_error());
+    EXPECT_EQ(dispatcher().registration_count(), 1U);
+    EXPECT_EQ(record.invocations.load(), 0U);
+
+    Defaults message{};
+    ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+    ASSERT_TRUE(eventually([&] { return record.invocations > 0; }));
+
+    // Each notification reports a single new sample
+    EXPECT_EQ(record.number_of_events.load(), 1U);
+    Defaults received{};
+    auto taken = subscriber.take_copy(&received);
+    ASSERT_FALSE(taken.has_error());
+    EXPECT_TRUE(taken.value());
+}
+
+TEST_F(EventDispatcherTest, unread_messages_are_reported_on_registration) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // Outlives the subscriber, which removes the callback when destroyed
+    CallbackRecord record;
+    const auto topic = create_test_topic();
+    auto& publisher = create_publisher(topic);
+    iox::optional<::rmw::iox2::Subscriber> subscriber_storage;
+    auto& subscriber = create_subscriber(subscriber_storage, topic);
+
+    Defaults message{};
+    ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+
+    // Reported by the registering thread before returning
+    ASSERT_FALSE(subscriber.set_event_callback(record_callback, &record).has_error());
+    EXPECT_GE(record.invocations.load(), 1U);
+}
+
+TEST_F(EventDispatcherTest, unread_messages_are_not_reported_to_replacing_callbacks) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // Outlive the subscriber, which removes the callback when destroyed
+    CallbackRecord first;
+    CallbackRecord second;
+    const auto topic = create_test_topic();
+    auto& publisher = create_publisher(topic);
+    iox::optional<::rmw::iox2::Subscriber> subscriber_storage;
+    auto& subscriber = create_subscriber(subscriber_storage, topic);
+
+    Defaults message{};
+    ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+    ASSERT_FALSE(subscriber.set_event_callback(record_callback, &first).has_error());
+    EXPECT_GE(first.invocations.load(), 1U);
+
+    // Already reported to the replaced callback
+    ASSERT_FALSE(subscriber.set_event_callback(record_callback, &second).has_error());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(second.invocations.load(), 0U);
+    EXPECT_EQ(dispatcher().registration_count(), 1U);
+}
+
+TEST_F(EventDispatcherTest, callback_is_not_invoked_once_removed) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // Outlives the subscriber, which removes the callback when destroyed
+    CallbackRecord record;
+    const auto topic = create_test_topic();
+    auto& publisher = create_publisher(topic);
+    iox::optional<::rmw::iox2::Subscriber> subscriber_storage;
+    auto& subscriber = create_subscriber(subscriber_storage, topic);
+
+    ASSERT_FALSE(subscriber.set_event_callback(record_callback, &record).has_error());
+    ASSERT_FALSE(subscriber.set_event_callback(nullptr, nullptr).has_error());
+    EXPECT_EQ(dispatcher().registration_count(), 0U);
+
+    Defaults message{};
+    ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(record.invocations.load(), 0U);
+}
+
+TEST_F(EventDispatcherTest, untaken_messages_are_not_reported_again) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    CallbackRecord record;
+    CallbackRecord other_record;
+    const auto topic = create_test_topic();
+    const auto other_topic = create_test_topic("/other");
+    auto& publisher = create_publisher(topic);
+    auto& other_publisher = create_publisher(other_topic);
+    iox::optional<::rmw::iox2::Subscriber> subscriber_storage;
+    auto& subscriber = create_subscriber(subscriber_storage, topic);
+    iox::optional<::rmw::iox2::Subscriber> other_storage;
+    auto& other = create_subscriber(other_storage, other_topic);
+
+    ASSERT_FALSE(subscriber.set_event_callback(record_callback, &record).has_error());
+    ASSERT_FALSE(other.set_event_callback(record_callback, &other_record).has_error());
+
+    Defaults message{};
+    ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+    ASSERT_TRUE(eventually([&] { return record.invocations > 0; }));
+
+    // Waking up the dispatcher for another topic does not report the sample that was not taken yet
+    ASSERT_FALSE(other_publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+    ASSERT_TRUE(eventually([&] { return other_record.invocations > 0; }));
+    EXPECT_EQ(record.invocations.load(), 1U);
+
+    // A new sample is reported by itself
+    ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+    ASSERT_TRUE(eventually([&] { return record.invocations > 1; }));
+    EXPECT_EQ(record.number_of_events.load(), 1U);
+}
+
+TEST_F(EventDispatcherTest, callbacks_can_remove_callbacks) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // Removes its own registration when invoked
+    struct SelfRemoving
+    {
+        ::rmw::iox2::Subscriber* subscriber{nullptr};
+        std::atomic<size_t> invocations{0};
+    };
+    SelfRemoving record;
+    auto remove_self = [](const void* user_data, size_t) {
+        auto* record = static_cast<SelfRemoving*>(const_cast<void*>(user_data));
+        EXPECT_FALSE(record->subscriber->set_event_callback(nullptr, nullptr).has_error());
+        record->invocations++;
+    };
+
+    const auto topic = create_test_topic();
+    auto& publisher = create_publisher(topic);
+    iox::optional<::rmw::iox2::Subscriber> subscriber_storage;
+    record.subscriber = &create_subscriber(subscriber_storage, topic);
+    ASSERT_FALSE(record.subscriber->set_event_callback(remove_self, &record).has_error());
+
+    Defaults message{};
+    ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+    ASSERT_TRUE(eventually([&] { return dispatcher().registration_count() == 0; }));
+    EXPECT_EQ(record.invocations.load(), 1U);
+}
+
+TEST_F(EventDispatcherTest, subscribers_to_the_same_topic_share_a_listener) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    CallbackRecord first_record;
+    CallbackRecord second_record;
+    const auto topic = create_test_topic();
+    auto& publisher = create_publisher(topic);
+    iox::optional<::rmw::iox2::Subscriber> first_storage;
+    auto& first = create_subscriber(first_storage, topic);
+    iox::optional<::rmw::iox2::Subscriber> second_storage;
+    auto& second = create_subscriber(second_storage, topic);
+
+    ASSERT_FALSE(first.set_event_callback(record_callback, &first_record).has_error());
+    ASSERT_FALSE(second.set_event_callback(record_callback, &second_record).has_error());
+    EXPECT_EQ(m_context->listener_registry().listener_count(), 1U);
+
+    Defaults message{};
+    ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+    ASSERT_TRUE(eventually([&] { return first_record.invocations > 0 && second_record.invocations > 0; }));
+
+    // Destroying the subscribers removes their callbacks and releases the listener
+    first_storage.reset();
+    second_storage.reset();
+    EXPECT_EQ(dispatcher().registration_count(), 0U);
+    EXPECT_EQ(m_context->listener_registry().listener_count(), 0U);
+}
+
+} // namespace
@@ -0,0 +1,185 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#include <gtest/gtest.h>
+
+#include "iox/optional.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/create.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/names.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/context.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/listener_registry.hpp"
+#include "testing/base.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace
+{
+
+using namespace rmw::iox2::testing;
+
+template <typename Predicate>
+auto eventually(Predicate&& predicate) -> bool {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+class ListenerRegistryTest : public TestBase
+{
+protected:
+    void SetUp() override {
+    }
+
+    void TearDown() override {
+    }
+};
+
+TEST_F(ListenerRegistryTest, listeners_are_shared_until_released) {
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::ListenerRegistry;
+    using ::rmw::iox2::Waker;
+    namespace names = ::rmw::iox2::names;
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context");
+    auto& context = context_storage.value();
+    auto& registry = context.listener_registry();
+
+    iox::optional<Waker> waker_storage;
+    create_in_place(waker_storage, context.iox2(), names::waitset(context.id(), context.generate_waitset_id()))
+        .expect("failed to create waker");
+    auto& waker = waker_storage.value();
+
+    const auto service_name = names::topic(create_test_topic().c_str());
+
+    iox::optional<ListenerRegistry::Handle> first;
+    first.emplace(registry.acquire(service_name, waker).expect("failed to acquire listener"));
+    iox::optional<ListenerRegistry::Handle> second;
+    second.emplace(registry.acquire(service_name, waker).expect("failed to acquire listener"));
+    EXPECT_EQ(registry.listener_count(), 1U);
+
+    first.reset();
+    EXPECT_EQ(registry.listener_count(), 1U);
+
+    second.reset();
+    EXPECT_EQ(registry.listener_count(), 0U);
+}
+
+TEST_F(ListenerRegistryTest, events_wake_up_armed_handles_only) {
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::Iceoryx2;
+    using ::rmw::iox2::ListenerRegistry;
+    using ::rmw::iox2::Waker;
+    namespace names = ::rmw::iox2::names;
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context");
+    auto& context = context_storage.value();
+    auto& registry = context.listener_registry();
+
+    iox::optional<Waker> armed_waker_storage;
+    create_in_place(armed_waker_storage, context.iox2(), names::waitset(context.id(), context.generate_waitset_id()))
+        .expect("failed to create waker");
+    auto& armed_waker = armed_waker_storage.value();
+
+    iox::optional<Waker> idle_waker_storage;
+    create_in_place(idle_waker_storage, context.iox2(), names::waitset(context.id(), context.generate_waitset_id()))
+        .expect("failed to create waker");
+    auto& idle_waker = idle_waker_storage.value();
+
+    const auto service_name = names::topic(create_test_topic().c_str());
+
+    iox::optional<ListenerRegistry::Handle> armed;
+    armed.emplace(registry.acquire(service_name, armed_waker).expect("failed to acquire listener"));
+    iox::optional<ListenerRegistry::Handle> idle;
+    idle.emplace(registry.acquire(service_name, idle_waker).expect("failed to acquire listener"));
+
+    auto notifier = context.iox2()
+                        .service_builder<Iceoryx2::ServiceType::Ipc>(service_name)
+                        .event()
+                        .open_or_create()
+                        .expect("failed to open event service")
+                        .notifier_builder()
+                        .create()
+                        .expect("failed to create notifier");
+
+    // The events are drained by the registry thread, which only wakes up the armed handles
+    armed->arm();
+    armed->arm();
+    ASSERT_FALSE(notifier.notify().has_error());
+    EXPECT_TRUE(eventually([&] { return armed_waker.drain().expect("failed to drain waker"); }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(armed_waker.drain().expect("failed to drain waker"));
+    EXPECT_FALSE(idle_waker.drain().expect("failed to drain waker"));
+
+    // Disarmed handles are no longer woken up
+    armed->disarm();
+    ASSERT_FALSE(notifier.notify().has_error());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(armed_waker.drain().expect("failed to drain waker"));
+
+    // Neither are released handles
+    idle->arm();
+    idle.reset();
+    ASSERT_FALSE(notifier.notify().has_error());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(idle_waker.drain().expect("failed to drain waker"));
+}
+
+TEST_F(ListenerRegistryTest, listeners_are_relayed_only_while_shared) {
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::ListenerRegistry;
+    using ::rmw::iox2::Waker;
+    namespace names = ::rmw::iox2::names;
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context");
+    auto& context = context_storage.value();
+    auto& registry = context.listener_registry();
+
+    iox::optional<Waker> waker_storage;
+    create_in_place(waker_storage, context.iox2(), names::waitset(context.id(), context.generate_waitset_id()))
+        .expect("failed to create waker");
+    auto& waker = waker_storage.value();
+
+    const auto service_name = names::topic(create_test_topic().c_str());
+
+    // Held by a single waitset, which attaches the listener itself
+    iox::optional<ListenerRegistry::Handle> first;
+    first.emplace(registry.acquire(service_name, waker).expect("failed to acquire listener"));
+    EXPECT_TRUE(first->exclusive());
+
+    // Shared by another waitset
+    iox::optional<ListenerRegistry::Handle> second;
+    second.emplace(registry.acquire(service_name, waker).expect("failed to acquire listener"));
+    EXPECT_FALSE(first->exclusive());
+    EXPECT_FALSE(second->exclusive());
+
+    second.reset();
+    EXPECT_TRUE(first->exclusive());
+
+    // Relayed for as long as acquired for relaying, e.g. by the event dispatcher
+    iox::optional<ListenerRegistry::Handle> relayed;
+    relayed.emplace(registry.acquire(service_name, waker, true).expect("failed to acquire listener"));
+    EXPECT_FALSE(first->exclusive());
+    relayed.reset();
+    EXPECT_TRUE(first->exclusive());
+    EXPECT_TRUE(registry.healthy());
+}
+
+} // namespace
@@ -10,6 +10,7 @@
 #include <gtest/gtest.h>
 
 #include "rmw_iceoryx2_cxx/impl/message/introspection.hpp"
+#include "rmw_iceoryx2_cxx/impl/message/type_support.hpp"
 #include "rmw_iceoryx2_cxx_test_msgs/msg/defaults.hpp"
 #include "rmw_iceoryx2_cxx_test_msgs/msg/strings.hpp"
 #include "testing/base.hpp"
@@ -48,4 +49,30 @@ TEST_F(MessageIntrospectionTest, sizes) {
               << std::endl;
 }
 
+TEST_F(MessageIntrospectionTest, resolve_message_type) {
+    using rmw::iox2::message_size;
+    using rmw::iox2::resolve;
+    using rmw::iox2::serialized_message_size;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Strings;
+
+    auto defaults = resolve(test_type_support<Defaults>());
+    EXPECT_EQ(defaults.type_support, test_type_support<Defaults>());
+    EXPECT_NE(defaults.callbacks, nullptr);
+    EXPECT_NE(defaults.members, nullptr);
+    EXPECT_EQ(defaults.size, message_size(test_type_support<Defaults>()));
+    EXPECT_TRUE(defaults.is_pod);
+
+    auto strings = resolve(test_type_support<Strings>());
+    EXPECT_NE(strings.callbacks, nullptr);
+    EXPECT_EQ(strings.size, message_size(test_type_support<Strings>()));
+    EXPECT_FALSE(strings.is_pod);
+
+    // Sizing via the resolved callbacks matches sizing via the typesupport
+    Strings strings_msg{};
+    strings_msg.string_value = "GloryToHypnoToad";
+    EXPECT_EQ(serialized_message_size(&strings_msg, strings.callbacks),
+              serialized_message_size(&strings_msg, test_type_support<Strings>()));
+}
+
 } // namespace
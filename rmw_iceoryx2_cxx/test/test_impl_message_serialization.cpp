@@ -0,0 +1,74 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#include <gtest/gtest.h>
+
+#include "rmw_iceoryx2_cxx/impl/message/introspection.hpp"
+#include "rmw_iceoryx2_cxx/impl/message/serialization.hpp"
+#include "rmw_iceoryx2_cxx_test_msgs/msg/strings.hpp"
+#include "testing/base.hpp"
+
+#include <vector>
+
+namespace
+{
+
+using namespace rmw::iox2::testing;
+
+class MessageSerializationTest : public TestBase
+{
+protected:
+    void SetUp() override {
+    }
+
+    void TearDown() override {
+        print_rmw_errors();
+    }
+};
+
+TEST_F(MessageSerializationTest, round_trip_in_oversized_buffer) {
+    using rmw::iox2::deserialize;
+    using rmw::iox2::serialize;
+    using rmw::iox2::serialized_message_size;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Strings;
+
+    Strings input{};
+    input.string_value = "GloryToHypnoToad";
+
+    std::vector<uint8_t> buffer(serialized_message_size(&input, test_type_support<Strings>()) * 2);
+    auto length = serialize(&input, test_type_support<Strings>(), buffer.data(), buffer.size());
+    ASSERT_FALSE(length.has_error());
+    EXPECT_GT(length.value(), 0U);
+    EXPECT_LE(length.value(), buffer.size() / 2);
+
+    // Bytes trailing the serialized message are ignored
+    Strings output{};
+    ASSERT_FALSE(deserialize(buffer.data(), buffer.size(), test_type_support<Strings>(), &output).has_error());
+    EXPECT_EQ(input, output);
+}
+
+TEST_F(MessageSerializationTest, insufficient_capacity_is_detected) {
+    using rmw::iox2::SerializationError;
+    using rmw::iox2::serialize;
+    using rmw::iox2::serialized_message_size;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Strings;
+
+    Strings input{};
+    input.string_value = std::string(1024, 'x');
+
+    std::vector<uint8_t> buffer(serialized_message_size(&input, test_type_support<Strings>()) / 2);
+    auto result = serialize(&input, test_type_support<Strings>(), buffer.data(), buffer.size());
+    ASSERT_TRUE(result.has_error());
+    EXPECT_EQ(result.error(), SerializationError::INSUFFICIENT_CAPACITY);
+
+    buffer.resize(serialized_message_size(&input, test_type_support<Strings>()));
+    EXPECT_FALSE(serialize(&input, test_type_support<Strings>(), buffer.data(), buffer.size()).has_error());
+}
+
+} // namespace
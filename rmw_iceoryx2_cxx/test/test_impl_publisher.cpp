@@ -10,13 +10,25 @@
 #include <gtest/gtest.h>
 
 #include "iox/optional.hpp"
+#include "rcutils/env.h"
+#include "rmw/qos_profiles.h"
 #include "rmw_iceoryx2_cxx/impl/common/create.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/environment.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/context.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/publisher.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/subscriber.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/waitset.hpp"
 #include "rmw_iceoryx2_cxx_test_msgs/msg/defaults.hpp"
 #include "testing/assertions.hpp"
 #include "testing/base.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <thread>
+#include <vector>
+
 namespace
 {
 
@@ -49,7 +61,529 @@ TEST_F(PublisherTest, construction) {
     auto& node = node_storage.value();
 
     iox::optional<Publisher> publisher_storage;
-    ASSERT_FALSE(create_in_place(publisher_storage, node, "Topic", test_type_support<Defaults>()).has_error());
+    ASSERT_FALSE(
+        create_in_place(publisher_storage, node, "Topic", test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+}
+
+TEST_F(PublisherTest, loans_from_multiple_threads) {
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::Node;
+    using ::rmw::iox2::Publisher;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context for publisher creation");
+    auto& context = context_storage.value();
+
+    iox::optional<Node> node_storage;
+    create_in_place(node_storage, context, "Node", "RmwPublisherTest")
+        .expect("failed to create node for publisher creation");
+    auto& node = node_storage.value();
+
+    iox::optional<Publisher> publisher_storage;
+    ASSERT_FALSE(
+        create_in_place(publisher_storage, node, "Topic", test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+    auto& publisher = publisher_storage.value();
+
+    // Fewer threads than loanable samples, so that every loan must succeed
+    constexpr size_t THREADS{4};
+    constexpr size_t ITERATIONS{1000};
+    std::atomic<size_t> failures{0};
+
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < THREADS; thread++) {
+        threads.emplace_back([&] {
+            for (size_t iteration = 0; iteration < ITERATIONS; iteration++) {
+                auto loan = publisher.loan(publisher.unserialized_size());
+                if (loan.has_error()) {
+                    failures++;
+                    continue;
+                }
+                auto returned =
+                    iteration % 2 == 0 ? publisher.publish_loan(loan.value()) : publisher.return_loan(loan.value());
+                if (returned.has_error()) {
+                    failures++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0U);
+}
+
+TEST_F(PublisherTest, segment_grows_to_fit_payloads) {
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::Node;
+    using ::rmw::iox2::Publisher;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context for publisher creation");
+    auto& context = context_storage.value();
+
+    iox::optional<Node> node_storage;
+    create_in_place(node_storage, context, "Node", "RmwPublisherTest")
+        .expect("failed to create node for publisher creation");
+    auto& node = node_storage.value();
+
+    iox::optional<Publisher> publisher_storage;
+    ASSERT_FALSE(
+        create_in_place(publisher_storage, node, "Topic", test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+    auto& publisher = publisher_storage.value();
+
+    auto statistics = publisher.segment_statistics();
+    EXPECT_EQ(statistics.max_slice_len, publisher.unserialized_size());
+    EXPECT_EQ(statistics.resizes, 0U);
+
+    // Payloads that fit do not grow the segment, larger ones grow it to the next power of two
+    const auto large_size = publisher.unserialized_size() * 5;
+    for (auto size : {publisher.unserialized_size(), large_size, large_size - 1, large_size}) {
+        auto loan = publisher.loan(size);
+        ASSERT_FALSE(loan.has_error());
+        ASSERT_FALSE(publisher.return_loan(loan.value()).has_error());
+    }
+    statistics = publisher.segment_statistics();
+    EXPECT_GE(statistics.max_slice_len, large_size);
+    EXPECT_EQ(statistics.max_slice_len & (statistics.max_slice_len - 1), 0U);
+    EXPECT_EQ(statistics.payload_high_water_mark, large_size);
+    EXPECT_EQ(statistics.resizes, 1U);
+
+    // Publishers created later on the topic start out large enough
+    iox::optional<Publisher> late_publisher_storage;
+    ASSERT_FALSE(
+        create_in_place(late_publisher_storage, node, "Topic", test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+    auto& late_publisher = late_publisher_storage.value();
+    EXPECT_EQ(late_publisher.segment_statistics().max_slice_len, large_size);
+
+    auto loan = late_publisher.loan(large_size);
+    ASSERT_FALSE(loan.has_error());
+    ASSERT_FALSE(late_publisher.return_loan(loan.value()).has_error());
+    EXPECT_EQ(late_publisher.segment_statistics().resizes, 0U);
+}
+
+TEST_F(PublisherTest, batch_is_delivered_in_order) {
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::Node;
+    using ::rmw::iox2::Publisher;
+    using ::rmw::iox2::Subscriber;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context for publisher creation");
+    auto& context = context_storage.value();
+
+    iox::optional<Node> node_storage;
+    create_in_place(node_storage, context, "Node", "RmwPublisherTest")
+        .expect("failed to create node for publisher creation");
+    auto& node = node_storage.value();
+
+    const auto topic = create_test_topic();
+    iox::optional<Publisher> publisher_storage;
+    ASSERT_FALSE(
+        create_in_place(
+            publisher_storage, node, topic.c_str(), test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+    auto& publisher = publisher_storage.value();
+
+    iox::optional<Subscriber> subscriber_storage;
+    ASSERT_FALSE(
+        create_in_place(
+            subscriber_storage, node, topic.c_str(), test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+    auto& subscriber = subscriber_storage.value();
+
+    std::vector<Defaults> messages(3);
+    for (size_t i = 0; i < messages.size(); i++) {
+        messages[i].int64_value = static_cast<int64_t>(i);
+    }
+    std::vector<const void*> batch{&messages[0], &messages[1], &messages[2]};
+    ASSERT_FALSE(publisher.publish_batch(batch.data(), batch.size(), sizeof(Defaults)).has_error());
+
+    for (const auto& message : messages) {
+        Defaults received{};
+        auto taken = subscriber.take_copy(&received);
+        ASSERT_FALSE(taken.has_error());
+        ASSERT_TRUE(taken.value());
+        EXPECT_EQ(received.int64_value, message.int64_value);
+    }
+}
+
+TEST_F(PublisherTest, samples_are_stamped_with_message_header) {
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::MessageHeader;
+    using ::rmw::iox2::Node;
+    using ::rmw::iox2::Publisher;
+    using ::rmw::iox2::Subscriber;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context for publisher creation");
+    auto& context = context_storage.value();
+
+    iox::optional<Node> node_storage;
+    create_in_place(node_storage, context, "Node", "RmwPublisherTest")
+        .expect("failed to create node for publisher creation");
+    auto& node = node_storage.value();
+
+    const auto topic = create_test_topic();
+    iox::optional<Publisher> publisher_storage;
+    ASSERT_FALSE(
+        create_in_place(
+            publisher_storage, node, topic.c_str(), test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+    auto& publisher = publisher_storage.value();
+
+    iox::optional<Subscriber> subscriber_storage;
+    ASSERT_FALSE(
+        create_in_place(
+            subscriber_storage, node, topic.c_str(), test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+    auto& subscriber = subscriber_storage.value();
+
+    // Copied and loaned samples are numbered in the order they are sent
+    Defaults message{};
+    ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+    auto loan = publisher.loan(sizeof(Defaults));
+    ASSERT_FALSE(loan.has_error());
+    new (loan.value()) Defaults{};
+    ASSERT_FALSE(publisher.publish_loan(loan.value()).has_error());
+
+    const auto& gid = publisher.unique_id();
+    ASSERT_TRUE(gid.has_value());
+    int64_t previous_timestamp{0};
+    for (uint64_t sequence_number = 1; sequence_number <= 2; sequence_number++) {
+        Defaults received{};
+        MessageHeader header{};
+        auto taken = subscriber.take_copy(&received, &header);
+        ASSERT_FALSE(taken.has_error());
+        ASSERT_TRUE(taken.value());
+        EXPECT_EQ(header.sequence_number, sequence_number);
+        EXPECT_GT(header.source_timestamp, 0);
+        EXPECT_GE(header.source_timestamp, previous_timestamp);
+        EXPECT_TRUE(std::equal(header.publisher_gid, header.publisher_gid + RMW_GID_STORAGE_SIZE, gid->data()));
+        previous_timestamp = header.source_timestamp;
+    }
+}
+
+TEST_F(PublisherTest, reliable_requests_are_best_effort_unless_safe_overflow_is_disabled) {
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::Node;
+    using ::rmw::iox2::Publisher;
+    using ::rmw::iox2::Subscriber;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+    namespace env = ::rmw::iox2::env;
+
+    const auto overwriting_topic = create_test_topic("/overwriting");
+    const auto blocking_topic = create_test_topic("/blocking");
+    const auto path = ::testing::TempDir() + "reliability_" + std::to_string(test_id()) + ".toml";
+    {
+        std::ofstream file{path};
+        file << "[topics.\"" << blocking_topic << "\"]\nsafe_overflow = false\n";
+    }
+    ASSERT_TRUE(rcutils_set_env(env::TOPIC_CONFIG, path.c_str()));
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context");
+    ASSERT_TRUE(rcutils_set_env(env::TOPIC_CONFIG, nullptr));
+
+    iox::optional<Node> node_storage;
+    create_in_place(node_storage, context_storage.value(), "Node", "RmwPublisherTest").expect("failed to create node");
+    auto& node = node_storage.value();
+
+    // The default QoS requests RELIABLE delivery
+    ASSERT_EQ(rmw_qos_profile_default.reliability, RMW_QOS_POLICY_RELIABILITY_RELIABLE);
+    auto reliability_of = [&](const std::string& topic) {
+        iox::optional<Publisher> publisher;
+        iox::optional<Subscriber> subscriber;
+        EXPECT_FALSE(
+            create_in_place(publisher, node, topic.c_str(), test_type_support<Defaults>(), rmw_qos_profile_default)
+                .has_error());
+        EXPECT_FALSE(
+            create_in_place(subscriber, node, topic.c_str(), test_type_support<Defaults>(), rmw_qos_profile_default)
+                .has_error());
+        EXPECT_EQ(publisher->qos().reliability, subscriber->qos().reliability);
+        return publisher->qos().reliability;
+    };
+
+    // Samples of full queues are overwritten by default, which is reported as BEST_EFFORT along with a warning
+    EXPECT_EQ(reliability_of(overwriting_topic), RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT);
+
+    // Publishers block until subscribers have space once safe overflow is disabled
+    EXPECT_EQ(reliability_of(blocking_topic), RMW_QOS_POLICY_RELIABILITY_RELIABLE);
+}
+
+TEST_F(PublisherTest, coalesced_notifications_are_deferred_until_the_next_wait) {
+    using ::iox::units::Duration;
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::Node;
+    using ::rmw::iox2::Publisher;
+    using ::rmw::iox2::Subscriber;
+    using ::rmw::iox2::WaitSet;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+    namespace env = ::rmw::iox2::env;
+
+    const auto topic = create_test_topic();
+    const auto path = ::testing::TempDir() + "coalesce_" + std::to_string(test_id()) + ".toml";
+    {
+        std::ofstream file{path};
+        file << "[topics.\"" << topic << "\"]\ncoalesce_notifications = true\n";
+    }
+
+    // The publisher and subscriber are placed in separate contexts, so that waiting for the subscriber does not flush
+    // the notifications of the publisher
+    ASSERT_TRUE(rcutils_set_env(env::TOPIC_CONFIG, path.c_str()));
+    iox::optional<Context> publisher_context_storage;
+    create_in_place(publisher_context_storage, test_id()).expect("failed to create context for publisher");
+    ASSERT_TRUE(rcutils_set_env(env::TOPIC_CONFIG, nullptr));
+    auto& publisher_context = publisher_context_storage.value();
+
+    iox::optional<Context> subscriber_context_storage;
+    create_in_place(subscriber_context_storage, test_id()).expect("failed to create context for subscriber");
+    auto& subscriber_context = subscriber_context_storage.value();
+
+    iox::optional<Node> publisher_node_storage;
+    create_in_place(publisher_node_storage, publisher_context, "Publisher", "RmwPublisherTest")
+        .expect("failed to create node for publisher creation");
+    iox::optional<Node> subscriber_node_storage;
+    create_in_place(subscriber_node_storage, subscriber_context, "Subscriber", "RmwPublisherTest")
+        .expect("failed to create node for subscriber creation");
+
+    iox::optional<Publisher> publisher_storage;
+    ASSERT_FALSE(create_in_place(publisher_storage,
+                                 publisher_node_storage.value(),
+                                 topic.c_str(),
+                                 test_type_support<Defaults>(),
+                                 rmw_qos_profile_default)
+                     .has_error());
+    auto& publisher = publisher_storage.value();
+
+    iox::optional<Subscriber> subscriber_storage;
+    ASSERT_FALSE(create_in_place(subscriber_storage,
+                                 subscriber_node_storage.value(),
+                                 topic.c_str(),
+                                 test_type_support<Defaults>(),
+                                 rmw_qos_profile_default)
+                     .has_error());
+
+    iox::optional<WaitSet> waitset_storage;
+    create_in_place(waitset_storage, subscriber_context).expect("failed to create waitset");
+    auto& waitset = waitset_storage.value();
+    ASSERT_FALSE(waitset.map(0, subscriber_storage.value()).has_error());
+
+    std::atomic<bool> woken{false};
+    std::thread waiter([&] {
+        auto result = waitset.wait(Duration::fromSeconds(5));
+        EXPECT_FALSE(result.has_error());
+        woken = true;
+    });
+
+    // Published while the waiter is blocked from a thread waiting in the context of the publisher, like an executor,
+    // the notification is deferred
+    publisher_context.mark_waiting_thread();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    Defaults message{};
+    ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(woken.load());
+
+    // Waiting in the context of the publisher flushes the notification
+    publisher_context.flush_deferred_notifications();
+    waiter.join();
+    EXPECT_TRUE(woken.load());
+}
+
+TEST_F(PublisherTest, coalesced_notifications_are_bounded) {
+    using ::iox::units::Duration;
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::Node;
+    using ::rmw::iox2::Publisher;
+    using ::rmw::iox2::Subscriber;
+    using ::rmw::iox2::WaitSet;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+    namespace env = ::rmw::iox2::env;
+
+    const auto topic = create_test_topic();
+    const auto path = ::testing::TempDir() + "coalesce_" + std::to_string(test_id()) + ".toml";
+    {
+        std::ofstream file{path};
+        file << "[topics.\"" << topic << "\"]\ncoalesce_notifications = true\n";
+    }
+
+    // The publisher and subscriber are placed in separate contexts, so that waiting for the subscriber does not flush
+    // the notifications of the publisher
+    ASSERT_TRUE(rcutils_set_env(env::TOPIC_CONFIG, path.c_str()));
+    iox::optional<Context> publisher_context_storage;
+    create_in_place(publisher_context_storage, test_id()).expect("failed to create context for publisher");
+    ASSERT_TRUE(rcutils_set_env(env::TOPIC_CONFIG, nullptr));
+    auto& publisher_context = publisher_context_storage.value();
+
+    iox::optional<Context> subscriber_context_storage;
+    create_in_place(subscriber_context_storage, test_id()).expect("failed to create context for subscriber");
+    auto& subscriber_context = subscriber_context_storage.value();
+
+    iox::optional<Node> publisher_node_storage;
+    create_in_place(publisher_node_storage, publisher_context, "Publisher", "RmwPublisherTest")
+        .expect("failed to create node for publisher creation");
+    iox::optional<Node> subscriber_node_storage;
+    create_in_place(subscriber_node_storage, subscriber_context, "Subscriber", "RmwPublisherTest")
+        .expect("failed to create node for subscriber creation");
+
+    iox::optional<Publisher> publisher_storage;
+    ASSERT_FALSE(create_in_place(publisher_storage,
+                                 publisher_node_storage.value(),
+                                 topic.c_str(),
+                                 test_type_support<Defaults>(),
+                                 rmw_qos_profile_default)
+                     .has_error());
+    auto& publisher = publisher_storage.value();
+
+    iox::optional<Subscriber> subscriber_storage;
+    ASSERT_FALSE(create_in_place(subscriber_storage,
+                                 subscriber_node_storage.value(),
+                                 topic.c_str(),
+                                 test_type_support<Defaults>(),
+                                 rmw_qos_profile_default)
+                     .has_error());
+
+    iox::optional<WaitSet> waitset_storage;
+    create_in_place(waitset_storage, subscriber_context).expect("failed to create waitset");
+    auto& waitset = waitset_storage.value();
+    ASSERT_FALSE(waitset.map(0, subscriber_storage.value()).has_error());
+
+    auto& subscriber = subscriber_storage.value();
+    auto wait_for_message = [&](auto&& publish) {
+        std::atomic<bool> woken{false};
+        std::thread waiter([&] {
+            auto result = waitset.wait(Duration::fromSeconds(5));
+            EXPECT_FALSE(result.has_error());
+            woken = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        publish();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        auto woken_before_flush = woken.load();
+
+        // Unblock the waiter regardless
+        publisher_context.flush_deferred_notifications();
+        waiter.join();
+
+        Defaults received{};
+        for (auto taken = subscriber.take_copy(&received); !taken.has_error() && taken.value();
+             taken = subscriber.take_copy(&received)) {
+        }
+        return woken_before_flush;
+    };
+
+    // Threads that never wait in the context of the publisher, e.g. timer threads, notify immediately
+    Defaults message{};
+    EXPECT_TRUE(wait_for_message([&] {
+        std::thread([&] { ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error()); }).join();
+    }));
+
+    // Threads waiting in the context defer the notification until the subscriber buffer would be full
+    publisher_context.mark_waiting_thread();
+    const auto buffer_size = subscriber.qos().depth;
+    ASSERT_GT(buffer_size, 1U);
+    EXPECT_FALSE(wait_for_message([&] {
+        for (size_t i = 0; i + 1 < buffer_size; i++) {
+            ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+        }
+    }));
+    EXPECT_TRUE(wait_for_message([&] {
+        for (size_t i = 0; i < buffer_size; i++) {
+            ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+        }
+    }));
+}
+
+TEST_F(PublisherTest, idle_notifications_are_suppressed) {
+    using ::iox::units::Duration;
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::Node;
+    using ::rmw::iox2::Publisher;
+    using ::rmw::iox2::Subscriber;
+    using ::rmw::iox2::WaiterCount;
+    using ::rmw::iox2::WaitSet;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+    namespace env = ::rmw::iox2::env;
+
+    const auto topic = create_test_topic();
+    const auto path = ::testing::TempDir() + "suppress_" + std::to_string(test_id()) + ".toml";
+    {
+        std::ofstream file{path};
+        file << "[topics.\"" << topic << "\"]\nsuppress_idle_notifications = true\n";
+    }
+    ASSERT_TRUE(rcutils_set_env(env::TOPIC_CONFIG, path.c_str()));
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context");
+    ASSERT_TRUE(rcutils_set_env(env::TOPIC_CONFIG, nullptr));
+    auto& context = context_storage.value();
+
+    iox::optional<Node> node_storage;
+    create_in_place(node_storage, context, "Node", "RmwPublisherTest").expect("failed to create node");
+    auto& node = node_storage.value();
+
+    iox::optional<Publisher> publisher_storage;
+    ASSERT_FALSE(
+        create_in_place(
+            publisher_storage, node, topic.c_str(), test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+    auto& publisher = publisher_storage.value();
+
+    iox::optional<Subscriber> subscriber_storage;
+    ASSERT_FALSE(
+        create_in_place(
+            subscriber_storage, node, topic.c_str(), test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+    auto& subscriber = subscriber_storage.value();
+    ASSERT_NE(subscriber.waiters(), nullptr);
+
+    iox::optional<WaitSet> waitset_storage;
+    create_in_place(waitset_storage, context).expect("failed to create waitset");
+    auto& waitset = waitset_storage.value();
+    ASSERT_FALSE(waitset.map(0, subscriber).has_error());
+
+    // Nobody is waiting, the sample is found by polling before blocking
+    Defaults message{};
+    ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+    EXPECT_EQ(publisher.suppressed_notifications(), 1U);
+    auto polled = waitset.wait(Duration::fromMilliseconds(100));
+    ASSERT_FALSE(polled.has_error());
+    EXPECT_EQ(polled.value(), 1U);
+    Defaults received{};
+    ASSERT_TRUE(subscriber.take_copy(&received).value());
+
+    // A blocked waitset is notified
+    iox::optional<WaiterCount> probe;
+    ASSERT_FALSE(create_in_place(probe, subscriber.service_name()).has_error());
+    std::atomic<size_t> triggered{0};
+    std::thread waiter([&] {
+        auto result = waitset.wait(Duration::fromSeconds(5));
+        EXPECT_FALSE(result.has_error());
+        triggered = result.value();
+    });
+    while (!probe->any_waiting()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+    waiter.join();
+    EXPECT_EQ(triggered.load(), 1U);
+    EXPECT_EQ(publisher.suppressed_notifications(), 1U);
+    EXPECT_FALSE(probe->any_waiting());
 }
 
 } // namespace
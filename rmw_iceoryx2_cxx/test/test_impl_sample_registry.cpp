@@ -15,13 +15,41 @@
 #include "iox2/service_name.hpp"
 #include "rmw_iceoryx2_cxx/impl/middleware/iceoryx2.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/sample_registry.hpp"
+#include "testing/allocation_counter.hpp"
 #include "testing/base.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 namespace
 {
 
 using namespace rmw::iox2::testing;
 
+/// Minimal stand-in for an iceoryx2 sample, exposing the payload address only
+struct FakeSample
+{
+    struct Payload
+    {
+        const uint8_t* ptr;
+        auto data() const -> const uint8_t* {
+            return ptr;
+        }
+    };
+
+    auto payload() const -> Payload {
+        return Payload{ptr};
+    }
+
+    const uint8_t* ptr;
+};
+
 class RmwSampleRegistryTest : public TestBase
 {
 protected:
@@ -38,7 +66,7 @@ TEST_F(RmwSampleRegistryTest, store_and_retrieve_loaned_publisher_sample) {
     using ::rmw::iox2::Iceoryx2;
     using ::rmw::iox2::SampleRegistry;
 
-    SampleRegistry<Sample> sut{};
+    SampleRegistry<Sample> sut{1};
 
     auto iox2 = Iceoryx2::InstanceBuilder()
                     .name(Iceoryx2::InstanceName::create("rmw_sample_registry_test::store_loaned_sample")
@@ -59,7 +87,9 @@ TEST_F(RmwSampleRegistryTest, store_and_retrieve_loaned_publisher_sample) {
     auto sample_ptr = sample.payload().data();
     ASSERT_NE(sample_ptr, nullptr);
 
-    auto stored_ptr = sut.store(std::move(sample));
+    auto stored = sut.store(std::move(sample));
+    ASSERT_FALSE(stored.has_error());
+    auto stored_ptr = stored.value();
     ASSERT_NE(stored_ptr, nullptr);
 
     ASSERT_EQ(sample_ptr, stored_ptr);
@@ -70,4 +100,315 @@ TEST_F(RmwSampleRegistryTest, store_and_retrieve_loaned_publisher_sample) {
     ASSERT_EQ(released_ptr, sample_ptr);
 }
 
+TEST_F(RmwSampleRegistryTest, store_fails_when_capacity_exceeded) {
+    using ::rmw::iox2::SampleRegistry;
+    using ::rmw::iox2::SampleRegistryError;
+
+    std::array<uint8_t, 3> payloads{};
+    SampleRegistry<FakeSample> sut{2};
+    ASSERT_EQ(sut.capacity(), 2U);
+
+    auto first = sut.store(FakeSample{&payloads[0]});
+    ASSERT_FALSE(first.has_error());
+    ASSERT_FALSE(sut.store(FakeSample{&payloads[1]}).has_error());
+    EXPECT_EQ(sut.size(), 2U);
+
+    auto exceeded = sut.store(FakeSample{&payloads[2]});
+    ASSERT_TRUE(exceeded.has_error());
+    EXPECT_EQ(exceeded.error(), SampleRegistryError::CAPACITY_EXCEEDED);
+
+    // Releasing a sample frees its slot for re-use
+    ASSERT_FALSE(sut.release(first.value()).has_error());
+    EXPECT_EQ(sut.size(), 1U);
+    ASSERT_FALSE(sut.store(FakeSample{&payloads[2]}).has_error());
+    EXPECT_TRUE(sut.retrieve(&payloads[2]).has_value());
+    EXPECT_FALSE(sut.retrieve(&payloads[0]).has_value());
+
+    auto invalid = sut.release(&payloads[0]);
+    ASSERT_TRUE(invalid.has_error());
+    EXPECT_EQ(invalid.error(), SampleRegistryError::INVALID_PAYLOAD);
+}
+
+TEST_F(RmwSampleRegistryTest, statistics_track_outstanding_loans) {
+    using ::rmw::iox2::SampleRegistry;
+
+    std::array<uint8_t, 3> payloads{};
+    SampleRegistry<FakeSample> sut{4};
+
+    auto statistics = sut.statistics();
+    EXPECT_EQ(statistics.capacity, 4U);
+    EXPECT_EQ(statistics.outstanding, 0U);
+    EXPECT_EQ(statistics.high_water_mark, 0U);
+    EXPECT_EQ(statistics.oldest_loan_age.count(), 0);
+
+    for (auto& payload : payloads) {
+        ASSERT_FALSE(sut.store(FakeSample{&payload}).has_error());
+    }
+    ASSERT_FALSE(sut.release(&payloads[1]).has_error());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    statistics = sut.statistics();
+    EXPECT_EQ(statistics.outstanding, 2U);
+    EXPECT_EQ(statistics.high_water_mark, 3U);
+    EXPECT_GE(statistics.oldest_loan_age, std::chrono::milliseconds(10));
+
+    // The age is that of the oldest loan still held
+    ASSERT_FALSE(sut.release(&payloads[0]).has_error());
+    ASSERT_FALSE(sut.store(FakeSample{&payloads[0]}).has_error());
+    ASSERT_FALSE(sut.release(&payloads[2]).has_error());
+    statistics = sut.statistics();
+    EXPECT_LT(statistics.oldest_loan_age, std::chrono::milliseconds(10));
+
+    ASSERT_FALSE(sut.release(&payloads[0]).has_error());
+    statistics = sut.statistics();
+    EXPECT_EQ(statistics.outstanding, 0U);
+    EXPECT_EQ(statistics.high_water_mark, 3U);
+    EXPECT_EQ(statistics.oldest_loan_age.count(), 0);
+}
+
+TEST_F(RmwSampleRegistryTest, release_all_removes_requested_samples) {
+    using ::rmw::iox2::SampleRegistry;
+
+    std::array<uint8_t, 4> payloads{};
+    SampleRegistry<FakeSample> sut{4};
+    for (auto& payload : payloads) {
+        ASSERT_FALSE(sut.store(FakeSample{&payload}).has_error());
+    }
+
+    // Pointers that are not stored are ignored
+    uint8_t unknown{0};
+    std::array<const void*, 3> requested{&payloads[3], &unknown, &payloads[1]};
+    std::vector<const uint8_t*> consumed;
+    auto released = sut.release_all(
+        requested.data(), requested.size(), [&consumed](FakeSample&& sample) { consumed.push_back(sample.ptr); });
+
+    EXPECT_EQ(released, 2U);
+    EXPECT_EQ(sut.size(), 2U);
+    ASSERT_EQ(consumed.size(), 2U);
+    EXPECT_NE(std::find(consumed.begin(), consumed.end(), &payloads[1]), consumed.end());
+    EXPECT_NE(std::find(consumed.begin(), consumed.end(), &payloads[3]), consumed.end());
+    EXPECT_TRUE(sut.retrieve(&payloads[0]).has_value());
+    EXPECT_FALSE(sut.retrieve(&payloads[1]).has_value());
+    EXPECT_TRUE(sut.retrieve(&payloads[2]).has_value());
+    EXPECT_FALSE(sut.retrieve(&payloads[3]).has_value());
+}
+
+// Measures the cost of storing and releasing samples. Run explicitly with
+// --gtest_also_run_disabled_tests --gtest_filter=*benchmark_store_and_release
+TEST_F(RmwSampleRegistryTest, DISABLED_benchmark_store_and_release) {
+    using ::rmw::iox2::SampleRegistry;
+
+    // Mimics loaning and publishing (or taking and returning) with a few loans outstanding
+    constexpr size_t ITERATIONS{100000};
+    constexpr size_t CAPACITY{8};
+    constexpr size_t OUTSTANDING{2};
+    std::array<uint8_t, OUTSTANDING> payloads{};
+
+    SampleRegistry<FakeSample> registry{CAPACITY};
+    size_t registry_allocations{0};
+    auto registry_start = std::chrono::steady_clock::now();
+    {
+        AllocationCounter counter;
+        for (size_t iteration = 0; iteration < ITERATIONS; iteration++) {
+            for (auto& payload : payloads) {
+                ASSERT_FALSE(registry.store(FakeSample{&payload}).has_error());
+            }
+            for (auto& payload : payloads) {
+                ASSERT_FALSE(registry.release(&payload).has_error());
+            }
+        }
+        registry_allocations = counter.count();
+    }
+    auto registry_end = std::chrono::steady_clock::now();
+
+    // Baseline using a node-based hash map, as previously used by the registry
+    std::unordered_map<const uint8_t*, FakeSample> map;
+    size_t map_allocations{0};
+    auto map_start = std::chrono::steady_clock::now();
+    {
+        AllocationCounter counter;
+        for (size_t iteration = 0; iteration < ITERATIONS; iteration++) {
+            for (auto& payload : payloads) {
+                map.emplace(&payload, FakeSample{&payload});
+            }
+            for (auto& payload : payloads) {
+                auto it = map.find(&payload);
+                ASSERT_NE(it, map.end());
+                map.erase(it);
+            }
+        }
+        map_allocations = counter.count();
+    }
+    auto map_end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(registry_allocations, 0U);
+
+    auto per_cycle = [](auto start, auto end) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        return static_cast<double>(elapsed) / static_cast<double>(ITERATIONS * OUTSTANDING);
+    };
+    auto registry_ns = per_cycle(registry_start, registry_end);
+    auto map_ns = per_cycle(map_start, map_end);
+    std::cout << "[ BENCHMARK] store and release: " << registry_ns << " ns per sample, " << registry_allocations
+              << " allocations (registry) vs " << map_ns << " ns per sample, " << map_allocations
+              << " allocations (unordered_map)" << std::endl;
+    RecordProperty("store_release_ns_registry", std::to_string(registry_ns));
+    RecordProperty("store_release_ns_unordered_map", std::to_string(map_ns));
+}
+
+TEST_F(RmwSampleRegistryTest, concurrent_store_and_release_keeps_samples_exclusive) {
+    using ::rmw::iox2::SampleRegistry;
+    using ::rmw::iox2::SampleRegistryError;
+
+    // Fewer slots than threads, so that threads compete for slots and stores regularly fail
+    constexpr size_t THREADS{8};
+    constexpr size_t CAPACITY{THREADS / 2};
+    constexpr size_t ITERATIONS{20000};
+    std::array<uint8_t, THREADS> payloads{};
+
+    SampleRegistry<FakeSample> sut{CAPACITY};
+    std::atomic<size_t> violations{0};
+    std::atomic<size_t> stored{0};
+
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < THREADS; thread++) {
+        threads.emplace_back([&, payload = &payloads[thread]] {
+            for (size_t iteration = 0; iteration < ITERATIONS; iteration++) {
+                auto ptr = sut.store(FakeSample{payload});
+                if (ptr.has_error()) {
+                    if (ptr.error() != SampleRegistryError::CAPACITY_EXCEEDED) {
+                        violations++;
+                    }
+                    continue;
+                }
+                stored++;
+
+                // The sample must remain unaffected by the other threads until released
+                auto retrieved = sut.retrieve(ptr.value());
+                if (!retrieved.has_value() || retrieved.value()->ptr != payload) {
+                    violations++;
+                }
+                auto released = sut.release(ptr.value());
+                if (released.has_error() || released->ptr != payload) {
+                    violations++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(violations.load(), 0U);
+    EXPECT_GT(stored.load(), 0U);
+    EXPECT_EQ(sut.size(), 0U);
+}
+
+TEST_F(RmwSampleRegistryTest, release_from_other_thread_than_store) {
+    using ::rmw::iox2::SampleRegistry;
+
+    // Mimics loans taken on one executor thread and returned on another
+    constexpr size_t ITERATIONS{20000};
+    constexpr size_t CAPACITY{8};
+    std::array<uint8_t, CAPACITY> payloads{};
+
+    SampleRegistry<FakeSample> sut{CAPACITY};
+    std::array<std::atomic<uint8_t*>, CAPACITY> handover{};
+    std::atomic<size_t> failures{0};
+
+    std::thread producer([&] {
+        for (size_t iteration = 0; iteration < ITERATIONS; iteration++) {
+            auto index = iteration % CAPACITY;
+            while (handover[index].load(std::memory_order_acquire) != nullptr) {
+                std::this_thread::yield();
+            }
+            auto ptr = sut.store(FakeSample{&payloads[index]});
+            if (ptr.has_error()) {
+                failures++;
+                continue;
+            }
+            handover[index].store(ptr.value(), std::memory_order_release);
+        }
+    });
+    std::thread consumer([&] {
+        for (size_t iteration = 0; iteration < ITERATIONS; iteration++) {
+            auto index = iteration % CAPACITY;
+            uint8_t* ptr{nullptr};
+            while ((ptr = handover[index].load(std::memory_order_acquire)) == nullptr) {
+                if (failures.load() > 0) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+            auto released = sut.release(ptr);
+            if (released.has_error() || released->ptr != &payloads[index]) {
+                failures++;
+            }
+            handover[index].store(nullptr, std::memory_order_release);
+        }
+    });
+    producer.join();
+    consumer.join();
+
+    EXPECT_EQ(failures.load(), 0U);
+    EXPECT_EQ(sut.size(), 0U);
+}
+
+// Measures how storing and releasing samples scales with concurrent threads. Run explicitly with
+// --gtest_also_run_disabled_tests --gtest_filter=*concurrent_store_and_release_scaling
+TEST_F(RmwSampleRegistryTest, DISABLED_benchmark_concurrent_store_and_release_scaling) {
+    using ::rmw::iox2::SampleRegistry;
+
+    constexpr size_t MAX_THREADS{16};
+    constexpr size_t ITERATIONS{20000};
+    constexpr size_t OUTSTANDING{2};
+    constexpr size_t CAPACITY{MAX_THREADS * OUTSTANDING};
+
+    for (size_t thread_count = 1; thread_count <= MAX_THREADS; thread_count *= 2) {
+        SampleRegistry<FakeSample> registry{CAPACITY};
+        std::vector<std::array<uint8_t, OUTSTANDING>> payloads(thread_count);
+        std::atomic<size_t> failures{0};
+        std::atomic<bool> start{false};
+
+        std::vector<std::thread> threads;
+        for (size_t thread = 0; thread < thread_count; thread++) {
+            threads.emplace_back([&, thread] {
+                while (!start.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (size_t iteration = 0; iteration < ITERATIONS; iteration++) {
+                    for (auto& payload : payloads[thread]) {
+                        if (registry.store(FakeSample{&payload}).has_error()) {
+                            failures++;
+                        }
+                    }
+                    for (auto& payload : payloads[thread]) {
+                        if (registry.release(&payload).has_error()) {
+                            failures++;
+                        }
+                    }
+                }
+            });
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        start.store(true, std::memory_order_release);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        EXPECT_EQ(failures.load(), 0U);
+        EXPECT_EQ(registry.size(), 0U);
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+        auto samples = static_cast<double>(thread_count * ITERATIONS * OUTSTANDING);
+        auto million_per_second = samples / static_cast<double>(elapsed) * 1000.0;
+        std::cout << "[ BENCHMARK] concurrent store and release with " << thread_count
+                  << " threads: " << million_per_second << " M samples/s" << std::endl;
+        RecordProperty("store_release_msps_" + std::to_string(thread_count) + "_threads",
+                       std::to_string(million_per_second));
+    }
+}
+
 } // namespace
@@ -10,13 +10,21 @@
 #include <gtest/gtest.h>
 
 #include "iox/optional.hpp"
+#include "rcutils/env.h"
+#include "rmw/qos_profiles.h"
 #include "rmw_iceoryx2_cxx/impl/common/create.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/environment.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/context.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/publisher.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/subscriber.hpp"
 #include "rmw_iceoryx2_cxx_test_msgs/msg/defaults.hpp"
 #include "testing/assertions.hpp"
 #include "testing/base.hpp"
 
+#include <fstream>
+#include <string>
+#include <vector>
+
 namespace
 {
 
@@ -49,7 +57,167 @@ TEST_F(SubscriberTest, construction) {
     auto& node = node_storage.value();
 
     iox::optional<Subscriber> subscriber_storage;
-    ASSERT_FALSE(create_in_place(subscriber_storage, node, "Topic", test_type_support<Defaults>()).has_error());
+    ASSERT_FALSE(
+        create_in_place(subscriber_storage, node, "Topic", test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+}
+
+TEST_F(SubscriberTest, keep_latest_is_only_enabled_via_the_topic_configuration) {
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::Node;
+    using ::rmw::iox2::Subscriber;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context for subscriber creation");
+    iox::optional<Node> node_storage;
+    create_in_place(node_storage, context_storage.value(), "Node", "SubscriberTest").expect("failed to create node");
+    auto& node = node_storage.value();
+
+    const auto topic = create_test_topic();
+    auto latest_qos = rmw_qos_profile_default;
+    latest_qos.depth = 1;
+    iox::optional<Subscriber> latest;
+    ASSERT_FALSE(create_in_place(latest, node, topic.c_str(), test_type_support<Defaults>(), latest_qos).has_error());
+    EXPECT_FALSE(latest->keep_latest());
+    EXPECT_EQ(latest->qos().depth, 1U);
+
+    iox::optional<Subscriber> queued;
+    ASSERT_FALSE(
+        create_in_place(queued, node, topic.c_str(), test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+    EXPECT_FALSE(queued->keep_latest());
+
+    // Notifications are not suppressed by default, thus no waiter count is opened
+    EXPECT_EQ(queued->waiters(), nullptr);
+}
+
+TEST_F(SubscriberTest, keep_latest_takes_only_the_newest_sample) {
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::MessageHeader;
+    using ::rmw::iox2::Node;
+    using ::rmw::iox2::Publisher;
+    using ::rmw::iox2::Subscriber;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+    namespace env = ::rmw::iox2::env;
+
+    const auto topic = create_test_topic();
+    const auto path = ::testing::TempDir() + "keep_latest_" + std::to_string(test_id()) + ".toml";
+    {
+        std::ofstream file{path};
+        file << "[topics.\"" << topic << "\"]\nkeep_latest = true\n";
+    }
+    ASSERT_TRUE(rcutils_set_env(env::TOPIC_CONFIG, path.c_str()));
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context for subscriber creation");
+    ASSERT_TRUE(rcutils_set_env(env::TOPIC_CONFIG, nullptr));
+
+    iox::optional<Node> node_storage;
+    create_in_place(node_storage, context_storage.value(), "Node", "SubscriberTest").expect("failed to create node");
+    auto& node = node_storage.value();
+
+    iox::optional<Publisher> publisher_storage;
+    ASSERT_FALSE(
+        create_in_place(
+            publisher_storage, node, topic.c_str(), test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+    auto& publisher = publisher_storage.value();
+
+    iox::optional<Subscriber> subscriber_storage;
+    ASSERT_FALSE(
+        create_in_place(
+            subscriber_storage, node, topic.c_str(), test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+    auto& subscriber = subscriber_storage.value();
+    ASSERT_TRUE(subscriber.keep_latest());
+    EXPECT_EQ(subscriber.qos().depth, 1U);
+
+    // All published samples are queued by the subscriber, copies and loans both skip the stale samples
+    constexpr uint64_t PUBLISHED{5};
+    ASSERT_GT(rmw_qos_profile_default.depth, PUBLISHED);
+    Defaults message{};
+    for (uint64_t i = 0; i < PUBLISHED; i++) {
+        ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+    }
+    Defaults received{};
+    MessageHeader header{};
+    auto taken = subscriber.take_copy(&received, &header);
+    ASSERT_FALSE(taken.has_error());
+    ASSERT_TRUE(taken.value());
+    EXPECT_EQ(header.sequence_number, PUBLISHED);
+    taken = subscriber.take_copy(&received, &header);
+    ASSERT_FALSE(taken.has_error());
+    EXPECT_FALSE(taken.value());
+
+    for (uint64_t i = 0; i < PUBLISHED; i++) {
+        ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+    }
+    auto loan = subscriber.take_loan();
+    ASSERT_FALSE(loan.has_error());
+    ASSERT_TRUE(loan.value().has_value());
+    EXPECT_EQ(loan.value()->header.sequence_number, 2 * PUBLISHED);
+    EXPECT_EQ(subscriber.loan_statistics().outstanding, 1U);
+    ASSERT_FALSE(subscriber.return_loan(loan.value()->bytes).has_error());
+}
+
+TEST_F(SubscriberTest, batch_returns_messages_taken_before_a_failure) {
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::MessageHeader;
+    using ::rmw::iox2::Node;
+    using ::rmw::iox2::Publisher;
+    using ::rmw::iox2::Subscriber;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context for subscriber creation");
+    iox::optional<Node> node_storage;
+    create_in_place(node_storage, context_storage.value(), "Node", "SubscriberTest").expect("failed to create node");
+    auto& node = node_storage.value();
+
+    const auto topic = create_test_topic();
+    iox::optional<Publisher> publisher_storage;
+    ASSERT_FALSE(
+        create_in_place(
+            publisher_storage, node, topic.c_str(), test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+    auto& publisher = publisher_storage.value();
+    iox::optional<Subscriber> subscriber_storage;
+    ASSERT_FALSE(
+        create_in_place(
+            subscriber_storage, node, topic.c_str(), test_type_support<Defaults>(), rmw_qos_profile_default)
+            .has_error());
+    auto& subscriber = subscriber_storage.value();
+
+    constexpr uint64_t PUBLISHED{3};
+    Defaults message{};
+    for (uint64_t i = 0; i < PUBLISHED; i++) {
+        ASSERT_FALSE(publisher.publish_copy(&message, sizeof(Defaults)).has_error());
+    }
+
+    // The second message fails to be handled, the first is returned and the failure reported by the next call
+    std::vector<uint64_t> handled;
+    auto handler = [&](size_t index, const MessageHeader& header, const uint8_t*, size_t) {
+        if (header.sequence_number == 2) {
+            return false;
+        }
+        EXPECT_EQ(index, handled.size());
+        handled.push_back(header.sequence_number);
+        return true;
+    };
+    auto taken = subscriber.take_batch(PUBLISHED, handler);
+    ASSERT_FALSE(taken.has_error());
+    EXPECT_EQ(taken.value(), 1U);
+    EXPECT_TRUE(subscriber.take_batch(PUBLISHED, handler).has_error());
+
+    handled.clear();
+    taken = subscriber.take_batch(PUBLISHED, handler);
+    ASSERT_FALSE(taken.has_error());
+    EXPECT_EQ(taken.value(), 1U);
+    ASSERT_EQ(handled.size(), 1U);
+    EXPECT_EQ(handled.front(), PUBLISHED);
 }
 
 } // namespace
@@ -0,0 +1,203 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#include <gtest/gtest.h>
+
+#include "iox/optional.hpp"
+#include "rcutils/env.h"
+#include "rmw/qos_profiles.h"
+#include "rmw_iceoryx2_cxx/impl/common/create.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/environment.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/topic_config.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/context.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/publisher.hpp"
+#include "rmw_iceoryx2_cxx_test_msgs/msg/defaults.hpp"
+#include "testing/base.hpp"
+
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+
+using namespace rmw::iox2::testing;
+
+class TopicConfigTest : public TestBase
+{
+protected:
+    void SetUp() override {
+    }
+
+    void TearDown() override {
+        rcutils_reset_error();
+    }
+
+    static auto parse(const std::string& text) {
+        std::istringstream input{text};
+        return ::rmw::iox2::TopicConfig::parse(input);
+    }
+};
+
+TEST_F(TopicConfigTest, unconfigured_topics_use_defaults) {
+    using ::rmw::iox2::TopicConfig;
+    using ::rmw::iox2::TopicSettings;
+
+    TopicConfig sut;
+    const auto& settings = sut.settings("/chatter");
+    const TopicSettings defaults;
+    EXPECT_EQ(settings.max_publishers, defaults.max_publishers);
+    EXPECT_EQ(settings.max_subscribers, defaults.max_subscribers);
+    EXPECT_EQ(settings.history_size, defaults.history_size);
+    EXPECT_EQ(settings.subscriber_max_buffer_size, defaults.subscriber_max_buffer_size);
+    EXPECT_EQ(settings.max_loaned_samples, defaults.max_loaned_samples);
+    EXPECT_EQ(settings.priority, defaults.priority);
+    EXPECT_EQ(settings.borrowed_samples(), settings.subscriber_max_buffer_size);
+}
+
+TEST_F(TopicConfigTest, topics_override_defaults) {
+    auto sut = parse(R"(
+# Topics inherit the defaults wherever these are placed
+[topics."/points"]
+max_loaned_samples = 2
+history_size = 0
+suppress_idle_notifications = true
+keep_latest = true
+
+[defaults]
+subscriber_max_buffer_size = 4
+max_publishers = 8
+
+[topics."/imu"]
+subscriber_max_buffer_size = 128
+subscriber_max_borrowed_samples = 16
+priority = 3
+coalesce_notifications = true
+)");
+    ASSERT_FALSE(sut.has_error());
+
+    const auto& points = sut->settings("/points");
+    EXPECT_EQ(points.max_loaned_samples, 2U);
+    EXPECT_EQ(points.history_size, 0U);
+    EXPECT_EQ(points.subscriber_max_buffer_size, 4U);
+    EXPECT_EQ(points.max_publishers, 8U);
+    EXPECT_EQ(points.borrowed_samples(), 4U);
+    EXPECT_TRUE(points.suppress_idle_notifications);
+    EXPECT_TRUE(points.keep_latest);
+
+    const auto& imu = sut->settings("/imu");
+    EXPECT_EQ(imu.subscriber_max_buffer_size, 128U);
+    EXPECT_EQ(imu.borrowed_samples(), 16U);
+    EXPECT_EQ(imu.priority, 3U);
+    EXPECT_EQ(imu.max_publishers, 8U);
+    EXPECT_TRUE(imu.coalesce_notifications);
+
+    const auto& other = sut->settings("/other");
+    EXPECT_EQ(other.subscriber_max_buffer_size, 4U);
+    EXPECT_EQ(other.max_publishers, 8U);
+    EXPECT_EQ(other.priority, 0U);
+    EXPECT_FALSE(other.coalesce_notifications);
+    EXPECT_FALSE(other.suppress_idle_notifications);
+    EXPECT_FALSE(other.keep_latest);
+}
+
+TEST_F(TopicConfigTest, invalid_configurations_are_rejected) {
+    using ::rmw::iox2::TopicConfigError;
+
+    auto expect_error = [](const std::string& text, TopicConfigError expected) {
+        auto result = parse(text);
+        ASSERT_TRUE(result.has_error()) << text;
+        EXPECT_EQ(result.error(), expected) << text;
+        rcutils_reset_error();
+    };
+
+    expect_error("max_publishers = 1\n", TopicConfigError::INVALID_SYNTAX);
+    expect_error("[defaults\n", TopicConfigError::INVALID_SYNTAX);
+    expect_error("[defaults]\nmax_publishers\n", TopicConfigError::INVALID_SYNTAX);
+    expect_error("[services]\n", TopicConfigError::UNKNOWN_TABLE);
+    expect_error("[topics./points]\n", TopicConfigError::UNKNOWN_TABLE);
+    expect_error("[defaults]\nmax_nodes = 1\n", TopicConfigError::UNKNOWN_KEY);
+    expect_error("[defaults]\nmax_publishers = -1\n", TopicConfigError::INVALID_VALUE);
+    expect_error("[defaults]\nmax_publishers = many\n", TopicConfigError::INVALID_VALUE);
+    expect_error("[defaults]\nmax_publishers = 0\n", TopicConfigError::INVALID_VALUE);
+    expect_error("[topics.\"/imu\"]\npriority = 256\n", TopicConfigError::INVALID_VALUE);
+    expect_error("[topics.\"/tf\"]\nkeep_latest = 2\n", TopicConfigError::INVALID_VALUE);
+}
+
+TEST_F(TopicConfigTest, values_beyond_the_limits_are_rejected) {
+    using ::rmw::iox2::TopicConfigError;
+    using ::rmw::iox2::TopicSettings;
+
+    auto expect_error = [](const std::string& text) {
+        auto result = parse(text);
+        ASSERT_TRUE(result.has_error()) << text;
+        EXPECT_EQ(result.error(), TopicConfigError::INVALID_VALUE) << text;
+        rcutils_reset_error();
+    };
+    auto above = [](uint64_t limit) { return std::to_string(limit + 1); };
+
+    // Not representable, rather than saturating to the largest value
+    expect_error("[defaults]\nhistory_size = 18446744073709551616\n");
+    expect_error("[defaults]\nmax_publishers = " + above(TopicSettings::MAX_PORTS) + "\n");
+    expect_error("[defaults]\nmax_subscribers = " + above(TopicSettings::MAX_PORTS) + "\n");
+    expect_error("[defaults]\nhistory_size = " + above(TopicSettings::MAX_QUEUED_SAMPLES) + "\n");
+    expect_error("[defaults]\nsubscriber_max_buffer_size = " + above(TopicSettings::MAX_QUEUED_SAMPLES) + "\n");
+    expect_error("[defaults]\nsubscriber_max_borrowed_samples = " + above(TopicSettings::MAX_QUEUED_SAMPLES) + "\n");
+    expect_error("[defaults]\nmax_loaned_samples = " + above(TopicSettings::MAX_LOANED_SAMPLES) + "\n");
+
+    auto result = parse("[defaults]\nmax_loaned_samples = " + std::to_string(TopicSettings::MAX_LOANED_SAMPLES) + "\n");
+    ASSERT_FALSE(result.has_error());
+    EXPECT_EQ(result->settings("/any").max_loaned_samples, TopicSettings::MAX_LOANED_SAMPLES);
+}
+
+TEST_F(TopicConfigTest, missing_file_is_rejected) {
+    using ::rmw::iox2::TopicConfig;
+    using ::rmw::iox2::TopicConfigError;
+
+    auto sut = TopicConfig::from_file(::testing::TempDir() + "does_not_exist.toml");
+    ASSERT_TRUE(sut.has_error());
+    EXPECT_EQ(sut.error(), TopicConfigError::FILE_ACCESS_FAILURE);
+}
+
+TEST_F(TopicConfigTest, publishers_use_configured_settings) {
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::Node;
+    using ::rmw::iox2::Publisher;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+    namespace env = ::rmw::iox2::env;
+
+    const auto topic = create_test_topic();
+    const auto path = ::testing::TempDir() + "topic_config_" + std::to_string(test_id()) + ".toml";
+    {
+        std::ofstream file{path};
+        file << "[topics.\"" << topic << "\"]\nmax_loaned_samples = 3\n";
+    }
+    ASSERT_TRUE(rcutils_set_env(env::TOPIC_CONFIG, path.c_str()));
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context");
+    ASSERT_TRUE(rcutils_set_env(env::TOPIC_CONFIG, nullptr));
+    auto& context = context_storage.value();
+    EXPECT_EQ(context.topic_config().settings(topic).max_loaned_samples, 3U);
+
+    iox::optional<Node> node_storage;
+    create_in_place(node_storage, context, "Node", "TopicConfigTest").expect("failed to create node");
+
+    iox::optional<Publisher> publisher_storage;
+    ASSERT_FALSE(
+        create_in_place(publisher_storage,
+                        node_storage.value(),
+                        topic.c_str(),
+                        test_type_support<Defaults>(),
+                        rmw_qos_profile_default)
+            .has_error());
+    EXPECT_EQ(publisher_storage->loan_statistics().capacity, 3U);
+}
+
+} // namespace
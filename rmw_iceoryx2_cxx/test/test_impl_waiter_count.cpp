@@ -0,0 +1,200 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+#include <gtest/gtest.h>
+
+#include "iox/optional.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/create.hpp"
+#include "rmw_iceoryx2_cxx/impl/common/names.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/waiter_count.hpp"
+#include "testing/base.hpp"
+
+#include <cerrno>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace rmw::iox2::testing;
+
+class WaiterCountTest : public TestBase
+{
+protected:
+    void SetUp() override {
+    }
+
+    void TearDown() override {
+    }
+};
+
+TEST_F(WaiterCountTest, count_is_shared_by_instances_of_the_same_topic) {
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::WaiterCount;
+    namespace names = ::rmw::iox2::names;
+
+    const auto service_name = names::topic(create_test_topic().c_str());
+    iox::optional<WaiterCount> waitset_side;
+    ASSERT_FALSE(create_in_place(waitset_side, service_name).has_error());
+    iox::optional<WaiterCount> publisher_side;
+    ASSERT_FALSE(create_in_place(publisher_side, service_name).has_error());
+    iox::optional<WaiterCount> other_topic;
+    ASSERT_FALSE(create_in_place(other_topic, names::topic(create_test_topic("/other").c_str())).has_error());
+
+    EXPECT_FALSE(publisher_side->any_waiting());
+
+    waitset_side->arm();
+    waitset_side->arm();
+    EXPECT_TRUE(publisher_side->any_waiting());
+    EXPECT_FALSE(other_topic->any_waiting());
+
+    waitset_side->disarm();
+    EXPECT_TRUE(publisher_side->any_waiting());
+    waitset_side->disarm();
+    EXPECT_FALSE(publisher_side->any_waiting());
+}
+
+TEST_F(WaiterCountTest, shared_memory_names_are_valid_for_any_topic) {
+    using ::rmw::iox2::WaiterCount;
+    namespace names = ::rmw::iox2::names;
+
+    const auto long_topic = "/" + std::string(512, 'x') + "/nested/topic";
+    for (const auto& topic : {std::string{"/chatter"}, long_topic}) {
+        const auto name = WaiterCount::shared_memory_name(names::topic(topic.c_str()));
+        EXPECT_EQ(name.front(), '/');
+        EXPECT_EQ(name.find('/', 1), std::string::npos);
+        EXPECT_LT(name.size(), 255U);
+        EXPECT_EQ(name, WaiterCount::shared_memory_name(names::topic(topic.c_str())));
+    }
+    EXPECT_NE(WaiterCount::shared_memory_name(names::topic("/a")), WaiterCount::shared_memory_name(names::topic("/b")));
+}
+
+TEST_F(WaiterCountTest, waiters_of_terminated_processes_are_reclaimed) {
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::WaiterCount;
+    namespace names = ::rmw::iox2::names;
+
+    const auto service_name = names::topic(create_test_topic().c_str());
+    iox::optional<WaiterCount> publisher_side;
+    ASSERT_FALSE(create_in_place(publisher_side, service_name).has_error());
+
+    // The child terminates while armed, without destroying its count
+    const auto child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        iox::optional<WaiterCount> crashed_waitset;
+        if (create_in_place(crashed_waitset, service_name).has_error()) {
+            _exit(1);
+        }
+        crashed_waitset->arm();
+        _exit(0);
+    }
+    int status{0};
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_TRUE(publisher_side->any_waiting());
+
+    iox::optional<WaiterCount> restarted_waitset;
+    ASSERT_FALSE(create_in_place(restarted_waitset, service_name).has_error());
+    EXPECT_FALSE(publisher_side->any_waiting());
+
+    restarted_waitset->arm();
+    EXPECT_TRUE(publisher_side->any_waiting());
+    restarted_waitset->disarm();
+    EXPECT_FALSE(publisher_side->any_waiting());
+}
+
+TEST_F(WaiterCountTest, waiters_are_kept_while_their_instance_exists) {
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::WaiterCount;
+    namespace names = ::rmw::iox2::names;
+
+    const auto service_name = names::topic(create_test_topic().c_str());
+    iox::optional<WaiterCount> publisher_side;
+    ASSERT_FALSE(create_in_place(publisher_side, service_name).has_error());
+
+    // Created and armed by a thread that exits, the instance of the same process remains registered
+    iox::optional<WaiterCount> waitset_side;
+    std::thread{[&] {
+        ASSERT_FALSE(create_in_place(waitset_side, service_name).has_error());
+        waitset_side->arm();
+    }}.join();
+    ASSERT_TRUE(waitset_side.has_value());
+
+    iox::optional<WaiterCount> other_waitset;
+    ASSERT_FALSE(create_in_place(other_waitset, service_name).has_error());
+    other_waitset.reset();
+    EXPECT_TRUE(publisher_side->any_waiting());
+
+    waitset_side->disarm();
+    EXPECT_FALSE(publisher_side->any_waiting());
+}
+
+TEST_F(WaiterCountTest, unbalanced_disarming_does_not_wrap_around) {
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::WaiterCount;
+    namespace names = ::rmw::iox2::names;
+
+    const auto service_name = names::topic(create_test_topic().c_str());
+    iox::optional<WaiterCount> publisher_side;
+    ASSERT_FALSE(create_in_place(publisher_side, service_name).has_error());
+    iox::optional<WaiterCount> waitset_side;
+    ASSERT_FALSE(create_in_place(waitset_side, service_name).has_error());
+
+    waitset_side->disarm();
+    EXPECT_FALSE(publisher_side->any_waiting());
+
+    waitset_side->arm();
+    EXPECT_TRUE(publisher_side->any_waiting());
+    waitset_side->disarm();
+    waitset_side->disarm();
+    EXPECT_FALSE(publisher_side->any_waiting());
+}
+
+TEST_F(WaiterCountTest, shared_memory_is_private_and_removed_with_the_last_instance) {
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::WaiterCount;
+    namespace names = ::rmw::iox2::names;
+
+    const auto service_name = names::topic(create_test_topic().c_str());
+    const auto shared_memory_name = WaiterCount::shared_memory_name(service_name);
+    EXPECT_EQ(shared_memory_name.rfind("/iox2_", 0), 0U);
+
+    iox::optional<WaiterCount> first;
+    ASSERT_FALSE(create_in_place(first, service_name).has_error());
+    iox::optional<WaiterCount> second;
+    ASSERT_FALSE(create_in_place(second, service_name).has_error());
+
+    const auto fd = shm_open(shared_memory_name.c_str(), O_RDONLY, 0);
+    ASSERT_GE(fd, 0);
+    struct stat status{};
+    ASSERT_EQ(fstat(fd, &status), 0);
+    close(fd);
+    EXPECT_EQ(status.st_mode & 0777, 0600U);
+
+    first.reset();
+    const auto remaining = shm_open(shared_memory_name.c_str(), O_RDONLY, 0);
+    EXPECT_GE(remaining, 0);
+    if (remaining >= 0) {
+        close(remaining);
+    }
+
+    second.reset();
+    errno = 0;
+    EXPECT_LT(shm_open(shared_memory_name.c_str(), O_RDONLY, 0), 0);
+    EXPECT_EQ(errno, ENOENT);
+}
+
+} // namespace
@@ -10,10 +10,17 @@
 #include <gtest/gtest.h>
 
 #include "iox/optional.hpp"
+#include "iox/duration.hpp"
 #include "rmw_iceoryx2_cxx/impl/common/create.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/guard_condition.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/waitset.hpp"
 #include "testing/base.hpp"
 
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
 namespace
 {
 
@@ -42,4 +49,287 @@ TEST_F(WaitSetTest, construction) {
     ASSERT_FALSE(create_in_place(waitset_storage, context).has_error());
 }
 
+TEST_F(WaitSetTest, attachments_are_retained_while_mapped) {
+    using ::iox::units::Duration;
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::GuardCondition;
+    using ::rmw::iox2::WaitableEntity;
+    using ::rmw::iox2::WaitSet;
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context for waitset creation");
+    auto& context = context_storage.value();
+
+    iox::optional<GuardCondition> guard_condition_storage;
+    create_in_place(guard_condition_storage, context).expect("failed to create guard condition");
+    auto& guard_condition = guard_condition_storage.value();
+
+    iox::optional<WaitSet> waitset_storage;
+    create_in_place(waitset_storage, context).expect("failed to create waitset");
+    auto& waitset = waitset_storage.value();
+
+    // Waiting repeatedly on the same mapping re-uses the attachment from the first wait
+    for (size_t i = 0; i < 3; i++) {
+        ASSERT_FALSE(waitset.map(0, guard_condition).has_error());
+        ASSERT_FALSE(guard_condition.trigger().has_error());
+        auto result = waitset.wait(Duration::fromMilliseconds(100));
+        ASSERT_FALSE(result.has_error());
+        ASSERT_EQ(result.value(), 1U);
+        EXPECT_TRUE(waitset.is_triggered(WaitableEntity::GUARD_CONDITION, 0));
+        waitset.unmap_all();
+    }
+
+    // Without a trigger, the retained attachment does not report stale events
+    ASSERT_FALSE(waitset.map(0, guard_condition).has_error());
+    auto result = waitset.wait(Duration::fromMilliseconds(20));
+    ASSERT_FALSE(result.has_error());
+    EXPECT_EQ(result.value(), 0U);
+    waitset.unmap_all();
+}
+
+TEST_F(WaitSetTest, unmapped_entities_are_detached_on_next_wait) {
+    using ::iox::units::Duration;
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::GuardCondition;
+    using ::rmw::iox2::WaitableEntity;
+    using ::rmw::iox2::WaitSet;
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context for waitset creation");
+    auto& context = context_storage.value();
+
+    iox::optional<GuardCondition> first_storage;
+    create_in_place(first_storage, context).expect("failed to create guard condition");
+    auto& first = first_storage.value();
+
+    iox::optional<GuardCondition> second_storage;
+    create_in_place(second_storage, context).expect("failed to create guard condition");
+    auto& second = second_storage.value();
+
+    iox::optional<WaitSet> waitset_storage;
+    create_in_place(waitset_storage, context).expect("failed to create waitset");
+    auto& waitset = waitset_storage.value();
+
+    // Attach both guard conditions
+    ASSERT_FALSE(waitset.map(0, first).has_error());
+    ASSERT_FALSE(waitset.map(1, second).has_error());
+    ASSERT_FALSE(waitset.wait(Duration::fromMilliseconds(1)).has_error());
+    waitset.unmap_all();
+
+    // Only the first remains mapped, triggering the second must not wake the waitset
+    ASSERT_FALSE(waitset.map(0, first).has_error());
+    ASSERT_FALSE(second.trigger().has_error());
+    auto unmapped_result = waitset.wait(Duration::fromMilliseconds(20));
+    ASSERT_FALSE(unmapped_result.has_error());
+    EXPECT_EQ(unmapped_result.value(), 0U);
+    EXPECT_FALSE(waitset.is_triggered(WaitableEntity::GUARD_CONDITION, 1));
+    waitset.unmap_all();
+
+    // Mapping the second again re-attaches it, picking up the pending trigger
+    ASSERT_FALSE(waitset.map(1, second).has_error());
+    auto remapped_result = waitset.wait(Duration::fromMilliseconds(100));
+    ASSERT_FALSE(remapped_result.has_error());
+    ASSERT_EQ(remapped_result.value(), 1U);
+    EXPECT_FALSE(waitset.is_triggered(WaitableEntity::GUARD_CONDITION, 0));
+    EXPECT_TRUE(waitset.is_triggered(WaitableEntity::GUARD_CONDITION, 1));
+    waitset.unmap_all();
+}
+
+TEST_F(WaitSetTest, listeners_of_destroyed_entities_are_reclaimed) {
+    using ::iox::units::Duration;
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::GuardCondition;
+    using ::rmw::iox2::WaitableEntity;
+    using ::rmw::iox2::WaitSet;
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context for waitset creation");
+    auto& context = context_storage.value();
+
+    iox::optional<GuardCondition> kept_storage;
+    create_in_place(kept_storage, context).expect("failed to create guard condition");
+    auto& kept = kept_storage.value();
+
+    iox::optional<GuardCondition> destroyed_storage;
+    create_in_place(destroyed_storage, context).expect("failed to create guard condition");
+
+    iox::optional<WaitSet> waitset_storage;
+    create_in_place(waitset_storage, context).expect("failed to create waitset");
+    auto& waitset = waitset_storage.value();
+
+    ASSERT_FALSE(waitset.map(0, kept).has_error());
+    ASSERT_FALSE(waitset.map(1, destroyed_storage.value()).has_error());
+    ASSERT_FALSE(waitset.wait(Duration::fromMilliseconds(1)).has_error());
+    waitset.unmap_all();
+    EXPECT_EQ(waitset.listener_count(), 2U);
+
+    // Unmapped but alive entities keep their listener
+    ASSERT_FALSE(waitset.map(1, destroyed_storage.value()).has_error());
+    ASSERT_FALSE(waitset.wait(Duration::fromMilliseconds(1)).has_error());
+    waitset.unmap_all();
+    EXPECT_EQ(waitset.listener_count(), 2U);
+
+    // The listener of the destroyed entity is released in the next wait
+    destroyed_storage.reset();
+    ASSERT_FALSE(waitset.map(0, kept).has_error());
+    ASSERT_FALSE(waitset.wait(Duration::fromMilliseconds(1)).has_error());
+    waitset.unmap_all();
+    EXPECT_EQ(waitset.listener_count(), 1U);
+
+    // Reclaimed storage is re-used by new entities without affecting the remaining ones
+    iox::optional<GuardCondition> replacement_storage;
+    create_in_place(replacement_storage, context).expect("failed to create guard condition");
+    auto& replacement = replacement_storage.value();
+
+    ASSERT_FALSE(waitset.map(0, kept).has_error());
+    ASSERT_FALSE(waitset.map(1, replacement).has_error());
+    ASSERT_FALSE(replacement.trigger().has_error());
+    auto result = waitset.wait(Duration::fromMilliseconds(100));
+    ASSERT_FALSE(result.has_error());
+    ASSERT_EQ(result.value(), 1U);
+    EXPECT_FALSE(waitset.is_triggered(WaitableEntity::GUARD_CONDITION, 0));
+    EXPECT_TRUE(waitset.is_triggered(WaitableEntity::GUARD_CONDITION, 1));
+    waitset.unmap_all();
+    EXPECT_EQ(waitset.listener_count(), 2U);
+}
+
+TEST_F(WaitSetTest, hybrid_mode_reports_triggers_detected_while_spinning_once) {
+    using ::iox::units::Duration;
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::GuardCondition;
+    using ::rmw::iox2::WaitableEntity;
+    using ::rmw::iox2::WaitSet;
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context for waitset creation");
+    auto& context = context_storage.value();
+
+    iox::optional<GuardCondition> guard_condition_storage;
+    create_in_place(guard_condition_storage, context).expect("failed to create guard condition");
+    auto& guard_condition = guard_condition_storage.value();
+
+    iox::optional<WaitSet> waitset_storage;
+    create_in_place(waitset_storage, context).expect("failed to create waitset");
+    auto& waitset = waitset_storage.value();
+
+    waitset.set_spin_budget(Duration::fromMilliseconds(200));
+    EXPECT_EQ(waitset.spin_budget(), Duration::fromMilliseconds(200));
+
+    // Triggered while spinning
+    ASSERT_FALSE(waitset.map(0, guard_condition).has_error());
+    std::thread trigger([&guard_condition]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        ASSERT_FALSE(guard_condition.trigger().has_error());
+    });
+    auto result = waitset.wait(Duration::fromSeconds(1));
+    trigger.join();
+    ASSERT_FALSE(result.has_error());
+    ASSERT_EQ(result.value(), 1U);
+    EXPECT_TRUE(waitset.is_triggered(WaitableEntity::GUARD_CONDITION, 0));
+    waitset.unmap_all();
+
+    // The trigger is not reported again, neither while spinning nor by the subsequent blocking wait
+    ASSERT_FALSE(waitset.map(0, guard_condition).has_error());
+    auto repeated_result = waitset.wait(Duration::fromMilliseconds(20));
+    ASSERT_FALSE(repeated_result.has_error());
+    EXPECT_EQ(repeated_result.value(), 0U);
+    waitset.unmap_all();
+}
+
+TEST_F(WaitSetTest, triggers_are_reported_for_their_mapped_index) {
+    using ::iox::units::Duration;
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::GuardCondition;
+    using ::rmw::iox2::WaitableEntity;
+    using ::rmw::iox2::WaitSet;
+
+    constexpr size_t GUARD_CONDITION_COUNT{16};
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context for waitset creation");
+    auto& context = context_storage.value();
+
+    std::vector<iox::optional<GuardCondition>> guard_conditions(GUARD_CONDITION_COUNT);
+    for (auto& guard_condition : guard_conditions) {
+        create_in_place(guard_condition, context).expect("failed to create guard condition");
+    }
+
+    iox::optional<WaitSet> waitset_storage;
+    create_in_place(waitset_storage, context).expect("failed to create waitset");
+    auto& waitset = waitset_storage.value();
+
+    // Triggered while blocked, so that the trigger is mapped back from the waitset attachment
+    for (size_t triggered_index : {11U, 3U, 11U}) {
+        for (size_t i = 0; i < GUARD_CONDITION_COUNT; i++) {
+            ASSERT_FALSE(waitset.map(i, guard_conditions[i].value()).has_error());
+        }
+        std::thread trigger([&guard_conditions, triggered_index]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            ASSERT_FALSE(guard_conditions[triggered_index]->trigger().has_error());
+        });
+        auto result = waitset.wait(Duration::fromSeconds(1));
+        trigger.join();
+        ASSERT_FALSE(result.has_error());
+        ASSERT_EQ(result.value(), 1U);
+        for (size_t i = 0; i < GUARD_CONDITION_COUNT; i++) {
+            EXPECT_EQ(waitset.is_triggered(WaitableEntity::GUARD_CONDITION, i), i == triggered_index);
+        }
+        waitset.unmap_all();
+    }
+}
+
+// Measures the cost of mapping guard conditions to a waitset. Run explicitly with
+// --gtest_also_run_disabled_tests --gtest_filter=*benchmark_mapping_cost
+// Each guard condition and its listener hold file descriptors, the counts stay within the default limit per process.
+TEST_F(WaitSetTest, DISABLED_benchmark_mapping_cost) {
+    using ::rmw::iox2::Context;
+    using ::rmw::iox2::create_in_place;
+    using ::rmw::iox2::GuardCondition;
+    using ::rmw::iox2::WaitSet;
+
+    constexpr size_t ITERATIONS{100};
+    const std::vector<size_t> waitable_counts{10, 100, 250};
+
+    iox::optional<Context> context_storage;
+    create_in_place(context_storage, test_id()).expect("failed to create context for waitset creation");
+    auto& context = context_storage.value();
+
+    for (auto waitable_count : waitable_counts) {
+        std::vector<iox::optional<GuardCondition>> guard_conditions(waitable_count);
+        for (auto& guard_condition : guard_conditions) {
+            create_in_place(guard_condition, context).expect("failed to create guard condition");
+        }
+
+        iox::optional<WaitSet> waitset_storage;
+        create_in_place(waitset_storage, context).expect("failed to create waitset");
+        auto& waitset = waitset_storage.value();
+
+        // The first mapping creates the listeners
+        for (size_t i = 0; i < waitable_count; i++) {
+            ASSERT_FALSE(waitset.map(i, guard_conditions[i].value()).has_error());
+        }
+        waitset.unmap_all();
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t iteration = 0; iteration < ITERATIONS; iteration++) {
+            for (size_t i = 0; i < waitable_count; i++) {
+                ASSERT_FALSE(waitset.map(i, guard_conditions[i].value()).has_error());
+            }
+            waitset.unmap_all();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        auto per_waitable = static_cast<double>(elapsed) / static_cast<double>(ITERATIONS * waitable_count);
+        std::cout << "[ BENCHMARK] mapping " << waitable_count << " guard conditions: " << per_waitable
+                  << " ns per waitable" << std::endl;
+        RecordProperty("map_ns_per_waitable_" + std::to_string(waitable_count), std::to_string(per_waitable));
+    }
+}
+
 } // namespace
@@ -9,12 +9,30 @@
 
 #include <gtest/gtest.h>
 
+#include "rcutils/allocator.h"
+#include "rcutils/time.h"
+#include "rmw/features.h"
+#include "rmw/message_sequence.h"
 #include "rmw/rmw.h"
+#include "rmw_iceoryx2_cxx/impl/common/topic_config.hpp"
+#include "rmw_iceoryx2_cxx/rmw/loan_statistics.hpp"
+#include "rmw_iceoryx2_cxx/rmw/loaned_message_batch.hpp"
+#include "rmw_iceoryx2_cxx/rmw/publish_batch.hpp"
 #include "rmw_iceoryx2_cxx_test_msgs/msg/defaults.hpp"
 #include "rmw_iceoryx2_cxx_test_msgs/msg/strings.hpp"
 #include "testing/assertions.hpp"
 #include "testing/base.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace
 {
 using namespace rmw::iox2::testing;
@@ -106,6 +124,352 @@ TEST_F(RmwPublishSubscribeTest, take_non_self_contained_one_new_message) {
     free(recv_payload);
 }
 
+TEST_F(RmwPublishSubscribeTest, take_non_self_contained_messages_of_varying_size) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Strings;
+
+    auto* publisher = create_default_publisher<Strings>(create_test_topic());
+    ASSERT_NE(publisher, nullptr);
+    auto* subscription = create_default_subscriber<Strings>(create_test_topic());
+    ASSERT_NE(subscription, nullptr);
+
+    // Messages larger than any published before do not fit the speculative loan and are serialized again
+    std::vector<Strings> send_payloads(4);
+    send_payloads[0].string_value = "Glory";
+    send_payloads[1].string_value = std::string(256, 'x');
+    send_payloads[2].string_value = std::string(4096, 'y');
+    send_payloads[3].string_value = "ToHypnoToad";
+    for (const auto& send_payload : send_payloads) {
+        ASSERT_RMW_OK(rmw_publish(publisher, &send_payload, nullptr));
+    }
+
+    for (const auto& send_payload : send_payloads) {
+        Strings recv_payload{};
+        bool taken{false};
+        ASSERT_RMW_OK(rmw_take(subscription, &recv_payload, &taken, nullptr));
+        ASSERT_TRUE(taken);
+        ASSERT_EQ(recv_payload, send_payload);
+    }
+}
+
+// ----- Message Info API ----- //
+
+TEST_F(RmwPublishSubscribeTest, take_with_info_self_contained) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    auto* publisher = create_default_publisher<Defaults>(create_test_topic());
+    ASSERT_NE(publisher, nullptr);
+    auto* subscription = create_default_subscriber<Defaults>(create_test_topic());
+    ASSERT_NE(subscription, nullptr);
+
+    rmw_gid_t publisher_gid{};
+    ASSERT_RMW_OK(rmw_get_gid_for_publisher(publisher, &publisher_gid));
+
+    auto send_payload = Defaults{};
+    ASSERT_RMW_OK(rmw_publish(publisher, &send_payload, nullptr));
+    ASSERT_RMW_OK(rmw_publish(publisher, &send_payload, nullptr));
+
+    for (uint64_t sequence_number = 1; sequence_number <= 2; sequence_number++) {
+        Defaults recv_payload{};
+        rmw_message_info_t info = rmw_get_zero_initialized_message_info();
+        bool taken{false};
+        ASSERT_RMW_OK(rmw_take_with_info(subscription, &recv_payload, &taken, &info, nullptr));
+        ASSERT_TRUE(taken);
+        EXPECT_EQ(recv_payload, send_payload);
+
+        EXPECT_EQ(info.publication_sequence_number, sequence_number);
+        EXPECT_GT(info.source_timestamp, 0);
+        EXPECT_GE(info.received_timestamp, info.source_timestamp);
+        bool equal{false};
+        ASSERT_RMW_OK(rmw_compare_gids_equal(&info.publisher_gid, &publisher_gid, &equal));
+        EXPECT_TRUE(equal);
+    }
+}
+
+TEST_F(RmwPublishSubscribeTest, take_with_info_non_self_contained) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Strings;
+
+    auto* publisher = create_default_publisher<Strings>(create_test_topic());
+    ASSERT_NE(publisher, nullptr);
+    auto* subscription = create_default_subscriber<Strings>(create_test_topic());
+    ASSERT_NE(subscription, nullptr);
+
+    rmw_gid_t publisher_gid{};
+    ASSERT_RMW_OK(rmw_get_gid_for_publisher(publisher, &publisher_gid));
+
+    auto send_payload = Strings{};
+    send_payload.string_value = "GloryToHypnoToad";
+    ASSERT_RMW_OK(rmw_publish(publisher, &send_payload, nullptr));
+
+    Strings recv_payload{};
+    rmw_message_info_t info = rmw_get_zero_initialized_message_info();
+    bool taken{false};
+    ASSERT_RMW_OK(rmw_take_with_info(subscription, &recv_payload, &taken, &info, nullptr));
+    ASSERT_TRUE(taken);
+    EXPECT_EQ(recv_payload, send_payload);
+
+    EXPECT_EQ(info.publication_sequence_number, 1U);
+    EXPECT_GT(info.source_timestamp, 0);
+    EXPECT_GE(info.received_timestamp, info.source_timestamp);
+    bool equal{false};
+    ASSERT_RMW_OK(rmw_compare_gids_equal(&info.publisher_gid, &publisher_gid, &equal));
+    EXPECT_TRUE(equal);
+}
+
+TEST_F(RmwPublishSubscribeTest, take_loaned_message_with_info) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    auto* publisher = create_default_publisher<Defaults>(create_test_topic());
+    ASSERT_NE(publisher, nullptr);
+    auto* subscription = create_default_subscriber<Defaults>(create_test_topic());
+    ASSERT_NE(subscription, nullptr);
+
+    void* publisher_loan = nullptr;
+    ASSERT_RMW_OK(rmw_borrow_loaned_message(publisher, test_type_support<Defaults>(), &publisher_loan));
+    new (publisher_loan) Defaults{};
+    ASSERT_RMW_OK(rmw_publish_loaned_message(publisher, publisher_loan, nullptr));
+
+    void* subscriber_loan = nullptr;
+    rmw_message_info_t info = rmw_get_zero_initialized_message_info();
+    bool taken{false};
+    ASSERT_RMW_OK(rmw_take_loaned_message_with_info(subscription, &subscriber_loan, &taken, &info, nullptr));
+    ASSERT_TRUE(taken);
+    ASSERT_NE(subscriber_loan, nullptr);
+
+    EXPECT_EQ(info.publication_sequence_number, 1U);
+    EXPECT_GT(info.source_timestamp, 0);
+    EXPECT_GE(info.received_timestamp, info.source_timestamp);
+
+    ASSERT_RMW_OK(rmw_return_loaned_message_from_subscription(subscription, subscriber_loan));
+}
+
+TEST_F(RmwPublishSubscribeTest, publication_sequence_numbers_are_supported) {
+    EXPECT_TRUE(rmw_feature_supported(RMW_FEATURE_MESSAGE_INFO_PUBLICATION_SEQUENCE_NUMBER));
+    EXPECT_FALSE(rmw_feature_supported(RMW_FEATURE_MESSAGE_INFO_RECEPTION_SEQUENCE_NUMBER));
+}
+
+// ----- Batch API ----- //
+
+TEST_F(RmwPublishSubscribeTest, take_self_contained_published_batch) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    auto* publisher = create_default_publisher<Defaults>(create_test_topic());
+    ASSERT_NE(publisher, nullptr);
+    auto* subscription = create_default_subscriber<Defaults>(create_test_topic());
+    ASSERT_NE(subscription, nullptr);
+
+    std::vector<Defaults> send_payloads(3);
+    for (size_t i = 0; i < send_payloads.size(); i++) {
+        send_payloads[i].int64_value = static_cast<int64_t>(i);
+    }
+    std::vector<const void*> batch{&send_payloads[0], &send_payloads[1], &send_payloads[2]};
+    ASSERT_RMW_OK(rmw_iox2_publish_batch(publisher, batch.data(), batch.size()));
+
+    for (const auto& send_payload : send_payloads) {
+        Defaults recv_payload{};
+        bool taken{false};
+        ASSERT_RMW_OK(rmw_take(subscription, &recv_payload, &taken, nullptr));
+        ASSERT_TRUE(taken);
+        ASSERT_EQ(recv_payload, send_payload);
+    }
+}
+
+TEST_F(RmwPublishSubscribeTest, take_non_self_contained_published_batch) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Strings;
+
+    auto* publisher = create_default_publisher<Strings>(create_test_topic());
+    ASSERT_NE(publisher, nullptr);
+    auto* subscription = create_default_subscriber<Strings>(create_test_topic());
+    ASSERT_NE(subscription, nullptr);
+
+    std::vector<Strings> send_payloads(3);
+    send_payloads[0].string_value = "Glory";
+    send_payloads[1].string_value = std::string(1024, 'x');
+    send_payloads[2].string_value = "ToHypnoToad";
+    std::vector<const void*> batch{&send_payloads[0], &send_payloads[1], &send_payloads[2]};
+    ASSERT_RMW_OK(rmw_iox2_publish_batch(publisher, batch.data(), batch.size()));
+
+    for (const auto& send_payload : send_payloads) {
+        Strings recv_payload{};
+        bool taken{false};
+        ASSERT_RMW_OK(rmw_take(subscription, &recv_payload, &taken, nullptr));
+        ASSERT_TRUE(taken);
+        ASSERT_EQ(recv_payload, send_payload);
+    }
+}
+
+TEST_F(RmwPublishSubscribeTest, publish_batch_rejects_null_messages) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    auto* publisher = create_default_publisher<Defaults>(create_test_topic());
+    ASSERT_NE(publisher, nullptr);
+
+    auto send_payload = Defaults{};
+    std::vector<const void*> batch{&send_payload, nullptr};
+    ASSERT_RMW_ERR(RMW_RET_INVALID_ARGUMENT, rmw_iox2_publish_batch(publisher, batch.data(), batch.size()));
+}
+
+// ----- Sequence API ----- //
+
+TEST_F(RmwPublishSubscribeTest, take_sequence_self_contained) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    auto* publisher = create_default_publisher<Defaults>(create_test_topic());
+    ASSERT_NE(publisher, nullptr);
+    auto* subscription = create_default_subscriber<Defaults>(create_test_topic());
+    ASSERT_NE(subscription, nullptr);
+
+    std::vector<Defaults> send_payloads(3);
+    for (size_t i = 0; i < send_payloads.size(); i++) {
+        send_payloads[i].int64_value = static_cast<int64_t>(i);
+        ASSERT_RMW_OK(rmw_publish(publisher, &send_payloads[i], nullptr));
+    }
+
+    // Fewer messages are available than requested
+    constexpr size_t COUNT{5};
+    std::vector<Defaults> recv_payloads(COUNT);
+    std::vector<void*> recv_pointers;
+    for (auto& recv_payload : recv_payloads) {
+        recv_pointers.push_back(&recv_payload);
+    }
+    std::vector<rmw_message_info_t> infos(COUNT);
+    rmw_message_sequence_t messages{recv_pointers.data(), 0, COUNT, nullptr};
+    rmw_message_info_sequence_t message_infos{infos.data(), 0, COUNT, nullptr};
+
+    size_t taken{0};
+    ASSERT_RMW_OK(rmw_take_sequence(subscription, COUNT, &messages, &message_infos, &taken, nullptr));
+    ASSERT_EQ(taken, send_payloads.size());
+    EXPECT_EQ(messages.size, taken);
+    EXPECT_EQ(message_infos.size, taken);
+    for (size_t i = 0; i < taken; i++) {
+        EXPECT_EQ(recv_payloads[i], send_payloads[i]);
+        EXPECT_GT(infos[i].received_timestamp, 0);
+        EXPECT_GE(infos[i].received_timestamp, infos[i].source_timestamp);
+        EXPECT_EQ(infos[i].publication_sequence_number, i + 1);
+    }
+
+    ASSERT_RMW_OK(rmw_take_sequence(subscription, COUNT, &messages, &message_infos, &taken, nullptr));
+    EXPECT_EQ(taken, 0U);
+    EXPECT_EQ(messages.size, 0U);
+}
+
+TEST_F(RmwPublishSubscribeTest, take_sequence_non_self_contained) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Strings;
+
+    auto* publisher = create_default_publisher<Strings>(create_test_topic());
+    ASSERT_NE(publisher, nullptr);
+    auto* subscription = create_default_subscriber<Strings>(create_test_topic());
+    ASSERT_NE(subscription, nullptr);
+
+    std::vector<Strings> send_payloads(4);
+    send_payloads[0].string_value = "Glory";
+    send_payloads[1].string_value = std::string(1024, 'x');
+    send_payloads[2].string_value = "To";
+    send_payloads[3].string_value = "HypnoToad";
+    for (const auto& send_payload : send_payloads) {
+        ASSERT_RMW_OK(rmw_publish(publisher, &send_payload, nullptr));
+    }
+
+    // More messages are available than requested, the remainder is taken by the next call
+    constexpr size_t COUNT{3};
+    std::vector<Strings> recv_payloads(COUNT);
+    std::vector<void*> recv_pointers;
+    for (auto& recv_payload : recv_payloads) {
+        recv_pointers.push_back(&recv_payload);
+    }
+    std::vector<rmw_message_info_t> infos(COUNT);
+    rmw_message_sequence_t messages{recv_pointers.data(), 0, COUNT, nullptr};
+    rmw_message_info_sequence_t message_infos{infos.data(), 0, COUNT, nullptr};
+
+    size_t taken{0};
+    ASSERT_RMW_OK(rmw_take_sequence(subscription, COUNT, &messages, &message_infos, &taken, nullptr));
+    ASSERT_EQ(taken, COUNT);
+    for (size_t i = 0; i < taken; i++) {
+        EXPECT_EQ(recv_payloads[i], send_payloads[i]);
+    }
+
+    ASSERT_RMW_OK(rmw_take_sequence(subscription, COUNT, &messages, &message_infos, &taken, nullptr));
+    ASSERT_EQ(taken, 1U);
+    EXPECT_EQ(recv_payloads[0], send_payloads[3]);
+}
+
+TEST_F(RmwPublishSubscribeTest, take_sequence_rejects_insufficient_capacity) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    auto* subscription = create_default_subscriber<Defaults>(create_test_topic());
+    ASSERT_NE(subscription, nullptr);
+
+    auto allocator = rcutils_get_default_allocator();
+    rmw_message_sequence_t messages = rmw_get_zero_initialized_message_sequence();
+    ASSERT_RMW_OK(rmw_message_sequence_init(&messages, 2, &allocator));
+    rmw_message_info_sequence_t message_infos = rmw_get_zero_initialized_message_info_sequence();
+    ASSERT_RMW_OK(rmw_message_info_sequence_init(&message_infos, 2, &allocator));
+
+    size_t taken{0};
+    EXPECT_EQ(rmw_take_sequence(subscription, 3, &messages, &message_infos, &taken, nullptr), RMW_RET_INVALID_ARGUMENT);
+
+    ASSERT_RMW_OK(rmw_message_sequence_fini(&messages));
+    ASSERT_RMW_OK(rmw_message_info_sequence_fini(&message_infos));
+}
+
+// Measures the throughput of taking messages in sequences against taking them one by one. Run explicitly with
+// --gtest_also_run_disabled_tests --gtest_filter=*take_sequence_throughput
+TEST_F(RmwPublishSubscribeTest, DISABLED_take_sequence_throughput) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+    using Clock = std::chrono::steady_clock;
+
+    auto* publisher = create_default_publisher<Defaults>(create_test_topic());
+    ASSERT_NE(publisher, nullptr);
+    auto* subscription = create_default_subscriber<Defaults>(create_test_topic());
+    ASSERT_NE(subscription, nullptr);
+
+    // Batches fit the queue of the subscription with the default QoS
+    constexpr size_t BATCH{10};
+    constexpr size_t ITERATIONS{10000};
+    Defaults send_payload{};
+    std::vector<Defaults> recv_payloads(BATCH);
+    std::vector<void*> recv_pointers;
+    for (auto& recv_payload : recv_payloads) {
+        recv_pointers.push_back(&recv_payload);
+    }
+    std::vector<rmw_message_info_t> infos(BATCH);
+    rmw_message_sequence_t messages{recv_pointers.data(), 0, BATCH, nullptr};
+    rmw_message_info_sequence_t message_infos{infos.data(), 0, BATCH, nullptr};
+
+    auto publish_batch = [&] {
+        for (size_t i = 0; i < BATCH; i++) {
+            ASSERT_RMW_OK(rmw_publish(publisher, &send_payload, nullptr));
+        }
+    };
+
+    Clock::duration looped{0};
+    for (size_t iteration = 0; iteration < ITERATIONS; iteration++) {
+        publish_batch();
+        auto start = Clock::now();
+        for (size_t i = 0; i < BATCH; i++) {
+            bool taken{false};
+            ASSERT_RMW_OK(rmw_take(subscription, recv_pointers[i], &taken, nullptr));
+            ASSERT_TRUE(taken);
+        }
+        looped += Clock::now() - start;
+    }
+
+    Clock::duration sequenced{0};
+    for (size_t iteration = 0; iteration < ITERATIONS; iteration++) {
+        publish_batch();
+        auto start = Clock::now();
+        size_t taken{0};
+        ASSERT_RMW_OK(rmw_take_sequence(subscription, BATCH, &messages, &message_infos, &taken, nullptr));
+        sequenced += Clock::now() - start;
+        ASSERT_EQ(taken, BATCH);
+    }
+
+    auto per_message = [](Clock::duration total) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(total).count() / (ITERATIONS * BATCH);
+    };
+    std::cout << "rmw_take:          " << per_message(looped) << " ns per message" << std::endl;
+    std::cout << "rmw_take_sequence: " << per_message(sequenced) << " ns per message" << std::endl;
+}
+
 // ----- Loan API ----- //
 
 TEST_F(RmwPublishSubscribeTest, take_loan_self_contained_no_new_messages) {
@@ -166,6 +530,61 @@ TEST_F(RmwPublishSubscribeTest, take_loan_self_contained_one_new_message) {
     ASSERT_RMW_OK(rmw_return_loaned_message_from_subscription(subscription, subscriber_loan));
 }
 
+TEST_F(RmwPublishSubscribeTest, take_loans_self_contained_in_bulk) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    auto* publisher = create_default_publisher<Defaults>(create_test_topic());
+    ASSERT_NE(publisher, nullptr);
+    auto* subscription = create_default_subscriber<Defaults>(create_test_topic());
+    ASSERT_NE(subscription, nullptr);
+
+    std::vector<Defaults> send_payloads(5);
+    for (size_t i = 0; i < send_payloads.size(); i++) {
+        send_payloads[i].int64_value = static_cast<int64_t>(i);
+        ASSERT_RMW_OK(rmw_publish(publisher, &send_payloads[i], nullptr));
+    }
+
+    // By default, a full buffer of the subscription can be loaned at once
+    rmw_iox2_loan_statistics_t statistics{};
+    ASSERT_RMW_OK(rmw_iox2_subscription_get_loan_statistics(subscription, &statistics));
+    EXPECT_GE(statistics.capacity, ::rmw::iox2::TopicSettings{}.subscriber_max_buffer_size);
+
+    std::vector<void*> loans(8, nullptr);
+    size_t taken{0};
+    ASSERT_RMW_OK(rmw_iox2_take_loaned_messages(subscription, loans.size(), loans.data(), &taken));
+    ASSERT_EQ(taken, send_payloads.size());
+    for (size_t i = 0; i < taken; i++) {
+        ASSERT_NE(loans[i], nullptr);
+        EXPECT_EQ(*static_cast<Defaults*>(loans[i]), send_payloads[i]);
+    }
+    ASSERT_RMW_OK(rmw_iox2_subscription_get_loan_statistics(subscription, &statistics));
+    EXPECT_EQ(statistics.outstanding, taken);
+
+    ASSERT_RMW_OK(rmw_iox2_return_loaned_messages_from_subscription(subscription, loans.data(), taken));
+    ASSERT_RMW_OK(rmw_iox2_subscription_get_loan_statistics(subscription, &statistics));
+    EXPECT_EQ(statistics.outstanding, 0U);
+
+    // Returning the same loans again fails
+    ASSERT_RMW_ERR(RMW_RET_ERROR, rmw_iox2_return_loaned_messages_from_subscription(subscription, loans.data(), taken));
+
+    // No messages remain for the next call
+    size_t remaining{0};
+    ASSERT_RMW_OK(rmw_iox2_take_loaned_messages(subscription, loans.size(), loans.data(), &remaining));
+    EXPECT_EQ(remaining, 0U);
+}
+
+TEST_F(RmwPublishSubscribeTest, take_loans_non_self_contained_unsupported) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Strings;
+
+    auto* subscription = create_default_subscriber<Strings>(create_test_topic());
+    ASSERT_NE(subscription, nullptr);
+
+    std::vector<void*> loans(2, nullptr);
+    size_t taken{0};
+    ASSERT_RMW_ERR(RMW_RET_UNSUPPORTED,
+                   rmw_iox2_take_loaned_messages(subscription, loans.size(), loans.data(), &taken));
+}
+
 // ----- Serialized Message API ----- //
 
 TEST_F(RmwPublishSubscribeTest, take_serialized_no_new_messages) {
@@ -258,4 +677,199 @@ TEST_F(RmwPublishSubscribeTest, take_serialized_many_new_messages) {
     }
 }
 
+TEST_F(RmwPublishSubscribeTest, take_serialized_smaller_message_after_larger_message) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Strings;
+
+    auto* publisher = create_default_publisher<Strings>(create_test_topic());
+    ASSERT_NE(publisher, nullptr);
+    auto* subscription = create_default_subscriber<Strings>(create_test_topic());
+    ASSERT_NE(subscription, nullptr);
+
+    // The smaller message is serialized into a loan sized for the larger one
+    std::vector<Strings> send_payloads(2);
+    send_payloads[0].string_value = std::string(4096, 'x');
+    send_payloads[1].string_value = "GloryToHypnoToad";
+    for (const auto& send_payload : send_payloads) {
+        ASSERT_RMW_OK(rmw_publish(publisher, &send_payload, nullptr));
+    }
+
+    // Only the serialized bytes are taken, the same as serializing the message directly
+    for (const auto& send_payload : send_payloads) {
+        rmw_serialized_message_t expected{};
+        ASSERT_RMW_OK(rmw_serialized_message_init(&expected, 8192, &test_allocator()));
+        ASSERT_RMW_OK(rmw_serialize(&send_payload, test_type_support<Strings>(), &expected));
+
+        rmw_serialized_message_t taken_message{};
+        ASSERT_RMW_OK(rmw_serialized_message_init(&taken_message, 0, &test_allocator()));
+        bool taken{false};
+        ASSERT_RMW_OK(rmw_take_serialized_message(subscription, &taken_message, &taken, nullptr));
+        ASSERT_TRUE(taken);
+
+        ASSERT_EQ(taken_message.buffer_length, expected.buffer_length);
+        EXPECT_TRUE(std::equal(expected.buffer, expected.buffer + expected.buffer_length, taken_message.buffer));
+
+        ASSERT_RMW_OK(rmw_serialized_message_fini(&expected));
+        ASSERT_RMW_OK(rmw_serialized_message_fini(&taken_message));
+    }
+}
+
+// ----- Event Callback API ----- //
+
+TEST_F(RmwPublishSubscribeTest, new_message_callback_is_invoked) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    std::atomic<size_t> events{0};
+    auto callback = [](const void* user_data, size_t number_of_events) {
+        *static_cast<std::atomic<size_t>*>(const_cast<void*>(user_data)) += number_of_events;
+    };
+
+    auto* publisher = create_default_publisher<Defaults>(create_test_topic());
+    ASSERT_NE(publisher, nullptr);
+    auto* subscription = create_default_subscriber<Defaults>(create_test_topic());
+    ASSERT_NE(subscription, nullptr);
+
+    ASSERT_RMW_ERR(RMW_RET_INVALID_ARGUMENT, rmw_subscription_set_on_new_message_callback(nullptr, callback, &events));
+    ASSERT_RMW_OK(rmw_subscription_set_on_new_message_callback(subscription, callback, &events));
+
+    Defaults send_payload{};
+    ASSERT_RMW_OK(rmw_publish(publisher, &send_payload, nullptr));
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (events == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GT(events.load(), 0U);
+
+    Defaults recv_payload{};
+    bool taken{false};
+    ASSERT_RMW_OK(rmw_take(subscription, &recv_payload, &taken, nullptr));
+    EXPECT_TRUE(taken);
+
+    // Removed before the counter goes out of scope
+    ASSERT_RMW_OK(rmw_subscription_set_on_new_message_callback(subscription, nullptr, nullptr));
+}
+
+// Compares receiving as the SingleThreadedExecutor does, blocking in rmw_wait, against receiving as the EventsExecutor
+// does, blocking on a queue filled by new-message callbacks. Messages are published periodically, so that the
+// receiver blocks between messages.
+TEST_F(RmwPublishSubscribeTest, DISABLED_new_message_callback_latency_and_cpu_time) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    auto* publisher = create_default_publisher<Defaults>(create_test_topic());
+    ASSERT_NE(publisher, nullptr);
+    auto* subscription = create_default_subscriber<Defaults>(create_test_topic());
+    ASSERT_NE(subscription, nullptr);
+
+    constexpr size_t MESSAGES{5000};
+    constexpr auto PERIOD = std::chrono::microseconds(200);
+
+    struct Statistics
+    {
+        size_t received{0};
+        size_t empty_takes{0};
+        int64_t latency_ns{0};
+    };
+
+    auto cpu_time_ns = [] {
+        timespec time{};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+        return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+    };
+
+    // Takes one message, recording its latency from the source timestamp
+    auto take = [subscription](Statistics& statistics) {
+        Defaults recv_payload{};
+        rmw_message_info_t info{};
+        bool taken{false};
+        if (rmw_take_with_info(subscription, &recv_payload, &taken, &info, nullptr) != RMW_RET_OK || !taken) {
+            statistics.empty_takes++;
+            return;
+        }
+        rcutils_time_point_value_t now{0};
+        rcutils_system_time_now(&now);
+        statistics.latency_ns += now - info.source_timestamp;
+        statistics.received++;
+    };
+
+    // Publishes while the receiver runs in a separate thread, returning the process CPU time consumed
+    auto measure = [&](auto&& receive) {
+        auto cpu_start = cpu_time_ns();
+        std::thread receiver{receive};
+        Defaults send_payload{};
+        auto next = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < MESSAGES; i++) {
+            next += PERIOD;
+            std::this_thread::sleep_until(next);
+            EXPECT_RMW_OK(rmw_publish(publisher, &send_payload, nullptr));
+        }
+        receiver.join();
+        return cpu_time_ns() - cpu_start;
+    };
+
+    // Waits stop once all messages are received or no message is received for a second
+    Statistics waited;
+    auto waited_cpu_ns = measure([&] {
+        auto* waitset = rmw_create_wait_set(test_context(), 1);
+        rmw_time_t timeout{1, 0};
+        while (waited.received < MESSAGES) {
+            void* subscribers[1]{subscription->data};
+            rmw_subscriptions_t subscriptions{};
+            subscriptions.subscriber_count = 1;
+            subscriptions.subscribers = subscribers;
+            if (rmw_wait(&subscriptions, nullptr, nullptr, nullptr, nullptr, waitset, &timeout) == RMW_RET_TIMEOUT) {
+                break;
+            }
+            if (subscribers[0] != nullptr) {
+                take(waited);
+            }
+        }
+        rmw_destroy_wait_set(waitset);
+    });
+
+    struct EventQueue
+    {
+        std::mutex mutex;
+        std::condition_variable condition;
+        size_t events{0};
+    } queue;
+    auto enqueue = [](const void* user_data, size_t number_of_events) {
+        auto* event_queue = static_cast<EventQueue*>(const_cast<void*>(user_data));
+        {
+            std::lock_guard<std::mutex> lock{event_queue->mutex};
+            event_queue->events += number_of_events;
+        }
+        event_queue->condition.notify_one();
+    };
+    ASSERT_RMW_OK(rmw_subscription_set_on_new_message_callback(subscription, enqueue, &queue));
+
+    Statistics dispatched;
+    auto dispatched_cpu_ns = measure([&] {
+        while (dispatched.received < MESSAGES) {
+            size_t events{0};
+            {
+                std::unique_lock<std::mutex> lock{queue.mutex};
+                if (!queue.condition.wait_for(lock, std::chrono::seconds(1), [&queue] { return queue.events > 0; })) {
+                    break;
+                }
+                std::swap(events, queue.events);
+            }
+            // One take per event, as executed by the EventsExecutor
+            for (size_t i = 0; i < events; i++) {
+                take(dispatched);
+            }
+        }
+    });
+    ASSERT_RMW_OK(rmw_subscription_set_on_new_message_callback(subscription, nullptr, nullptr));
+
+    auto report = [](const char* label, const Statistics& statistics, int64_t cpu_ns) {
+        auto received = std::max<size_t>(1, statistics.received);
+        std::cout << label << statistics.received << " received, " << statistics.latency_ns / received
+                  << " ns average latency, " << cpu_ns / static_cast<int64_t>(received) << " ns CPU time per message, "
+                  << statistics.empty_takes << " empty takes" << std::endl;
+    };
+    report("rmw_wait:             ", waited, waited_cpu_ns);
+    report("new-message callback: ", dispatched, dispatched_cpu_ns);
+    EXPECT_EQ(waited.received, MESSAGES);
+    EXPECT_EQ(dispatched.received, MESSAGES);
+}
+
 } // namespace
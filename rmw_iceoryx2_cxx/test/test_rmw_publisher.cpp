@@ -10,6 +10,7 @@
 #include <gtest/gtest.h>
 
 #include "rmw/rmw.h"
+#include "rmw_iceoryx2_cxx/rmw/loan_statistics.hpp"
 #include "rmw_iceoryx2_cxx_test_msgs/msg/defaults.hpp"
 
 #include "testing/assertions.hpp"
@@ -54,4 +55,34 @@ TEST_F(RmwPublisherTest, borrow_and_return) {
     EXPECT_RMW_OK(rmw_return_loaned_message_from_publisher(publisher, loaned_message));
 }
 
+TEST_F(RmwPublisherTest, loan_statistics_track_outstanding_loans) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    auto* publisher = create_default_publisher<Defaults>(create_test_topic());
+    rmw_iox2_loan_statistics_t statistics{};
+
+    EXPECT_RMW_OK(rmw_iox2_publisher_get_loan_statistics(publisher, &statistics));
+    EXPECT_GT(statistics.capacity, 1U);
+    EXPECT_EQ(statistics.outstanding, 0U);
+    EXPECT_EQ(statistics.high_water_mark, 0U);
+    EXPECT_EQ(statistics.oldest_loan_age_ns, 0);
+
+    void* first = nullptr;
+    void* second = nullptr;
+    EXPECT_RMW_OK(rmw_borrow_loaned_message(publisher, test_type_support<Defaults>(), &first));
+    EXPECT_RMW_OK(rmw_borrow_loaned_message(publisher, test_type_support<Defaults>(), &second));
+    EXPECT_RMW_OK(rmw_return_loaned_message_from_publisher(publisher, first));
+
+    EXPECT_RMW_OK(rmw_iox2_publisher_get_loan_statistics(publisher, &statistics));
+    EXPECT_EQ(statistics.outstanding, 1U);
+    EXPECT_EQ(statistics.high_water_mark, 2U);
+    EXPECT_GT(statistics.oldest_loan_age_ns, 0);
+
+    EXPECT_RMW_OK(rmw_return_loaned_message_from_publisher(publisher, second));
+    EXPECT_RMW_OK(rmw_iox2_publisher_get_loan_statistics(publisher, &statistics));
+    EXPECT_EQ(statistics.outstanding, 0U);
+    EXPECT_EQ(statistics.high_water_mark, 2U);
+    EXPECT_EQ(statistics.oldest_loan_age_ns, 0);
+}
+
 } // namespace
@@ -44,4 +44,42 @@ TEST_F(RmwSubscriptionTest, create_and_destroy) {
     RMW_ASSERT_TRUE(subscription->can_loan_messages);
 }
 
+TEST_F(RmwSubscriptionTest, actual_qos_reflects_service_settings) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    auto options = rmw_get_default_subscription_options();
+    auto create = [&](const rmw_qos_profile_t& requested, const std::string& name) {
+        return rmw_create_subscription(
+            test_node(), test_type_support<Defaults>(), create_test_topic(name).c_str(), &requested, &options);
+    };
+
+    // Queues are bounded by the buffer size of the service, 10 unless configured otherwise
+    auto shallow_qos = rmw_qos_profile_default;
+    shallow_qos.depth = 3;
+    shallow_qos.reliability = RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT;
+    auto* shallow = create(shallow_qos, "Shallow");
+    RMW_ASSERT_NE(shallow, nullptr);
+
+    rmw_qos_profile_t actual{};
+    EXPECT_RMW_OK(rmw_subscription_get_actual_qos(shallow, &actual));
+    EXPECT_EQ(actual.history, RMW_QOS_POLICY_HISTORY_KEEP_LAST);
+    EXPECT_EQ(actual.depth, 3U);
+    EXPECT_EQ(actual.reliability, RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT);
+
+    auto deep_qos = rmw_qos_profile_default;
+    deep_qos.depth = 1000;
+    auto* deep = create(deep_qos, "Deep");
+    RMW_ASSERT_NE(deep, nullptr);
+
+    EXPECT_RMW_OK(rmw_subscription_get_actual_qos(deep, &actual));
+    EXPECT_EQ(actual.depth, 10U);
+    // Samples are overwritten when subscribers fall behind unless safe overflow is disabled for the topic
+    EXPECT_EQ(actual.reliability, RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT);
+    // Samples are delivered to late-joining subscribers unless the history size is configured to zero
+    EXPECT_EQ(actual.durability, RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL);
+
+    EXPECT_RMW_OK(rmw_destroy_subscription(test_node(), shallow));
+    EXPECT_RMW_OK(rmw_destroy_subscription(test_node(), deep));
+}
+
 } // namespace
@@ -15,10 +15,21 @@
 #include "rmw/subscription_options.h"
 #include "rmw_iceoryx2_cxx/impl/runtime/guard_condition.hpp"
 #include "rmw_iceoryx2_cxx/impl/runtime/subscriber.hpp"
+#include "rmw_iceoryx2_cxx/impl/runtime/waitset.hpp"
+#include "rmw_iceoryx2_cxx/rmw/subscription_options.hpp"
 #include "rmw_iceoryx2_cxx_test_msgs/msg/defaults.hpp"
+#include "testing/allocation_counter.hpp"
 #include "testing/assertions.hpp"
 #include "testing/base.hpp"
 
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
 #include <thread>
 
 namespace
@@ -76,6 +87,11 @@ public:
         return m_waitset;
     }
 
+    /// @brief Enable deferring subscriptions in favor of those with higher priority
+    void enable_prioritization() {
+        static_cast<rmw::iox2::WaitSet*>(m_waitset->data)->set_prioritization(true);
+    }
+
     /// @brief Adds the specified number of guard conditions to the context
     bool add_guard_condition() {
         auto guard_condition = rmw_create_guard_condition(m_rmw_context);
@@ -108,9 +124,14 @@ public:
     }
 
     /// @brief Add a publisher-subscriber pair to the context
-    bool add_publisher_subscriber(const std::string& topic, const rosidl_message_type_support_t* typesupport) {
+    bool add_publisher_subscriber(const std::string& topic,
+                                  const rosidl_message_type_support_t* typesupport,
+                                  uint8_t priority = 0) {
         static const rmw_publisher_options_t publisher_options = rmw_get_default_publisher_options();
-        static const rmw_subscription_options_t subscription_options = rmw_get_default_subscription_options();
+        rmw_iox2_subscription_options_t iox2_subscription_options = rmw_iox2_get_default_subscription_options();
+        iox2_subscription_options.priority = priority;
+        rmw_subscription_options_t subscription_options = rmw_get_default_subscription_options();
+        subscription_options.rmw_specific_subscription_payload = &iox2_subscription_options;
         auto publisher =
             rmw_create_publisher(m_rmw_node, typesupport, topic.c_str(), &rmw_qos_profile_default, &publisher_options);
         if (!publisher) {
@@ -401,4 +422,593 @@ TEST_F(RmwWaitSetTest, can_get_triggers_from_all_entity_types_in_single_wait) {
     ASSERT_EQ(received_sub_indices.size(), NUM_PUBLISH_SUBSCRIBERS);
 }
 
+TEST_F(RmwWaitSetTest, reports_all_subscriptions_to_the_same_topic) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // ===== Setup
+    auto ctx = WaitSetTestContext{test_context(), test_node(), TIMEOUT_AFTER_20MS};
+    if (!ctx.initialize()) {
+        FAIL() << "failed to initialize context";
+    }
+
+    ASSERT_TRUE(ctx.add_publisher_subscriber(create_test_topic(), test_type_support<Defaults>()))
+        << "failed to create publisher/subscriber pair";
+    ASSERT_TRUE(ctx.add_publisher_subscriber(create_test_topic(), test_type_support<Defaults>()))
+        << "failed to create publisher/subscriber pair";
+
+    // ===== Test
+    // A single message is received by both subscriptions, which share a listener
+    auto message = Defaults{};
+    ASSERT_RMW_OK(rmw_publish(ctx.publishers().at(0), &message, nullptr));
+
+    auto subscriptions = ctx.subscriptions_array();
+    ASSERT_RMW_OK(rmw_wait(subscriptions, nullptr, nullptr, nullptr, nullptr, ctx.waitset(), ctx.timeout()));
+    EXPECT_NE(subscriptions->subscribers[0], nullptr);
+    EXPECT_NE(subscriptions->subscribers[1], nullptr);
+}
+
+TEST_F(RmwWaitSetTest, waitsets_sharing_a_topic_are_all_woken_up) {
+    using rmw::iox2::Context;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // ===== Setup
+    constexpr rmw_time_t TIMEOUT_AFTER_1S{1, 0};
+
+    auto first = WaitSetTestContext{test_context(), test_node(), TIMEOUT_AFTER_1S};
+    auto second = WaitSetTestContext{test_context(), test_node(), TIMEOUT_AFTER_1S};
+    if (!first.initialize() || !second.initialize()) {
+        FAIL() << "failed to initialize context";
+    }
+
+    ASSERT_TRUE(first.add_publisher_subscriber(create_test_topic(), test_type_support<Defaults>()))
+        << "failed to create publisher/subscriber pair";
+    ASSERT_TRUE(second.add_publisher_subscriber(create_test_topic(), test_type_support<Defaults>()))
+        << "failed to create publisher/subscriber pair";
+
+    // ===== Test
+    // Both waitsets block on the same shared listener, whichever consumes the notification must wake the other
+    auto first_subscriptions = first.subscriptions_array();
+    auto second_subscriptions = second.subscriptions_array();
+    rmw_ret_t second_result{RMW_RET_ERROR};
+    std::thread second_waiter([&]() {
+        second_result =
+            rmw_wait(second_subscriptions, nullptr, nullptr, nullptr, nullptr, second.waitset(), second.timeout());
+    });
+
+    auto delay = std::chrono::milliseconds(20);
+    first.trigger_subscriptions_after(delay);
+    auto first_result =
+        rmw_wait(first_subscriptions, nullptr, nullptr, nullptr, nullptr, first.waitset(), first.timeout());
+    second_waiter.join();
+
+    EXPECT_RMW_OK(first_result);
+    EXPECT_RMW_OK(second_result);
+    EXPECT_NE(first_subscriptions->subscribers[0], nullptr);
+    EXPECT_NE(second_subscriptions->subscribers[0], nullptr);
+
+    // Only a single listener is created for the topic
+    auto context = static_cast<Context*>(test_context()->impl);
+    EXPECT_EQ(context->listener_registry().listener_count(), 1U);
+}
+
+// Measures the context switches per message of waitsets blocked on the same topic. Run explicitly with
+// --gtest_also_run_disabled_tests --gtest_filter=*wakeups_of_waitsets_sharing_a_topic
+TEST_F(RmwWaitSetTest, DISABLED_benchmark_wakeups_of_waitsets_sharing_a_topic) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // ===== Setup
+    constexpr size_t NUM_WAITSETS{4};
+    constexpr size_t NUM_MESSAGES{500};
+    constexpr auto PUBLISH_PERIOD = std::chrono::milliseconds(1);
+    constexpr rmw_time_t TIMEOUT_AFTER_1S{1, 0};
+
+    const auto topic = create_test_topic();
+    std::vector<std::unique_ptr<WaitSetTestContext>> contexts;
+    for (size_t i = 0; i < NUM_WAITSETS; i++) {
+        contexts.push_back(std::make_unique<WaitSetTestContext>(test_context(), test_node(), TIMEOUT_AFTER_1S));
+        ASSERT_TRUE(contexts.back()->initialize()) << "failed to initialize context";
+        ASSERT_TRUE(contexts.back()->add_publisher_subscriber(topic, test_type_support<Defaults>()))
+            << "failed to create publisher/subscriber pair";
+    }
+    auto publisher = contexts.front()->publishers().at(0);
+
+    // Each waiter waits on its own waitset and takes every received message, like an executor per callback group
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> returns{0};
+    std::vector<std::thread> waiters;
+    for (auto& ctx : contexts) {
+        waiters.emplace_back([&stop, &returns, ctx = ctx.get()]() {
+            auto subscription = ctx->subscribers().at(0);
+            while (!stop) {
+                auto subscriptions = ctx->subscriptions_array();
+                if (rmw_wait(subscriptions, nullptr, nullptr, nullptr, nullptr, ctx->waitset(), ctx->timeout())
+                    == RMW_RET_OK) {
+                    returns++;
+                }
+                auto message = Defaults{};
+                bool taken{true};
+                while (taken) {
+                    EXPECT_RMW_OK(rmw_take(subscription, &message, &taken, nullptr));
+                }
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // ===== Test
+    rusage before{};
+    getrusage(RUSAGE_SELF, &before);
+    for (size_t i = 0; i < NUM_MESSAGES; i++) {
+        auto message = Defaults{};
+        ASSERT_RMW_OK(rmw_publish(publisher, &message, nullptr));
+        std::this_thread::sleep_for(PUBLISH_PERIOD);
+    }
+    rusage after{};
+    getrusage(RUSAGE_SELF, &after);
+
+    stop = true;
+    for (auto& waiter : waiters) {
+        waiter.join();
+    }
+
+    // The publishing thread contributes one context switch per message by sleeping
+    auto switches = static_cast<double>(after.ru_nvcsw - before.ru_nvcsw) / static_cast<double>(NUM_MESSAGES);
+    auto returns_per_message = static_cast<double>(returns.load()) / static_cast<double>(NUM_MESSAGES);
+    std::cout << "[ BENCHMARK] " << NUM_WAITSETS << " waitsets sharing a topic: " << switches
+              << " voluntary context switches per message, " << returns_per_message << " waits returned per message"
+              << std::endl;
+    RecordProperty("context_switches_per_message", std::to_string(switches));
+    RecordProperty("wait_returns_per_message", std::to_string(returns_per_message));
+}
+
+TEST_F(RmwWaitSetTest, reports_all_priorities_unless_prioritization_is_enabled) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // ===== Setup
+    constexpr uint8_t LOW_PRIORITY{0};
+    constexpr uint8_t HIGH_PRIORITY{1};
+
+    auto ctx = WaitSetTestContext{test_context(), test_node(), TIMEOUT_AFTER_20MS};
+    if (!ctx.initialize()) {
+        FAIL() << "failed to initialize context";
+    }
+
+    ASSERT_TRUE(ctx.add_publisher_subscriber(create_test_topic("/low"), test_type_support<Defaults>(), LOW_PRIORITY))
+        << "failed to create publisher/subscriber pair";
+    ASSERT_TRUE(
+        ctx.add_publisher_subscriber(create_test_topic("/high"), test_type_support<Defaults>(), HIGH_PRIORITY))
+        << "failed to create publisher/subscriber pair";
+
+    for (auto publisher : ctx.publishers()) {
+        auto message = Defaults{};
+        ASSERT_RMW_OK(rmw_publish(publisher, &message, nullptr));
+    }
+
+    // ===== Test
+    auto subscriptions = ctx.subscriptions_array();
+    ASSERT_RMW_OK(rmw_wait(subscriptions, nullptr, nullptr, nullptr, nullptr, ctx.waitset(), ctx.timeout()));
+    EXPECT_NE(subscriptions->subscribers[0], nullptr);
+    EXPECT_NE(subscriptions->subscribers[1], nullptr);
+}
+
+TEST_F(RmwWaitSetTest, reports_only_highest_priority_subscriptions) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // ===== Setup
+    constexpr uint8_t LOW_PRIORITY{0};
+    constexpr uint8_t HIGH_PRIORITY{1};
+
+    auto ctx = WaitSetTestContext{test_context(), test_node(), TIMEOUT_AFTER_20MS};
+    if (!ctx.initialize()) {
+        FAIL() << "failed to initialize context";
+    }
+    ctx.enable_prioritization();
+
+    ASSERT_TRUE(ctx.add_publisher_subscriber(create_test_topic("/low"), test_type_support<Defaults>(), LOW_PRIORITY))
+        << "failed to create publisher/subscriber pair";
+    ASSERT_TRUE(
+        ctx.add_publisher_subscriber(create_test_topic("/high"), test_type_support<Defaults>(), HIGH_PRIORITY))
+        << "failed to create publisher/subscriber pair";
+    ASSERT_TRUE(ctx.add_guard_condition()) << "failed to create guard condition";
+
+    for (auto publisher : ctx.publishers()) {
+        auto message = Defaults{};
+        ASSERT_RMW_OK(rmw_publish(publisher, &message, nullptr));
+    }
+    ASSERT_RMW_OK(rmw_trigger_guard_condition(ctx.guard_conditions().at(0)));
+
+    // ===== Test
+    // Only the high priority subscription is reported while it holds data, guard conditions are unaffected
+    auto subscriptions = ctx.subscriptions_array();
+    auto guard_conditions = ctx.guard_conditions_array();
+    ASSERT_RMW_OK(rmw_wait(subscriptions, guard_conditions, nullptr, nullptr, nullptr, ctx.waitset(), ctx.timeout()));
+    EXPECT_EQ(subscriptions->subscribers[0], nullptr);
+    EXPECT_NE(subscriptions->subscribers[1], nullptr);
+    EXPECT_NE(guard_conditions->guard_conditions[0], nullptr);
+
+    auto message = Defaults{};
+    bool taken{false};
+    ASSERT_RMW_OK(rmw_take(ctx.subscribers().at(1), &message, &taken, nullptr));
+    ASSERT_TRUE(taken);
+
+    // The deferred low priority subscription is reported once the high priority subscription is drained
+    subscriptions = ctx.subscriptions_array();
+    ASSERT_RMW_OK(rmw_wait(subscriptions, nullptr, nullptr, nullptr, nullptr, ctx.waitset(), ctx.timeout()));
+    EXPECT_NE(subscriptions->subscribers[0], nullptr);
+    EXPECT_EQ(subscriptions->subscribers[1], nullptr);
+}
+
+TEST_F(RmwWaitSetTest, low_priority_subscriptions_are_reported_under_sustained_high_priority_load) {
+    using rmw::iox2::WaitSet;
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // ===== Setup
+    constexpr uint8_t LOW_PRIORITY{0};
+    constexpr uint8_t HIGH_PRIORITY{1};
+
+    auto ctx = WaitSetTestContext{test_context(), test_node(), TIMEOUT_AFTER_20MS};
+    if (!ctx.initialize()) {
+        FAIL() << "failed to initialize context";
+    }
+    ctx.enable_prioritization();
+
+    ASSERT_TRUE(ctx.add_publisher_subscriber(create_test_topic("/low"), test_type_support<Defaults>(), LOW_PRIORITY))
+        << "failed to create publisher/subscriber pair";
+    ASSERT_TRUE(
+        ctx.add_publisher_subscriber(create_test_topic("/high"), test_type_support<Defaults>(), HIGH_PRIORITY))
+        << "failed to create publisher/subscriber pair";
+    auto low_publisher = ctx.publishers().at(0);
+    auto high_publisher = ctx.publishers().at(1);
+    auto high_subscription = ctx.subscribers().at(1);
+
+    auto message = Defaults{};
+    ASSERT_RMW_OK(rmw_publish(low_publisher, &message, nullptr));
+
+    // ===== Test
+    // The high priority subscription always holds a sample when waiting, the low priority one is deferred only for a
+    // bounded number of waits
+    size_t deferred{0};
+    bool low_reported{false};
+    while (!low_reported && deferred <= WaitSet::MAX_DEFERRALS) {
+        ASSERT_RMW_OK(rmw_publish(high_publisher, &message, nullptr));
+
+        auto subscriptions = ctx.subscriptions_array();
+        ASSERT_RMW_OK(rmw_wait(subscriptions, nullptr, nullptr, nullptr, nullptr, ctx.waitset(), ctx.timeout()));
+        EXPECT_NE(subscriptions->subscribers[1], nullptr);
+        low_reported = subscriptions->subscribers[0] != nullptr;
+        if (!low_reported) {
+            deferred++;
+        }
+
+        bool taken{false};
+        ASSERT_RMW_OK(rmw_take(high_subscription, &message, &taken, nullptr));
+        ASSERT_TRUE(taken);
+    }
+    EXPECT_TRUE(low_reported);
+    EXPECT_EQ(deferred, WaitSet::MAX_DEFERRALS);
+}
+
+TEST_F(RmwWaitSetTest, deferred_subscriptions_lose_no_messages) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // ===== Setup
+    constexpr uint8_t LOW_PRIORITY{0};
+    constexpr uint8_t HIGH_PRIORITY{1};
+    // Within the default buffer size of subscribers, thus no message is overwritten while deferred
+    constexpr size_t NUM_ROUNDS{8};
+
+    auto ctx = WaitSetTestContext{test_context(), test_node(), TIMEOUT_AFTER_20MS};
+    if (!ctx.initialize()) {
+        FAIL() << "failed to initialize context";
+    }
+    ctx.enable_prioritization();
+
+    ASSERT_TRUE(ctx.add_publisher_subscriber(create_test_topic("/low"), test_type_support<Defaults>(), LOW_PRIORITY))
+        << "failed to create publisher/subscriber pair";
+    ASSERT_TRUE(
+        ctx.add_publisher_subscriber(create_test_topic("/high"), test_type_support<Defaults>(), HIGH_PRIORITY))
+        << "failed to create publisher/subscriber pair";
+
+    // ===== Test
+    // Both topics receive a message every round, the low priority subscription is deferred in most rounds and takes
+    // one message per report, like an executor does. Every message is taken eventually.
+    std::array<size_t, 2> taken_count{0, 0};
+    auto take_one = [&](size_t index) {
+        auto message = Defaults{};
+        bool taken{false};
+        EXPECT_RMW_OK(rmw_take(ctx.subscribers().at(index), &message, &taken, nullptr));
+        taken_count[index] += taken ? 1 : 0;
+    };
+
+    for (size_t round = 0; round < NUM_ROUNDS; round++) {
+        for (auto publisher : ctx.publishers()) {
+            auto message = Defaults{};
+            ASSERT_RMW_OK(rmw_publish(publisher, &message, nullptr));
+        }
+        auto subscriptions = ctx.subscriptions_array();
+        ASSERT_RMW_OK(rmw_wait(subscriptions, nullptr, nullptr, nullptr, nullptr, ctx.waitset(), ctx.timeout()));
+        for (size_t i = 0; i < subscriptions->subscriber_count; i++) {
+            if (subscriptions->subscribers[i] != nullptr) {
+                take_one(i);
+            }
+        }
+    }
+
+    // Waiting reports the deferred messages once no higher priority holds data
+    while (taken_count[0] + taken_count[1] < 2 * NUM_ROUNDS) {
+        auto subscriptions = ctx.subscriptions_array();
+        ASSERT_RMW_OK(rmw_wait(subscriptions, nullptr, nullptr, nullptr, nullptr, ctx.waitset(), ctx.timeout()));
+        bool reported{false};
+        for (size_t i = 0; i < subscriptions->subscriber_count; i++) {
+            if (subscriptions->subscribers[i] != nullptr) {
+                take_one(i);
+                reported = true;
+            }
+        }
+        ASSERT_TRUE(reported) << "messages were lost while deferred";
+    }
+    EXPECT_EQ(taken_count[0], NUM_ROUNDS);
+    EXPECT_EQ(taken_count[1], NUM_ROUNDS);
+}
+
+TEST_F(RmwWaitSetTest, subscription_payloads_without_magic_are_ignored) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // ===== Setup
+    rmw_iox2_subscription_options_t iox2_subscription_options = rmw_iox2_get_default_subscription_options();
+    iox2_subscription_options.magic = 0;
+    iox2_subscription_options.priority = 1;
+    rmw_subscription_options_t subscription_options = rmw_get_default_subscription_options();
+    subscription_options.rmw_specific_subscription_payload = &iox2_subscription_options;
+
+    // ===== Test
+    auto subscription = rmw_create_subscription(test_node(),
+                                                test_type_support<Defaults>(),
+                                                create_test_topic().c_str(),
+                                                &rmw_qos_profile_default,
+                                                &subscription_options);
+    ASSERT_NE(subscription, nullptr);
+    EXPECT_EQ(static_cast<rmw::iox2::Subscriber*>(subscription->data)->priority(), 0U);
+    EXPECT_RMW_OK(rmw_destroy_subscription(test_node(), subscription));
+}
+
+// Measures the latency of a high priority subscription while lower priorities hold data. Run explicitly with
+// --gtest_also_run_disabled_tests --gtest_filter=*high_priority_latency_under_load
+TEST_F(RmwWaitSetTest, DISABLED_benchmark_high_priority_latency_under_load) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // ===== Setup
+    constexpr size_t ITERATIONS{200};
+    constexpr size_t NUM_BULK_TOPICS{8};
+    constexpr auto PROCESSING_TIME = std::chrono::microseconds(20);
+    constexpr rmw_time_t TIMEOUT_AFTER_1S{1, 0};
+
+    // Measures the latency from publishing to processing the control message while bulk messages are pending.
+    // Reported subscriptions are processed in array order, like rclcpp does, with the control topic placed last.
+    auto measure = [&](uint8_t control_priority, const std::string& suffix) -> std::vector<int64_t> {
+        std::vector<int64_t> latencies;
+
+        auto ctx = WaitSetTestContext{test_context(), test_node(), TIMEOUT_AFTER_1S};
+        if (!ctx.initialize()) {
+            ADD_FAILURE() << "failed to initialize context";
+            return latencies;
+        }
+        ctx.enable_prioritization();
+        for (size_t i = 0; i < NUM_BULK_TOPICS; i++) {
+            if (!ctx.add_publisher_subscriber(
+                    create_test_topic("/bulk" + std::to_string(i) + suffix), test_type_support<Defaults>())) {
+                ADD_FAILURE() << "failed to create publisher/subscriber pair";
+                return latencies;
+            }
+        }
+        if (!ctx.add_publisher_subscriber(
+                create_test_topic("/control" + suffix), test_type_support<Defaults>(), control_priority)) {
+            ADD_FAILURE() << "failed to create publisher/subscriber pair";
+            return latencies;
+        }
+        auto publishers = ctx.publishers();
+        auto subscribers = ctx.subscribers();
+        const size_t control_index = NUM_BULK_TOPICS;
+
+        auto process = [&](size_t index) {
+            auto message = Defaults{};
+            bool taken{false};
+            EXPECT_RMW_OK(rmw_take(subscribers.at(index), &message, &taken, nullptr));
+            auto busy_until = std::chrono::steady_clock::now() + PROCESSING_TIME;
+            while (std::chrono::steady_clock::now() < busy_until) {
+            }
+            return taken;
+        };
+
+        for (size_t iteration = 0; iteration < ITERATIONS; iteration++) {
+            auto message = Defaults{};
+            for (auto publisher : publishers) {
+                EXPECT_RMW_OK(rmw_publish(publisher, &message, nullptr));
+            }
+            auto published_at = std::chrono::steady_clock::now();
+
+            // Process until the control message is handled
+            bool control_processed{false};
+            while (!control_processed) {
+                auto subscriptions = ctx.subscriptions_array();
+                if (rmw_wait(subscriptions, nullptr, nullptr, nullptr, nullptr, ctx.waitset(), ctx.timeout())
+                    != RMW_RET_OK) {
+                    ADD_FAILURE() << "control message not received";
+                    return latencies;
+                }
+                for (size_t i = 0; i < subscriptions->subscriber_count && !control_processed; i++) {
+                    if (subscriptions->subscribers[i] != nullptr && process(i) && i == control_index) {
+                        latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                std::chrono::steady_clock::now() - published_at)
+                                                .count());
+                        control_processed = true;
+                    }
+                }
+            }
+
+            // Drain the remaining bulk messages before the next iteration
+            for (size_t i = 0; i < NUM_BULK_TOPICS; i++) {
+                while (process(i)) {
+                }
+            }
+        }
+        return latencies;
+    };
+
+    auto p99 = [](std::vector<int64_t> latencies) -> int64_t {
+        if (latencies.empty()) {
+            return 0;
+        }
+        std::sort(latencies.begin(), latencies.end());
+        return latencies.at(std::min(latencies.size() - 1, (latencies.size() * 99) / 100));
+    };
+
+    // ===== Test
+    auto without_priority = p99(measure(0, "/equal"));
+    auto with_priority = p99(measure(1, "/prioritized"));
+
+    std::cout << "[ BENCHMARK] control topic p99 latency with " << NUM_BULK_TOPICS
+              << " bulk topics: " << without_priority << " ns (equal priority), " << with_priority
+              << " ns (high priority)" << std::endl;
+    RecordProperty("control_p99_ns_equal_priority", std::to_string(without_priority));
+    RecordProperty("control_p99_ns_high_priority", std::to_string(with_priority));
+}
+
+TEST_F(RmwWaitSetTest, returns_immediately_while_subscription_holds_unread_samples) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // ===== Setup
+    constexpr size_t NUM_SAMPLES{3};
+
+    auto ctx = WaitSetTestContext{test_context(), test_node(), TIMEOUT_AFTER_20MS};
+    if (!ctx.initialize()) {
+        FAIL() << "failed to initialize context";
+    }
+
+    ASSERT_TRUE(ctx.add_publisher_subscriber(create_test_topic(), test_type_support<Defaults>()))
+        << "failed to create publisher/subscriber pair";
+    auto publisher = ctx.publishers().at(0);
+    auto subscription = ctx.subscribers().at(0);
+
+    for (size_t i = 0; i < NUM_SAMPLES; i++) {
+        auto message = Defaults{};
+        ASSERT_RMW_OK(rmw_publish(publisher, &message, nullptr));
+    }
+
+    // ===== Test
+    // Each wait reports the subscription while samples remain, regardless of the state of the notifications
+    for (size_t i = 0; i < NUM_SAMPLES; i++) {
+        auto subscriptions = ctx.subscriptions_array();
+        ASSERT_RMW_OK(rmw_wait(subscriptions, nullptr, nullptr, nullptr, nullptr, ctx.waitset(), ctx.timeout()));
+        ASSERT_NE(subscriptions->subscribers[0], nullptr) << "subscription not reported with " << (NUM_SAMPLES - i)
+                                                          << " samples remaining";
+
+        auto message = Defaults{};
+        bool taken{false};
+        ASSERT_RMW_OK(rmw_take(subscription, &message, &taken, nullptr));
+        ASSERT_TRUE(taken);
+    }
+
+    // Once all samples are taken, at most one wakeup from leftover notifications remains before timing out
+    rmw_ret_t wait_result{RMW_RET_OK};
+    for (size_t i = 0; i < 2 && wait_result == RMW_RET_OK; i++) {
+        auto subscriptions = ctx.subscriptions_array();
+        wait_result = rmw_wait(subscriptions, nullptr, nullptr, nullptr, nullptr, ctx.waitset(), ctx.timeout());
+    }
+    EXPECT_EQ(wait_result, RMW_RET_TIMEOUT);
+}
+
+// Measures the overhead of waiting with a short timeout. Run explicitly with
+// --gtest_also_run_disabled_tests --gtest_filter=*short_timeout_overhead
+TEST_F(RmwWaitSetTest, DISABLED_benchmark_short_timeout_overhead) {
+    // ===== Setup
+    constexpr size_t ITERATIONS{1000};
+    constexpr rmw_time_t TIMEOUT_AFTER_100US{0, 100000};
+
+    auto ctx = WaitSetTestContext{test_context(), test_node(), TIMEOUT_AFTER_100US};
+    if (!ctx.initialize()) {
+        FAIL() << "failed to initialize context";
+    }
+    ASSERT_TRUE(ctx.add_guard_condition()) << "failed to create guard condition";
+
+    auto guard_conditions = ctx.guard_conditions_array();
+    auto guard_condition = guard_conditions->guard_conditions[0];
+
+    // ===== Test
+    // Mimics an executor waiting on a timer-driven timeout in a tight loop
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        guard_conditions->guard_conditions[0] = guard_condition;
+        ASSERT_EQ(rmw_wait(nullptr, guard_conditions, nullptr, nullptr, nullptr, ctx.waitset(), ctx.timeout()),
+                  RMW_RET_TIMEOUT);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    auto per_wait = static_cast<double>(elapsed) / static_cast<double>(ITERATIONS);
+    auto overhead = per_wait - static_cast<double>(TIMEOUT_AFTER_100US.nsec);
+    std::cout << "[ BENCHMARK] rmw_wait with 100us timeout: " << per_wait << " ns per wait (" << overhead
+              << " ns overhead)" << std::endl;
+    RecordProperty("wait_100us_ns_per_wait", std::to_string(per_wait));
+    RecordProperty("wait_100us_ns_overhead", std::to_string(overhead));
+}
+
+TEST_F(RmwWaitSetTest, waiting_on_unchanged_entities_does_not_allocate) {
+    using rmw_iceoryx2_cxx_test_msgs::msg::Defaults;
+
+    // ===== Setup
+    constexpr size_t NUM_GUARD_CONDITIONS{3};
+    constexpr size_t NUM_PUBLISH_SUBSCRIBERS{2};
+    constexpr size_t NUM_WAITS{100};
+
+    auto ctx = WaitSetTestContext{test_context(), test_node(), TIMEOUT_AFTER_20MS};
+    if (!ctx.initialize()) {
+        FAIL() << "failed to initialize context";
+    }
+
+    for (size_t i = 0; i < NUM_GUARD_CONDITIONS; i++) {
+        ASSERT_TRUE(ctx.add_guard_condition()) << "failed to create guard condition";
+    }
+    for (size_t i = 0; i < NUM_PUBLISH_SUBSCRIBERS; i++) {
+        ASSERT_TRUE(ctx.add_publisher_subscriber("/TestTopic" + std::to_string(i), test_type_support<Defaults>()))
+            << "failed to create publisher/subscriber pair";
+    }
+
+    auto subscriptions = ctx.subscriptions_array();
+    auto guard_conditions = ctx.guard_conditions_array();
+
+    // rmw_wait() sets non-triggered entries to nullptr, keep the originals to restore them before each wait
+    std::vector<void*> subscribers(subscriptions->subscribers,
+                                   subscriptions->subscribers + subscriptions->subscriber_count);
+    std::vector<void*> conditions(guard_conditions->guard_conditions,
+                                  guard_conditions->guard_conditions + guard_conditions->guard_condition_count);
+
+    auto wait_on_all = [&]() {
+        std::copy(subscribers.begin(), subscribers.end(), subscriptions->subscribers);
+        std::copy(conditions.begin(), conditions.end(), guard_conditions->guard_conditions);
+        return rmw_wait(subscriptions, guard_conditions, nullptr, nullptr, nullptr, ctx.waitset(), ctx.timeout());
+    };
+
+    // The first wait creates the listeners, attachments and result storage
+    ASSERT_RMW_OK(rmw_trigger_guard_condition(ctx.guard_conditions().at(0)));
+    ASSERT_RMW_OK(wait_on_all());
+
+    // ===== Test
+    for (size_t i = 0; i < NUM_WAITS; i++) {
+        ASSERT_RMW_OK(rmw_trigger_guard_condition(ctx.guard_conditions().at(i % NUM_GUARD_CONDITIONS)));
+
+        rmw_ret_t wait_result{RMW_RET_ERROR};
+        size_t allocations{0};
+        {
+            rmw::iox2::testing::AllocationCounter counter;
+            wait_result = wait_on_all();
+            allocations = counter.count();
+        }
+
+        ASSERT_RMW_OK(wait_result);
+        ASSERT_EQ(allocations, 0U) << "rmw_wait() allocated in wait " << i;
+        ASSERT_NE(guard_conditions->guard_conditions[i % NUM_GUARD_CONDITIONS], nullptr);
+    }
+}
+
 } // namespace
@@ -0,0 +1,75 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+
+#include "allocation_counter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+thread_local bool counting_enabled{false};
+thread_local size_t allocation_count{0};
+
+void* counted_allocation(std::size_t size) {
+    if (counting_enabled) {
+        allocation_count++;
+    }
+    if (size == 0) {
+        size = 1;
+    }
+    if (auto ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+} // namespace
+
+void* operator new(std::size_t size) {
+    return counted_allocation(size);
+}
+
+void* operator new[](std::size_t size) {
+    return counted_allocation(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace rmw::iox2::testing
+{
+
+AllocationCounter::AllocationCounter() {
+    allocation_count = 0;
+    counting_enabled = true;
+}
+
+AllocationCounter::~AllocationCounter() {
+    counting_enabled = false;
+}
+
+auto AllocationCounter::count() const -> size_t {
+    return allocation_count;
+}
+
+} // namespace rmw::iox2::testing
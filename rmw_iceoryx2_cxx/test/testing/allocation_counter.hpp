@@ -0,0 +1,39 @@
+// Copyright (c) 2024 by Ekxide IO GmbH All rights reserved.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Apache Software License 2.0 which is available at
+// https://www.apache.org/licenses/LICENSE-2.0, or the MIT license
+// which is available at https://opensource.org/licenses/MIT.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+
+#ifndef RMW_IOX2_TESTING_ALLOCATION_COUNTER_HPP_
+#define RMW_IOX2_TESTING_ALLOCATION_COUNTER_HPP_
+
+#include <cstddef>
+
+namespace rmw::iox2::testing
+{
+
+/// @brief Counts the allocations made via the global operator new on the calling thread while in scope.
+/// @details The test executable replaces the global operator new to make this possible. Allocations made by other
+///          threads or directly via malloc (e.g. in C or Rust code) are not counted.
+class AllocationCounter
+{
+public:
+    AllocationCounter();
+    ~AllocationCounter();
+
+    AllocationCounter(const AllocationCounter&) = delete;
+    AllocationCounter(AllocationCounter&&) = delete;
+    AllocationCounter& operator=(const AllocationCounter&) = delete;
+    AllocationCounter& operator=(AllocationCounter&&) = delete;
+
+    /// @brief The number of allocations made on the calling thread since construction
+    auto count() const -> size_t;
+};
+
+} // namespace rmw::iox2::testing
+
+#endif